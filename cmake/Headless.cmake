@@ -0,0 +1,119 @@
+# Headless.cmake
+# Builds the game-independent core as a static library plus benchmark and test executables.
+#
+# Game, SKSE and PrismaUI headers are replaced by the minimal stand-ins in headless/stubs,
+# so this configuration needs neither CommonLibSSE nor Windows. Used on the Linux perf
+# boxes and in CI:
+#   cmake -S . -B build/headless -DSKYRIMNET_HEADLESS=ON -DCMAKE_BUILD_TYPE=Release
+#   cmake --build build/headless && ctest --test-dir build/headless --output-on-failure
+#   build/headless/bin/SkyrimNetCoreBenchmarks
+
+find_package(spdlog CONFIG REQUIRED)
+find_package(benchmark CONFIG REQUIRED)
+find_package(GTest CONFIG REQUIRED)
+include(GoogleTest)
+enable_testing()
+
+# Everything except the plugin entry point, the PrismaUI view management in UIBridge and the
+# loopback server in ProxyServer, which only serves the view
+add_library(SkyrimNetCore STATIC
+    src/ui/InteropDispatcher.cpp
+    src/ui/ViewManager.cpp
+    src/ui/InteropChannel.cpp
+    src/skyrimnet/GameMasterController.cpp
+    src/skyrimnet/CommandJournal.cpp
+    src/skyrimnet/HealthMonitor.cpp
+    src/skyrimnet/EventFeed.cpp
+    src/skyrimnet/GameConfig.cpp
+    src/skyrimnet/ServerSettings.cpp
+    src/lifecycle/Lifecycle.cpp
+    src/keyhandler/keyhandler.cpp
+    src/keyhandler/KeyBinding.cpp
+    src/config/IniFile.cpp
+    src/logging/Log.cpp
+    src/metrics/Metrics.cpp
+    src/http/HttpClient.cpp
+    src/http/Transport.cpp
+    src/http/SingleFlight.cpp
+    src/http/AssetProxy.cpp
+    src/http/EventStream.cpp
+    src/http/ConditionalCache.cpp
+    src/http/CircuitBreaker.cpp
+    src/json/JsonScanner.cpp
+    src/msgpack/MsgPack.cpp
+    src/scheduler/TaskScheduler.cpp
+)
+
+target_include_directories(SkyrimNetCore
+    PUBLIC
+    "${CMAKE_SOURCE_DIR}/headless/stubs"
+    "${CMAKE_SOURCE_DIR}/include"
+    PRIVATE
+    "${CMAKE_SOURCE_DIR}/src"
+)
+
+target_link_libraries(SkyrimNetCore
+    PUBLIC
+    httplib::httplib
+    spdlog::spdlog
+    Threads::Threads
+)
+
+# Same forced include as the plugin: sources rely on pch.h for the logger namespace
+target_precompile_headers(SkyrimNetCore
+    PRIVATE
+    "include/pch.h"
+)
+
+# The in-memory server the benchmarks and tests run against; not part of the plugin
+add_library(SkyrimNetTestSupport STATIC
+    src/http/FakeTransport.cpp
+)
+
+target_link_libraries(SkyrimNetTestSupport
+    PUBLIC
+    SkyrimNetCore
+)
+
+target_precompile_headers(SkyrimNetTestSupport
+    PRIVATE
+    "include/pch.h"
+)
+
+add_executable(SkyrimNetCoreBenchmarks
+    headless/benchmarks/CoreBenchmarks.cpp
+)
+
+target_link_libraries(SkyrimNetCoreBenchmarks
+    PRIVATE
+    SkyrimNetCore
+    SkyrimNetTestSupport
+    benchmark::benchmark
+)
+
+add_executable(SkyrimNetCoreTests
+    headless/tests/AssetProxyTests.cpp
+    headless/tests/CommandJournalTests.cpp
+    headless/tests/ControllerTests.cpp
+    headless/tests/EventFeedTests.cpp
+    headless/tests/HttpClientTests.cpp
+    headless/tests/InteropDispatcherTests.cpp
+    headless/tests/KeyBindingTests.cpp
+    headless/tests/LifecycleTests.cpp
+    headless/tests/SchedulerTests.cpp
+)
+
+target_link_libraries(SkyrimNetCoreTests
+    PRIVATE
+    SkyrimNetCore
+    SkyrimNetTestSupport
+    GTest::gtest_main
+)
+
+# Tests start scheduler workers and wait on them; run them one process per test
+gtest_discover_tests(SkyrimNetCoreTests DISCOVERY_MODE PRE_TEST)
+
+set_target_properties(SkyrimNetCore SkyrimNetTestSupport SkyrimNetCoreBenchmarks SkyrimNetCoreTests PROPERTIES
+    RUNTIME_OUTPUT_DIRECTORY "${CMAKE_BINARY_DIR}/bin"
+    ARCHIVE_OUTPUT_DIRECTORY "${CMAKE_BINARY_DIR}/lib"
+)
@@ -0,0 +1,1163 @@
+// Benchmarks for the game-independent core, run against FakeTransport instead of a SkyrimNet server.
+// Built by the SKYRIMNET_HEADLESS configuration; see cmake/Headless.cmake.
+
+#include <benchmark/benchmark.h>
+#include <httplib.h>
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/spdlog.h>
+
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "http/AssetProxy.h"
+#include "http/EventStream.h"
+#include "http/FakeTransport.h"
+#include "http/HttpClient.h"
+#include "http/SingleFlight.h"
+#include "json/JsonScanner.h"
+#include "keyhandler/KeyBinding.h"
+#include "keyhandler/keyhandler.h"
+#include "lifecycle/Lifecycle.h"
+#include "logging/Log.h"
+#include "metrics/Metrics.h"
+#include "msgpack/MsgPack.h"
+#include "pch.h"
+#include "scheduler/TaskScheduler.h"
+#include "skyrimnet/EventFeed.h"
+#include "skyrimnet/GameMasterController.h"
+#include "skyrimnet/HealthMonitor.h"
+#include "ui/InteropChannel.h"
+#include "ui/ViewManager.h"
+
+using namespace SkyrimNetUI;
+
+// Heap allocations made by this process, for benchmarks that report allocations per iteration
+static std::atomic<uint64_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* block = std::malloc(size != 0 ? size : 1)) {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* block) noexcept { std::free(block); }
+void operator delete(void* block, std::size_t) noexcept { std::free(block); }
+
+namespace {
+    constexpr std::string_view kBaseUrl = "http://fake.invalid";
+
+    std::string Url(std::string_view path) { return std::string(kBaseUrl).append(path); }
+
+    SkyrimNet::ServerSettings FakeServer() {
+        return {.baseUrl = std::string(kBaseUrl), .patchPath = "/config?api=patch&name=game"};
+    }
+
+    Http::Response JsonResponse(std::string body) {
+        Http::Response response{200, std::move(body), {}};
+        response.headers.emplace("Content-Type", "application/json");
+        return response;
+    }
+
+    /// Routes for the status and config endpoints; the status flips on every request, the config
+    /// holds whatever was last committed. Every patchFailEvery-th partial update fails (0 = never).
+    void RouteServer(Http::FakeTransport& transport, std::chrono::milliseconds latency, size_t configBytes,
+                     uint32_t patchFailEvery = 0) {
+        auto requests = std::make_shared<std::atomic<uint64_t>>(0);
+        auto enabled = std::make_shared<std::atomic<bool>>(false);
+        transport.SetRoute("GET", Url("/?api=gamemaster-status"),
+                           {.latency = latency, .handler = [requests](const Http::FakeRequest&) {
+                                const bool enabled = requests->fetch_add(1) % 2 == 0;
+                                return JsonResponse(enabled ? R"({"status":{"agent_enabled":true}})"
+                                                            : R"({"status":{"agent_enabled":false}})");
+                            }});
+        transport.SetRoute("GET", Url("/config?api=get&name=game"),
+                           {.latency = latency, .padTo = configBytes, .handler = [enabled](const Http::FakeRequest&) {
+                                const char* value = *enabled ? "true" : "false";
+                                return JsonResponse(std::string(R"({"gamemaster":{"enabled":)") + value +
+                                                    R"(,"agentEnabled":)" + value + "}}");
+                            }});
+        const auto commit = [enabled](const Http::FakeRequest& request) {
+            enabled->store(request.body.find(R"("enabled":true)") != std::string::npos);
+            return JsonResponse("{}");
+        };
+        transport.SetRoute("POST", Url("/config?api=patch&name=game"),
+                           {.latency = latency, .failEvery = patchFailEvery, .handler = commit});
+        transport.SetRoute("POST", Url("/config?api=update"), {.latency = latency, .handler = commit});
+    }
+
+    /**
+     * GameMaster status that changes while it is being watched. Every GET answers with the
+     * current status; the status stream pushes each change as it happens, as SkyrimNet does.
+     */
+    class LiveStatusServer final : public Http::Transport {
+    public:
+        /// Change the status; @return its version, which counts changes
+        uint64_t Flip() {
+            std::lock_guard lock(mutex_);
+            enabled_ = !enabled_;
+            changed_.notify_all();
+            return ++version_;
+        }
+
+        /// @return version of the current status if status shows it, else 0
+        uint64_t Shows(SkyrimNet::GameMasterStatus status) const {
+            std::lock_guard lock(mutex_);
+            const auto current =
+                enabled_ ? SkyrimNet::GameMasterStatus::Enabled : SkyrimNet::GameMasterStatus::Disabled;
+            return status == current ? version_ : 0;
+        }
+
+        uint64_t Requests() const noexcept { return requests_.load(); }
+
+        Http::Response Get(const std::string&, const Http::RequestOptions&) override {
+            requests_.fetch_add(1);
+            std::lock_guard lock(mutex_);
+            return JsonResponse(Body());
+        }
+
+        Http::Response Head(const std::string&, const Http::RequestOptions&) override { return {200, {}, {}}; }
+
+        Http::Response Post(const std::string&, const std::string&, const Http::RequestOptions&) override {
+            return {404, {}, {}};
+        }
+
+        Http::Response Send(const std::string&, const std::string&, const std::string&, std::string_view,
+                            const Http::RequestOptions&) override {
+            return {404, {}, {}};
+        }
+
+        Http::StreamResult Stream(const std::string&, std::string_view, const Http::ChunkHandler& onChunk,
+                                  const Http::RequestOptions& options) override {
+            requests_.fetch_add(1);
+            std::unique_lock lock(mutex_);
+            uint64_t sent = version_;
+            while (!(options.cancel && options.cancel->IsCancelled())) {
+                // Woken periodically to notice cancellation, as a socket shutdown would
+                if (!changed_.wait_for(lock, std::chrono::milliseconds(5), [&]() { return version_ != sent; })) {
+                    continue;
+                }
+                sent = version_;
+                const std::string event = "event: status\ndata: " + Body() + "\n\n";
+                lock.unlock();
+                const bool open = onChunk(event);
+                lock.lock();
+                if (!open) {
+                    break;
+                }
+            }
+            return {200, true};
+        }
+
+    private:
+        std::string Body() const {
+            return enabled_ ? R"({"status":{"agent_enabled":true}})" : R"({"status":{"agent_enabled":false}})";
+        }
+
+        mutable std::mutex mutex_;
+        std::condition_variable changed_;
+        bool enabled_ = false;
+        uint64_t version_ = 0;
+        std::atomic<uint64_t> requests_{0};
+    };
+
+    /// PrismaUI stand-in whose CreateView blocks for createCost and reports DOM ready loadTime later
+    class FakePrismaUI final : public PRISMA_UI_API::IVPrismaUI1 {
+    public:
+        FakePrismaUI(std::chrono::microseconds createCost, std::chrono::microseconds loadTime)
+            : createCost_(createCost), loadTime_(loadTime) {}
+
+        ~FakePrismaUI() {
+            for (auto& loader : loaders_) {
+                loader.join();
+            }
+        }
+
+        PrismaView CreateView(const char*, PRISMA_UI_API::OnDomReadyCallback onDomReady) noexcept override {
+            std::this_thread::sleep_for(createCost_);
+            std::lock_guard lock(mutex_);
+            const PrismaView view = ++lastView_;
+            valid_.insert(view);
+            created_++;
+            loaders_.emplace_back([this, view, onDomReady]() {
+                std::this_thread::sleep_for(loadTime_);
+                if (onDomReady) {
+                    onDomReady(view);
+                }
+            });
+            return view;
+        }
+
+        void Destroy(PrismaView view) noexcept override {
+            std::lock_guard lock(mutex_);
+            valid_.erase(view);
+        }
+
+        bool IsValid(PrismaView view) noexcept override {
+            std::lock_guard lock(mutex_);
+            return valid_.contains(view);
+        }
+
+        bool HasFocus(PrismaView view) noexcept override { return focused_ == view; }
+        bool Focus(PrismaView view, bool, bool) noexcept override {
+            focused_ = view;
+            return true;
+        }
+        void Unfocus(PrismaView view) noexcept override { focused_.compare_exchange_strong(view, 0); }
+        bool HasAnyActiveFocus() noexcept override { return focused_ != 0; }
+
+        void Invoke(PrismaView, const char*, PRISMA_UI_API::JSCallback) noexcept override {}
+        void InteropCall(PrismaView, const char*, const char*) noexcept override {}
+        void RegisterJSListener(PrismaView, const char*, PRISMA_UI_API::JSListenerCallback) noexcept override {}
+        void Show(PrismaView) noexcept override {}
+        void Hide(PrismaView) noexcept override {}
+        bool IsHidden(PrismaView) noexcept override { return false; }
+        int GetScrollingPixelSize(PrismaView) noexcept override { return 0; }
+        void SetScrollingPixelSize(PrismaView, int) noexcept override {}
+        void SetOrder(PrismaView, int) noexcept override {}
+        int GetOrder(PrismaView) noexcept override { return 0; }
+        void CreateInspectorView(PrismaView) noexcept override {}
+        void SetInspectorVisibility(PrismaView, bool) noexcept override {}
+        bool IsInspectorVisible(PrismaView) noexcept override { return false; }
+        void SetInspectorBounds(PrismaView, float, float, unsigned int, unsigned int) noexcept override {}
+
+        uint64_t Created() const {
+            std::lock_guard lock(mutex_);
+            return created_;
+        }
+
+    private:
+        const std::chrono::microseconds createCost_;
+        const std::chrono::microseconds loadTime_;
+        mutable std::mutex mutex_;
+        std::set<PrismaView> valid_;
+        std::vector<std::thread> loaders_;
+        PrismaView lastView_ = 0;
+        uint64_t created_ = 0;
+        std::atomic<PrismaView> focused_{0};
+    };
+
+    std::atomic<uint64_t> g_domReadyCount{0};
+
+    void CountDomReady(PrismaView) {
+        g_domReadyCount.fetch_add(1);
+        g_domReadyCount.notify_all();
+    }
+}
+
+// Status-sized GETs against a loopback server, the only benchmark that opens real sockets
+// Arg: 0 = a new connection per request, 1 = keep-alive clients from the pool
+static void BM_HttpGetPooled(benchmark::State& state) {
+    httplib::Server server;
+    server.Get("/status", [](const httplib::Request&, httplib::Response& res) {
+        res.set_content(R"({"status":{"agent_enabled":true}})", "application/json");
+    });
+    const int port = server.bind_to_any_port("127.0.0.1");
+    std::thread listener([&server]() { server.listen_after_bind(); });
+    server.wait_until_ready();
+
+    Http::SetPoolingEnabled(state.range(0) != 0);
+    Http::ClosePool();
+    const auto before = Http::GetPoolStats();
+    const std::string url = "http://127.0.0.1:" + std::to_string(port) + "/status";
+    for (auto _ : state) {
+        const auto response = Http::Get(url);
+        if (!response.ok()) {
+            state.SkipWithError("loopback request failed");
+            break;
+        }
+    }
+    const auto after = Http::GetPoolStats();
+    state.counters["reused"] =
+        benchmark::Counter(static_cast<double>(after.reused - before.reused), benchmark::Counter::kAvgIterations);
+    state.counters["reconnected"] = benchmark::Counter(static_cast<double>(after.reconnected - before.reconnected),
+                                                       benchmark::Counter::kAvgIterations);
+
+    Http::ClosePool();
+    Http::SetPoolingEnabled(true);
+    server.stop();
+    listener.join();
+}
+BENCHMARK(BM_HttpGetPooled)->Arg(0)->Arg(1)->UseRealTime();
+
+// Full toggle round trip: config revalidation, dirty-field commit and status confirmation
+// Args: server latency (ms), config document size (bytes)
+static void BM_ControllerToggle(benchmark::State& state) {
+    Http::FakeTransport transport;
+    RouteServer(transport, std::chrono::milliseconds(state.range(0)), static_cast<size_t>(state.range(1)));
+    SkyrimNet::Controller controller(transport, FakeServer());
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(controller.Toggle());
+    }
+
+    state.counters["bytes_sent"] = static_cast<double>(controller.GetConfig().GetStats().lastCommitBytes);
+}
+BENCHMARK(BM_ControllerToggle)->Args({0, 512})->Args({0, 64 << 10})->Args({2, 512})->UseRealTime();
+
+// Toggle against a server that drops every other request
+static void BM_ControllerToggleFlaky(benchmark::State& state) {
+    Http::FakeTransport transport;
+    RouteServer(transport, std::chrono::milliseconds::zero(), 512, 2);
+    SkyrimNet::Controller controller(transport, FakeServer());
+
+    int64_t failures = 0;
+    for (auto _ : state) {
+        failures += controller.Toggle() ? 0 : 1;
+    }
+    state.counters["failures"] =
+        benchmark::Counter(static_cast<double>(failures), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_ControllerToggleFlaky)->UseRealTime();
+
+// Toggle while the server is down: each toggle is saved to the journal, flushed to disk,
+// and cancels out the one before it
+static void BM_ControllerToggleOffline(benchmark::State& state) {
+    Http::FakeTransport transport;
+    RouteServer(transport, std::chrono::milliseconds::zero(), 512);
+    transport.SetRoute("GET", Url("/config?api=get&name=game"), {.response = {0, {}, {}}});
+    const auto journal = std::filesystem::temp_directory_path() / "SkyrimNetCoreBenchmarks-commands.journal";
+    std::filesystem::remove(journal);
+    SkyrimNet::Controller controller(transport, FakeServer());
+    controller.OpenJournal(journal);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(controller.Toggle());
+    }
+    controller.Shutdown();
+    const auto stats = controller.GetJournal()->GetStats();
+    state.counters["collapsed"] =
+        benchmark::Counter(static_cast<double>(stats.collapsed), benchmark::Counter::kAvgIterations);
+    std::filesystem::remove(journal);
+}
+BENCHMARK(BM_ControllerToggleOffline)->UseRealTime();
+
+// StartPolling until the first status change reaches the listener, then StopPolling
+// Arg: server latency (ms)
+static void BM_ControllerPollCycle(benchmark::State& state) {
+    Http::FakeTransport transport;
+    RouteServer(transport, std::chrono::milliseconds(state.range(0)), 512);
+    SkyrimNet::Controller controller(transport, FakeServer());
+    controller.SetPushEnabled(false);
+
+    std::atomic<uint64_t> notifications{0};
+    controller.SetStatusListener([&notifications](SkyrimNet::GameMasterStatus) {
+        notifications.fetch_add(1);
+        notifications.notify_all();
+    });
+
+    for (auto _ : state) {
+        const uint64_t seen = notifications.load();
+        controller.StartPolling();
+        notifications.wait(seen);
+        controller.StopPolling();
+    }
+    controller.Shutdown();
+
+    state.counters["requests"] = benchmark::Counter(static_cast<double>(controller.GetStatusStats().requests),
+                                                    benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_ControllerPollCycle)->Arg(0)->Arg(5)->UseRealTime();
+
+// Change-to-UI latency, pushed vs polled: each iteration changes the server's status and ends
+// when the listener shows it. Changes come at uneven times (untimed) between polls, which are
+// kPollInterval apart; requests_per_min is over the whole run, quiet time included, and scales
+// inversely with the poll interval (IntervalMs, 5 s by default).
+// Arg: 0 = interval polling, 1 = status push
+static void BM_StatusPushVsPoll(benchmark::State& state) {
+    constexpr auto kPollInterval = std::chrono::milliseconds(200);
+    LiveStatusServer server;
+    auto settings = FakeServer();
+    settings.pollInterval = kPollInterval;
+    SkyrimNet::Controller controller(server, settings);
+    controller.SetPushEnabled(state.range(0) != 0);
+
+    std::atomic<uint64_t> shown{0};
+    controller.SetStatusListener([&server, &shown](SkyrimNet::GameMasterStatus status) {
+        if (const auto version = server.Shows(status); version > shown.load()) {
+            shown.store(version);
+        }
+    });
+    controller.StartPolling();
+    // Wait for the first status so the initial read isn't timed
+    std::this_thread::sleep_for(kPollInterval / 4);
+
+    const auto start = std::chrono::steady_clock::now();
+    int64_t step = 0;
+    for (auto _ : state) {
+        const uint64_t version = server.Flip();
+        const auto deadline = std::chrono::steady_clock::now() + 10 * kPollInterval;
+        while (shown.load() < version) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                state.SkipWithError("status change never reached the listener");
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        state.PauseTiming();
+        std::this_thread::sleep_for(kPollInterval * (++step * 37 % 100) / 100);
+        state.ResumeTiming();
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+    controller.Shutdown();
+
+    state.counters["requests_per_min"] = static_cast<double>(server.Requests()) * 60.0 / elapsed.count();
+}
+BENCHMARK(BM_StatusPushVsPoll)->Arg(0)->Arg(1)->Iterations(25)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Open the view until the first status arrives, then close it, with polling and health checks
+// managed by the lifecycle manager (LifecycleTests checks that nothing runs while suspended)
+static void BM_LifecycleSuspendResume(benchmark::State& state) {
+    Http::FakeTransport transport;
+    RouteServer(transport, std::chrono::milliseconds::zero(), 512);
+    transport.SetRoute("HEAD", Url("/config"), {.response = {200, {}, {}}});
+
+    auto settings = FakeServer();
+    settings.pollInterval = std::chrono::milliseconds(1);
+    settings.monitorUpInterval = std::chrono::milliseconds(1);
+    settings.monitorDownInterval = std::chrono::milliseconds(1);
+    SkyrimNet::Controller controller(transport, settings);
+    controller.SetPushEnabled(false);
+    SkyrimNet::HealthMonitor monitor(transport, settings);
+
+    std::atomic<uint64_t> notifications{0};
+    controller.SetStatusListener([&notifications](SkyrimNet::GameMasterStatus) {
+        notifications.fetch_add(1);
+        notifications.notify_all();
+    });
+
+    Lifecycle::Manager lifecycle;
+    lifecycle.Register(
+        "polling", Lifecycle::kAllReasons, [&controller]() { controller.StartPolling(); },
+        [&controller]() { controller.StopPolling(); });
+    lifecycle.Register(
+        "health", Lifecycle::kAllReasons, [&monitor]() { monitor.Start(); }, [&monitor]() { monitor.Stop(); });
+
+    for (auto _ : state) {
+        const uint64_t seen = notifications.load();
+        lifecycle.Resume(Lifecycle::Reason::ViewHidden);
+        notifications.wait(seen);
+        lifecycle.Suspend(Lifecycle::Reason::ViewHidden);
+    }
+    lifecycle.UnregisterAll();
+    controller.Shutdown();
+    monitor.Shutdown();
+}
+BENCHMARK(BM_LifecycleSuspendResume)->UseRealTime();
+
+// Concurrent status reads through SingleFlightTransport, as when the poll, a toggle confirmation
+// and a health probe land together. Args: readers, server latency (ms)
+static void BM_SingleFlightStatus(benchmark::State& state) {
+    Http::FakeTransport fake;
+    RouteServer(fake, std::chrono::milliseconds(state.range(1)), 512);
+    Http::SingleFlightTransport transport(fake);
+    const auto url = Url("/?api=gamemaster-status");
+
+    for (auto _ : state) {
+        // Measure merging alone, not reuse of the previous batch's response
+        transport.Clear();
+        std::vector<std::future<Http::Response>> readers;
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            readers.push_back(std::async(std::launch::async, [&transport, &url]() {
+                return transport.Get(url, {.maxAge = std::chrono::milliseconds(1)});
+            }));
+        }
+        for (auto& reader : readers) {
+            benchmark::DoNotOptimize(reader.get());
+        }
+    }
+
+    state.counters["server_requests"] = benchmark::Counter(static_cast<double>(fake.RequestCount("GET", url)),
+                                                           benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_SingleFlightStatus)->Args({8, 0})->Args({8, 5})->UseRealTime();
+
+// Switch between two overlay panels until the new one is ready, with CreateView taking 2 ms and
+// the page another 5 ms. Arg: 0 = a fresh view per switch, 1 = pooled views from the ViewManager
+static void BM_ViewSwitch(benchmark::State& state) {
+    FakePrismaUI api(std::chrono::milliseconds(2), std::chrono::milliseconds(5));
+
+    if (state.range(0) == 0) {
+        PrismaView current = 0;
+        for (auto _ : state) {
+            const uint64_t seen = g_domReadyCount.load();
+            const PrismaView next = api.CreateView("panel.html", CountDomReady);
+            g_domReadyCount.wait(seen);
+            api.Destroy(current);
+            current = next;
+        }
+    } else {
+        // Interop flushes wait for the next "frame", as they do for the SKSE task queue
+        std::mutex frameMutex;
+        std::vector<std::function<void()>> frame;
+        auto runFrame = [&frameMutex, &frame]() {
+            std::vector<std::function<void()>> tasks;
+            {
+                std::lock_guard lock(frameMutex);
+                tasks.swap(frame);
+            }
+            for (auto& task : tasks) {
+                task();
+            }
+        };
+
+        // The manager routes DOM-ready and listener callbacks through its global instance
+        auto& views = UI::GetViewManager();
+        views.Attach(&api, [&frameMutex, &frame](std::function<void()> task) {
+            std::lock_guard lock(frameMutex);
+            frame.push_back(std::move(task));
+        });
+        std::atomic<uint64_t> ready{0};
+        for (const char* name : {"a", "b"}) {
+            views.Define(name, {.htmlPath = {}, .url = std::string("https://example.invalid/") + name, .order = 1});
+            views.SetReadyHandler(name, [&ready](PrismaView) {
+                ready.fetch_add(1);
+                ready.notify_all();
+            });
+        }
+        views.Prewarm(1);
+
+        bool first = true;
+        for (auto _ : state) {
+            const uint64_t seen = ready.load();
+            views.Close(first ? "a" : "b");
+            views.Open(first ? "b" : "a");
+            ready.wait(seen);
+            runFrame();
+            first = !first;
+        }
+        runFrame();
+        views.Shutdown();
+    }
+
+    state.counters["views_created"] =
+        benchmark::Counter(static_cast<double>(api.Created()), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_ViewSwitch)->Arg(0)->Arg(1)->UseRealTime();
+
+// Reopening the web UI page: the document plus 12 assets of 64 KiB, each answered after 2 ms, fetched
+// one after another. Arg: 0 = straight from the server, 1 = through the AssetProxy, with the view
+// revalidating every asset with the ETag it got last time (it keeps nothing itself)
+static void BM_WebUiReopen(benchmark::State& state) {
+    constexpr int kAssets = 12;
+    constexpr auto kLatency = std::chrono::milliseconds(2);
+    const bool proxied = state.range(0) != 0;
+
+    Http::FakeTransport server;
+    std::vector<std::string> targets{"/config"};
+    server.SetRoute("GET", Url("/config"),
+                    {.response = {200, std::string(8 << 10, 'h'), {{"Content-Type", "text/html"}}},
+                     .latency = kLatency});
+    for (int i = 0; i < kAssets; ++i) {
+        targets.push_back("/assets/chunk-" + std::to_string(i) + (i % 2 ? ".js" : ".css"));
+        server.SetRoute("GET", Url(targets.back()),
+                        {.response = {200, std::string(64 << 10, 'a'), {{"Content-Type", "text/javascript"}}},
+                         .latency = kLatency});
+    }
+    Http::AssetProxy proxy(server, {.upstream = std::string(kBaseUrl)});
+
+    std::map<std::string, std::string> etags;  // What the view would send as If-None-Match
+    uint64_t viewBytes = 0;
+    auto open = [&]() {
+        for (const auto& target : targets) {
+            Http::Response response;
+            if (proxied) {
+                Http::ProxyRequest request{.method = "GET", .target = target, .headers = {}, .body = {}};
+                if (auto etag = etags.find(target); etag != etags.end()) {
+                    request.headers.emplace("If-None-Match", etag->second);
+                }
+                response = proxy.Handle(request);
+                etags[target] = response.header("ETag");
+            } else {
+                response = server.Get(Url(target));
+            }
+            viewBytes += response.body.size();
+        }
+    };
+
+    // The first open fills the proxy; the iterations are reopens
+    open();
+    server.ClearRequests();
+    viewBytes = 0;
+    for (auto _ : state) {
+        open();
+    }
+
+    state.counters["server_requests"] =
+        benchmark::Counter(static_cast<double>(server.GetRequests().size()), benchmark::Counter::kAvgIterations);
+    state.counters["view_bytes"] =
+        benchmark::Counter(static_cast<double>(viewBytes), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_WebUiReopen)->Arg(0)->Arg(1)->UseRealTime();
+
+// A second of SkyrimNet events at 10k/s from a fake event server, one 192-byte event per chunk,
+// into an EventFeed with the default 1024-event ring. Arg: 1 = overlay open, taking a batch every
+// 100 ms and encoding it like UIBridge's DeliverEvents; 0 = closed, so the ring keeps only the
+// newest events, which are taken once at the end as if the overlay had just been opened
+static void BM_EventFeedThroughput(benchmark::State& state) {
+    constexpr size_t kEvents = 10000;
+    constexpr size_t kEventBytes = 192;
+    constexpr auto kBatchInterval = std::chrono::milliseconds(100);
+    const bool visible = state.range(0) != 0;
+
+    static constexpr std::string_view kTypes[] = {"dialogue", "gamemaster", "error"};
+    std::string stream;
+    for (size_t i = 0; i < kEvents; ++i) {
+        std::string event = "id: " + std::to_string(i + 1) + "\nevent: " + std::string(kTypes[i % 3]) +
+                            "\ndata: {\"speaker\":\"Lydia\",\"text\":\"";
+        event.append(kEventBytes - event.size() - 5, '.').append("\"}\n\n");
+        stream.append(event);
+    }
+
+    Http::FakeTransport server;
+    server.SetRoute("STREAM", Url("/?api=events"),
+                    {.response = {200, stream, {{"Content-Type", "text/event-stream"}}},
+                     .chunkSize = kEventBytes,
+                     .chunkInterval = std::chrono::microseconds(100)});
+    SkyrimNet::EventFeed feed(server, FakeServer());
+
+    uint64_t delivered = 0;
+    uint64_t batches = 0;
+    uint64_t wireBytes = 0;
+    auto deliver = [&]() {
+        const auto batch = feed.TakeBatch(std::numeric_limits<size_t>::max());
+        if (batch.empty()) {
+            return;
+        }
+        MsgPack::Writer payload(batch.size() * 128);
+        payload.Array(static_cast<uint32_t>(batch.size()));
+        for (const auto& event : batch) {
+            payload.Array(3);
+            payload.UInt(event.sequence);
+            payload.String(event.type);
+            payload.String(event.data);
+        }
+        for (const auto& frame : UI::InteropChannel::MakeFrames({"events", 1}, 0, payload.Data(),
+                                                                UI::InteropChannel::kDefaultFrameSize)) {
+            wireBytes += frame.size();
+        }
+        delivered += batch.size();
+        batches++;
+    };
+
+    double seconds = 0;
+    for (auto _ : state) {
+        const uint64_t target = feed.GetStats().received + kEvents;
+        const auto started = std::chrono::steady_clock::now();
+        feed.Start();
+        while (feed.GetStats().received < target &&
+               std::chrono::steady_clock::now() - started < std::chrono::seconds(10)) {
+            std::this_thread::sleep_for(kBatchInterval);
+            if (visible) {
+                deliver();
+            }
+        }
+        seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        feed.Stop();
+        deliver();
+    }
+    feed.Shutdown();
+
+    const auto stats = feed.GetStats();
+    state.counters["received_per_s"] = static_cast<double>(stats.received) / seconds;
+    state.counters["delivered"] =
+        benchmark::Counter(static_cast<double>(delivered), benchmark::Counter::kAvgIterations);
+    state.counters["overwritten"] =
+        benchmark::Counter(static_cast<double>(stats.overwritten), benchmark::Counter::kAvgIterations);
+    state.counters["batches"] = benchmark::Counter(static_cast<double>(batches), benchmark::Counter::kAvgIterations);
+    state.counters["wire_bytes"] =
+        benchmark::Counter(static_cast<double>(wireBytes), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_EventFeedThroughput)->Arg(1)->Arg(0)->Iterations(2)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Pushing into a full ring while another thread takes batches, as the stream and delivery tasks do
+static void BM_EventRingPush(benchmark::State& state) {
+    SkyrimNet::EventRing ring(1024);
+    std::atomic<bool> running{true};
+    std::thread reader([&]() {
+        std::vector<SkyrimNet::FeedEvent> batch;
+        while (running.load()) {
+            batch.clear();
+            ring.Drain(batch, 256);
+            std::this_thread::yield();
+        }
+    });
+
+    uint64_t sequence = 0;
+    for (auto _ : state) {
+        ring.Push({++sequence, "dialogue", R"({"speaker":"Lydia","text":"I am sworn to carry your burdens."})"});
+    }
+    running = false;
+    reader.join();
+    state.SetItemsProcessed(state.iterations());
+    state.counters["overwritten"] = static_cast<double>(ring.Overwritten());
+}
+BENCHMARK(BM_EventRingPush)->UseRealTime();
+
+// Status lookup in a response with the field buried behind filler
+static void BM_JsonFindMember(benchmark::State& state) {
+    std::string document = R"({"status":{"agent_enabled":true}})";
+    document.insert(1, R"("padding":")" + std::string(static_cast<size_t>(state.range(0)), 'x') + R"(",)");
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Json::FindMember(document, "agent_enabled"));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(document.size()));
+}
+BENCHMARK(BM_JsonFindMember)->Arg(64)->Arg(4 << 10)->Arg(256 << 10);
+
+namespace {
+    /// Game config of about size bytes: sections with their own "enabled" flags ahead of gamemaster
+    std::string MakeGameConfig(size_t size) {
+        std::string config = "{";
+        for (size_t i = 0; config.size() < size; ++i) {
+            config.append(R"("section)").append(std::to_string(i));
+            config.append(R"(":{"enabled":true,"name":"Section name","weights":[1,2,3,4,5,6,7,8]},)");
+        }
+        config.append(R"("gamemaster":{"enabled":false,"agentEnabled":false,"interval":30}})");
+        return config;
+    }
+
+    // The config rewrite Json::Resolve and Json::ApplyPatches replaced, kept as the baseline
+    std::string LegacyReplaceBoolean(const std::string& json, size_t searchStart, const std::string& fieldName,
+                                     bool newValue) {
+        size_t fieldPos = json.find("\"" + fieldName + "\"", searchStart);
+        if (fieldPos == std::string::npos) {
+            return json;
+        }
+        size_t colonPos = json.find(":", fieldPos);
+        if (colonPos == std::string::npos) {
+            return json;
+        }
+        size_t valueStart = colonPos + 1;
+        while (valueStart < json.length() && (json[valueStart] == ' ' || json[valueStart] == '\t' ||
+                                              json[valueStart] == '\n' || json[valueStart] == '\r')) {
+            valueStart++;
+        }
+        size_t valueEnd = json.find_first_of(",}]", valueStart);
+        if (valueEnd == std::string::npos) {
+            return json;
+        }
+        size_t actualEnd = valueEnd;
+        while (actualEnd > valueStart && (json[actualEnd - 1] == ' ' || json[actualEnd - 1] == '\t' ||
+                                          json[actualEnd - 1] == '\n' || json[actualEnd - 1] == '\r')) {
+            actualEnd--;
+        }
+        return json.substr(0, valueStart) + (newValue ? "true" : "false") + json.substr(actualEnd);
+    }
+
+    std::string LegacyToggle(const std::string& config, bool newState) {
+        size_t gamemasterPos = config.find("\"gamemaster\"");
+        std::string updated = LegacyReplaceBoolean(config, gamemasterPos, "agentEnabled", newState);
+        gamemasterPos = updated.find("\"gamemaster\"");
+        return LegacyReplaceBoolean(updated, gamemasterPos, "enabled", newState);
+    }
+}
+
+// Setting both gamemaster flags in the config document before a full commit
+// Args: document size (bytes), 0 = the replaced find-and-copy rewrite, 1 = Json::Resolve + Json::ApplyPatches
+static void BM_ConfigToggleRewrite(benchmark::State& state) {
+    const std::string config = MakeGameConfig(static_cast<size_t>(state.range(0)));
+    const bool scanner = state.range(1) != 0;
+    constexpr std::array<std::string_view, 3> pointers{"/gamemaster", "/gamemaster/enabled",
+                                                       "/gamemaster/agentEnabled"};
+    std::array<std::optional<std::string_view>, pointers.size()> values;
+
+    const uint64_t allocationsBefore = g_allocations.load();
+    bool enabled = false;
+    for (auto _ : state) {
+        enabled = !enabled;
+        if (scanner) {
+            if (!Json::Resolve(config, pointers, values) || !values[1] || !values[2]) {
+                state.SkipWithError("gamemaster fields not found");
+                break;
+            }
+            std::array<Json::Patch, 2> patches{{{*values[1], enabled ? "true" : "false"},
+                                                {*values[2], enabled ? "true" : "false"}}};
+            benchmark::DoNotOptimize(Json::ApplyPatches(config, patches));
+        } else {
+            benchmark::DoNotOptimize(LegacyToggle(config, enabled));
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(config.size()));
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(g_allocations.load() - allocationsBefore),
+                                                  benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_ConfigToggleRewrite)
+    ->ArgsProduct({{10 << 10, 100 << 10, 1 << 20, 5 << 20}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Status events split into chunks of the given size
+static void BM_SseParse(benchmark::State& state) {
+    std::string stream;
+    for (int i = 0; i < 100; ++i) {
+        stream.append("event: status\ndata: {\"agent_enabled\":true}\n\n");
+    }
+    const auto chunkSize = static_cast<size_t>(state.range(0));
+
+    size_t events = 0;
+    Http::SseParser parser([&events](const Http::ServerSentEvent&) { ++events; });
+    for (auto _ : state) {
+        for (size_t offset = 0; offset < stream.size(); offset += chunkSize) {
+            parser.Feed(std::string_view(stream).substr(offset, chunkSize));
+        }
+    }
+    benchmark::DoNotOptimize(events);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(stream.size()));
+}
+BENCHMARK(BM_SseParse)->Arg(16)->Arg(4 << 10);
+
+// A nearby-NPC list as the view would get it: {formId, name, distance, hostile} per entry
+struct NpcEntry {
+    uint32_t formId;
+    std::string name;
+    double distance;
+    bool hostile;
+};
+
+static std::vector<NpcEntry> MakeNpcs(size_t count) {
+    static constexpr std::string_view kNames[] = {"Lydia", "Nazeem", "Ulfric \"Stormcloak\"", "Jarl Balgruuf"};
+    std::vector<NpcEntry> npcs;
+    for (size_t i = 0; i < count; ++i) {
+        npcs.push_back({static_cast<uint32_t>(0x000A2C94 + i), std::string(kNames[i % std::size(kNames)]) +
+                        " " + std::to_string(i), 128.5 + static_cast<double>(i) * 3.25, i % 3 == 0});
+    }
+    return npcs;
+}
+
+// What UIBridge did before the channel: JSON built with appends, strings escaped by hand
+static std::string NpcsToJson(const std::vector<NpcEntry>& npcs) {
+    std::string json = "{\"npcs\":[";
+    for (const auto& npc : npcs) {
+        if (&npc != &npcs.front()) {
+            json.push_back(',');
+        }
+        json.append("{\"formId\":").append(std::to_string(npc.formId)).append(",\"name\":\"");
+        for (const char c : npc.name) {
+            if (c == '"' || c == '\\') {
+                json.push_back('\\');
+            }
+            json.push_back(c);
+        }
+        json.append("\",\"distance\":").append(std::to_string(npc.distance));
+        json.append(",\"hostile\":").append(npc.hostile ? "true" : "false").push_back('}');
+    }
+    json.append("]}");
+    return json;
+}
+
+static std::string NpcsToMsgPack(const std::vector<NpcEntry>& npcs) {
+    MsgPack::Writer writer(npcs.size() * 48);
+    writer.Map(1);
+    writer.String("npcs");
+    writer.Array(static_cast<uint32_t>(npcs.size()));
+    for (const auto& npc : npcs) {
+        writer.Map(4);
+        writer.String("formId");
+        writer.UInt(npc.formId);
+        writer.String("name");
+        writer.String(npc.name);
+        writer.String("distance");
+        writer.Double(npc.distance);
+        writer.String("hostile");
+        writer.Bool(npc.hostile);
+    }
+    return writer.Take();
+}
+
+// Encoding an NPC list for the view. Args: entries, 0 = hand-built JSON, 1 = MessagePack cut into
+// channel frames (base64 included)
+static void BM_InteropEncode(benchmark::State& state) {
+    const auto npcs = MakeNpcs(static_cast<size_t>(state.range(0)));
+    const bool framed = state.range(1) != 0;
+
+    size_t wireBytes = 0;
+    for (auto _ : state) {
+        wireBytes = 0;
+        if (framed) {
+            for (const auto& frame : UI::InteropChannel::MakeFrames({"npcs", 1}, 0, NpcsToMsgPack(npcs),
+                                                                    UI::InteropChannel::kDefaultFrameSize)) {
+                wireBytes += frame.size();
+            }
+        } else {
+            wireBytes = NpcsToJson(npcs).size();
+        }
+        benchmark::DoNotOptimize(wireBytes);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(wireBytes));
+    state.counters["wire_bytes"] = static_cast<double>(wireBytes);
+}
+BENCHMARK(BM_InteropEncode)->Args({16, 0})->Args({16, 1})->Args({1024, 0})->Args({1024, 1});
+
+// Reading 16 NPC entries back into values. Arg: 0 = JSON through one Json::Resolve pass with a
+// pointer per field (64, the most it takes), 1 = base64 decode plus a MsgPack::Reader walk
+static void BM_InteropDecode(benchmark::State& state) {
+    constexpr size_t kEntries = 16;
+    const auto npcs = MakeNpcs(kEntries);
+    const bool framed = state.range(0) != 0;
+
+    const auto json = NpcsToJson(npcs);
+    const auto base64 = UI::Base64Encode(NpcsToMsgPack(npcs));
+    std::vector<std::string> pointerText;
+    for (size_t i = 0; i < kEntries; ++i) {
+        for (const char* field : {"formId", "name", "distance", "hostile"}) {
+            pointerText.push_back("/npcs/" + std::to_string(i) + "/" + field);
+        }
+    }
+    const std::vector<std::string_view> pointers(pointerText.begin(), pointerText.end());
+    std::vector<std::optional<std::string_view>> results(pointers.size());
+
+    std::vector<NpcEntry> decoded(kEntries);
+    for (auto _ : state) {
+        if (framed) {
+            const auto payload = UI::Base64Decode(base64);
+            MsgPack::Reader reader(*payload);
+            reader.ReadMap();
+            reader.ReadString();
+            const uint32_t count = reader.ReadArray().value_or(0);
+            for (uint32_t i = 0; i < count && i < kEntries; ++i) {
+                const uint32_t fields = reader.ReadMap().value_or(0);
+                for (uint32_t f = 0; f < fields; ++f) {
+                    const auto key = reader.ReadString().value_or("");
+                    if (key == "formId") {
+                        decoded[i].formId = static_cast<uint32_t>(reader.ReadInt().value_or(0));
+                    } else if (key == "name") {
+                        decoded[i].name = reader.ReadString().value_or("");
+                    } else if (key == "distance") {
+                        decoded[i].distance = reader.ReadDouble().value_or(0);
+                    } else if (key == "hostile") {
+                        decoded[i].hostile = reader.ReadBool().value_or(false);
+                    } else {
+                        reader.Skip();
+                    }
+                }
+            }
+        } else {
+            Json::Resolve(json, pointers, results);
+            for (size_t i = 0; i < kEntries; ++i) {
+                const auto value = [&](size_t field) { return results[i * 4 + field].value_or(""); };
+                const auto formId = value(0);
+                std::from_chars(formId.data(), formId.data() + formId.size(), decoded[i].formId);
+                // Strings keep their quotes; the escapes still have to be undone
+                const auto name = value(1).substr(1, value(1).size() - 2);
+                decoded[i].name.clear();
+                for (size_t c = 0; c < name.size(); ++c) {
+                    decoded[i].name.push_back(name[c] == '\\' && c + 1 < name.size() ? name[++c] : name[c]);
+                }
+                const auto distance = value(2);
+                std::from_chars(distance.data(), distance.data() + distance.size(), decoded[i].distance);
+                decoded[i].hostile = Json::AsBool(value(3)).value_or(false);
+            }
+        }
+        benchmark::DoNotOptimize(decoded.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kEntries));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(framed ? base64.size() : json.size()));
+}
+BENCHMARK(BM_InteropDecode)->Arg(0)->Arg(1);
+
+// One keyboard event through KeyHandler with the given number of unrelated bindings registered
+static void BM_KeyDispatch(benchmark::State& state) {
+    constexpr uint32_t kF4 = 0x3E;
+    auto* handler = KeyHandler::GetSingleton();
+    KeyHandler::RegisterSink();
+
+    size_t fired = 0;
+    std::vector<KeyHandlerEvent> handles;
+    handles.push_back(handler->Register(kF4, KeyEventType::KEY_DOWN, [&fired]() { ++fired; }));
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        const auto key = static_cast<uint32_t>(0x02 + i % 0x30);
+        handles.push_back(handler->Register(key, KeyEventType::KEY_UP, []() {}));
+    }
+
+    RE::ButtonEvent down;
+    down.idCode = kF4;
+    down.value = 1.0f;
+    RE::ButtonEvent up;
+    up.idCode = kF4;
+    up.heldDownSecs = 0.1f;
+    down.next = &up;
+    RE::InputEvent* events = &down;
+
+    auto* source = RE::BSInputDeviceManager::GetSingleton();
+    for (auto _ : state) {
+        source->SendEvent(&events);
+    }
+
+    for (auto handle : handles) {
+        handler->Unregister(handle);
+    }
+    benchmark::DoNotOptimize(fired);
+}
+BENCHMARK(BM_KeyDispatch)->Arg(0)->Arg(64);
+
+static void BM_ParseKeyBinding(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ParseKeyBinding("Ctrl+Shift+F4:Hold=0.8"));
+    }
+}
+BENCHMARK(BM_ParseKeyBinding);
+
+static void BM_MetricsRecord(benchmark::State& state) {
+    for (auto _ : state) {
+        Metrics::Record(Metrics::Metric::KeyEvent, std::chrono::nanoseconds(1500));
+    }
+}
+BENCHMARK(BM_MetricsRecord)->Threads(1)->Threads(4);
+
+// A burst of short background tasks, like polls and probes, while the plugin's two long-lived
+// streams are open. Arg 0 holds the streams on the background lane, as before the stream lane
+// existed; arg 1 on the stream lane.
+static void BM_SchedulerDispatch(benchmark::State& state) {
+    constexpr int kBurst = 16;
+    const auto streamLane = state.range(0) != 0 ? Scheduler::Lane::Stream : Scheduler::Lane::Background;
+
+    // Outlives the scheduler, whose workers may still be notifying it after the wait below returns
+    std::atomic<int> remaining{0};
+    Scheduler::TaskScheduler scheduler;
+    std::promise<void> closeStreams;
+    const auto closed = closeStreams.get_future().share();
+    std::atomic<int> openStreams{0};
+    for (int i = 0; i < 2; ++i) {
+        scheduler.Post(streamLane, [&openStreams, closed]() {
+            ++openStreams;
+            closed.wait();
+        });
+    }
+    while (openStreams.load() < 2) {
+        std::this_thread::yield();
+    }
+
+    const auto before = scheduler.GetStats();
+    for (auto _ : state) {
+        remaining = kBurst;
+        for (int i = 0; i < kBurst; ++i) {
+            scheduler.Post(Scheduler::Lane::Background, [&remaining]() {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                if (--remaining == 0) {
+                    remaining.notify_all();
+                }
+            });
+        }
+        for (int left = remaining.load(); left != 0; left = remaining.load()) {
+            remaining.wait(left);
+        }
+    }
+    const auto after = scheduler.GetStats();
+    closeStreams.set_value();
+    scheduler.Shutdown();
+
+    const auto runs = static_cast<double>(after.backgroundTasksRun - before.backgroundTasksRun);
+    state.counters["dispatch_us_mean"] =
+        runs > 0 ? static_cast<double>(after.totalDispatchMicros - before.totalDispatchMicros) / runs : 0.0;
+    state.counters["dispatch_us_max"] = static_cast<double>(after.maxDispatchMicros);
+    state.counters["threads"] = static_cast<double>(after.threadsCreated);
+}
+BENCHMARK(BM_SchedulerDispatch)->Arg(0)->Arg(1)->UseRealTime();
+
+namespace {
+    /// Discards messages, spending cost on each like a slow disk would
+    class DiscardSink final : public spdlog::sinks::base_sink<std::mutex> {
+    public:
+        explicit DiscardSink(std::chrono::microseconds cost = {}) : cost_(cost) {}
+
+    protected:
+        void sink_it_(const spdlog::details::log_msg&) override {
+            if (cost_ > std::chrono::microseconds::zero()) {
+                std::this_thread::sleep_for(cost_);
+            }
+        }
+        void flush_() override {}
+
+    private:
+        const std::chrono::microseconds cost_;
+    };
+
+    /// Sends LOG_* through the asynchronous logger of Log::Initialize into sink while in scope
+    class AsyncLogScope {
+    public:
+        explicit AsyncLogScope(std::shared_ptr<spdlog::sinks::sink> sink) : previous_(spdlog::default_logger()) {
+            spdlog::set_default_logger(std::make_shared<spdlog::logger>("benchmark", std::move(sink)));
+            Log::Initialize();
+        }
+        ~AsyncLogScope() {
+            Log::Shutdown();
+            spdlog::set_default_logger(previous_);
+        }
+
+    private:
+        std::shared_ptr<spdlog::logger> previous_;
+    };
+
+    const std::string kLogUrl = Url("/config?api=get&name=game");
+}
+
+// Caller-side cost of a message below its subsystem's level: one relaxed load, arguments untouched
+static void BM_LogDisabled(benchmark::State& state) {
+    for (auto _ : state) {
+        LOG_DEBUG(Http, "GET {} answered {} ({} bytes)", kLogUrl, 200, state.iterations());
+    }
+}
+BENCHMARK(BM_LogDisabled);
+
+// Caller-side cost of an enabled message: formatting and a push onto the writer's queue. Some
+// messages are still dropped when the caller outpaces the writer thread in a tight loop.
+static void BM_LogAsync(benchmark::State& state) {
+    uint64_t overruns = 0;
+    {
+        AsyncLogScope scope(std::make_shared<DiscardSink>());
+        const auto before = Log::GetStats().overruns;
+        for (auto _ : state) {
+            LOG_INFO(Http, "GET {} answered {} ({} bytes)", kLogUrl, 200, state.iterations());
+        }
+        overruns = Log::GetStats().overruns - before;
+    }
+    state.counters["dropped"] = benchmark::Counter(static_cast<double>(overruns), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_LogAsync);
+
+// Enabled messages against a writer that can't keep up (20 us per message): with the default
+// drop policy the caller overwrites the oldest queued message instead of waiting for the disk
+static void BM_LogOverflow(benchmark::State& state) {
+    uint64_t overruns = 0;
+    {
+        AsyncLogScope scope(std::make_shared<DiscardSink>(std::chrono::microseconds(20)));
+        const auto before = Log::GetStats().overruns;
+        for (auto _ : state) {
+            LOG_INFO(Http, "GET {} answered {} ({} bytes)", kLogUrl, 200, state.iterations());
+        }
+        overruns = Log::GetStats().overruns - before;
+    }
+    state.counters["dropped"] = benchmark::Counter(static_cast<double>(overruns), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_LogOverflow);
+
+int main(int argc, char** argv) {
+    // The controller logs every toggle; keep the benchmark output readable
+    spdlog::set_level(spdlog::level::off);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
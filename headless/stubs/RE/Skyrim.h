@@ -0,0 +1,95 @@
+#pragma once
+
+// Headless stand-in for CommonLibSSE's RE/Skyrim.h: just the input event types the core uses.
+// Layouts don't match the game; only the member functions called by KeyHandler are provided.
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace RE {
+
+    enum class BSEventNotifyControl : uint32_t { kContinue = 0, kStop = 1 };
+
+    template <class Event>
+    class BSTEventSource;
+
+    template <class Event>
+    class BSTEventSink {
+    public:
+        virtual ~BSTEventSink() = default;
+        virtual BSEventNotifyControl ProcessEvent(const Event* a_event, BSTEventSource<Event>* a_eventSource) = 0;
+    };
+
+    template <class Event>
+    class BSTEventSource {
+    public:
+        void AddEventSink(BSTEventSink<Event>* a_sink) {
+            if (std::ranges::find(sinks_, a_sink) == sinks_.end()) {
+                sinks_.push_back(a_sink);
+            }
+        }
+
+        void RemoveEventSink(BSTEventSink<Event>* a_sink) { std::erase(sinks_, a_sink); }
+
+        void SendEvent(const Event* a_event) {
+            for (auto* sink : sinks_) {
+                if (sink->ProcessEvent(a_event, this) == BSEventNotifyControl::kStop) {
+                    break;
+                }
+            }
+        }
+
+    private:
+        std::vector<BSTEventSink<Event>*> sinks_;
+    };
+
+    enum class INPUT_DEVICE : uint32_t { kKeyboard = 0, kMouse, kGamepad, kVirtualKeyboard };
+
+    enum class INPUT_EVENT_TYPE : uint32_t { kButton = 0, kMouseMove, kChar, kThumbstick, kDeviceConnect };
+
+    class ButtonEvent;
+
+    class InputEvent {
+    public:
+        virtual ~InputEvent() = default;
+
+        [[nodiscard]] INPUT_DEVICE GetDevice() const noexcept { return device; }
+
+        [[nodiscard]] ButtonEvent* AsButtonEvent() noexcept;
+
+        INPUT_DEVICE device = INPUT_DEVICE::kKeyboard;
+        INPUT_EVENT_TYPE eventType = INPUT_EVENT_TYPE::kButton;
+        InputEvent* next = nullptr;
+    };
+
+    class ButtonEvent : public InputEvent {
+    public:
+        [[nodiscard]] uint32_t GetIDCode() const noexcept { return idCode; }
+        [[nodiscard]] float HeldDuration() const noexcept { return heldDownSecs; }
+        [[nodiscard]] bool IsPressed() const noexcept { return value > 0.0f; }
+        [[nodiscard]] bool IsDown() const noexcept { return IsPressed() && heldDownSecs == 0.0f; }
+        [[nodiscard]] bool IsHeld() const noexcept { return IsPressed() && heldDownSecs > 0.0f; }
+        [[nodiscard]] bool IsUp() const noexcept { return value == 0.0f && heldDownSecs > 0.0f; }
+
+        uint32_t idCode = 0;
+        float value = 0.0f;
+        float heldDownSecs = 0.0f;
+    };
+
+    inline ButtonEvent* InputEvent::AsButtonEvent() noexcept {
+        return eventType == INPUT_EVENT_TYPE::kButton ? static_cast<ButtonEvent*>(this) : nullptr;
+    }
+
+    /**
+     * @brief Input event source; headless callers push events through SendEvent
+     */
+    class BSInputDeviceManager : public BSTEventSource<InputEvent*> {
+    public:
+        static BSInputDeviceManager* GetSingleton() {
+            static BSInputDeviceManager singleton;
+            return &singleton;
+        }
+    };
+
+}  // namespace RE
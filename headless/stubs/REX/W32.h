@@ -0,0 +1,13 @@
+#pragma once
+
+// Headless stand-in for CommonLibSSE's REX/W32.h: no modules are ever loaded.
+
+namespace REX::W32 {
+
+    using HMODULE = void*;
+
+    inline HMODULE GetModuleHandleW(const wchar_t*) noexcept { return nullptr; }
+
+    inline void* GetProcAddress(HMODULE, const char*) noexcept { return nullptr; }
+
+}  // namespace REX::W32
@@ -0,0 +1,45 @@
+#pragma once
+
+// Headless stand-in for CommonLibSSE's SKSE/SKSE.h: logging goes straight to spdlog and
+// there is no task queue, so game-thread work runs inline.
+
+#include <spdlog/spdlog.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string_view>
+
+namespace SKSE {
+
+    using PluginHandle = uint32_t;
+
+    class TaskInterface {
+    public:
+        void AddTask(std::function<void()> task) const { task(); }
+    };
+
+    /// @return nullptr; there is no game frame to defer to
+    inline const TaskInterface* GetTaskInterface() noexcept { return nullptr; }
+
+    namespace log {
+        using spdlog::critical;
+        using spdlog::debug;
+        using spdlog::error;
+        using spdlog::info;
+        using spdlog::trace;
+        using spdlog::warn;
+
+        inline std::optional<std::filesystem::path> log_directory() { return std::filesystem::current_path(); }
+    }
+
+    namespace stl {
+        [[noreturn]] inline void report_and_fail(std::string_view message) {
+            spdlog::critical("{}", message);
+            std::abort();
+        }
+    }
+
+}  // namespace SKSE
@@ -0,0 +1,108 @@
+// AssetProxy against a scripted server: what reaches the server as sent, and what is cached
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "FakeServer.h"
+#include "http/AssetProxy.h"
+
+using namespace SkyrimNetUI;
+using namespace SkyrimNetUI::Tests;
+
+namespace {
+    Http::AssetProxy MakeProxy(Http::FakeTransport& transport) {
+        return Http::AssetProxy(transport, {.upstream = std::string(kBaseUrl)});
+    }
+
+    Http::ProxyRequest Request(std::string method, std::string target, std::string body = {},
+                               std::string contentType = {}) {
+        Http::ProxyRequest request{.method = std::move(method), .target = std::move(target), .headers = {},
+                                   .body = std::move(body)};
+        if (!contentType.empty()) {
+            request.headers.emplace("Content-Type", std::move(contentType));
+        }
+        return request;
+    }
+}
+
+TEST(AssetProxy, PostKeepsItsBodyAndContentType) {
+    Http::FakeTransport transport;
+    transport.SetRoute("POST", Url("/login"), {.response = {200, "ok", {}}});
+    auto proxy = MakeProxy(transport);
+
+    const auto response = proxy.Handle(Request("POST", "/login", "user=a&pass=b", "application/x-www-form-urlencoded"));
+
+    EXPECT_EQ(response.status, 200);
+    const auto requests = transport.GetRequests();
+    ASSERT_EQ(requests.size(), 1u);
+    EXPECT_EQ(requests[0].body, "user=a&pass=b");
+    EXPECT_EQ(requests[0].headers.at("Content-Type"), "application/x-www-form-urlencoded");
+}
+
+TEST(AssetProxy, EveryMethodIsForwardedAsSent) {
+    Http::FakeTransport transport;
+    for (const char* method : {"PUT", "PATCH", "DELETE", "OPTIONS"}) {
+        transport.SetRoute(method, Url("/api/prompts/1"), {.response = {204, {}, {}}});
+    }
+    auto proxy = MakeProxy(transport);
+
+    EXPECT_EQ(proxy.Handle(Request("PUT", "/api/prompts/1", "{\"text\":\"hi\"}", "application/json")).status, 204);
+    EXPECT_EQ(proxy.Handle(Request("PATCH", "/api/prompts/1", "text=hi", "text/plain")).status, 204);
+    EXPECT_EQ(proxy.Handle(Request("DELETE", "/api/prompts/1")).status, 204);
+    EXPECT_EQ(proxy.Handle(Request("OPTIONS", "/api/prompts/1")).status, 204);
+
+    const auto requests = transport.GetRequests();
+    ASSERT_EQ(requests.size(), 4u);
+    EXPECT_EQ(requests[0].method, "PUT");
+    EXPECT_EQ(requests[0].body, "{\"text\":\"hi\"}");
+    EXPECT_EQ(requests[1].method, "PATCH");
+    EXPECT_EQ(requests[1].headers.at("Content-Type"), "text/plain");
+    EXPECT_EQ(requests[2].method, "DELETE");
+    EXPECT_FALSE(requests[2].headers.contains("Content-Type"));
+    EXPECT_EQ(requests[3].method, "OPTIONS");
+    EXPECT_EQ(proxy.GetStats().passedThrough, 4u);
+}
+
+TEST(AssetProxy, WebSocketUpgradeIsRefusedRatherThanStripped) {
+    Http::FakeTransport transport;
+    transport.SetRoute("GET", Url("/ws"), {.response = {200, "not a socket", {}}});
+    auto proxy = MakeProxy(transport);
+
+    auto request = Request("GET", "/ws");
+    request.headers.emplace("Connection", "Upgrade");
+    request.headers.emplace("Upgrade", "websocket");
+
+    EXPECT_EQ(proxy.Handle(request).status, 501);
+    EXPECT_TRUE(transport.GetRequests().empty());
+}
+
+TEST(AssetProxy, AssetsAreServedFromMemoryAndRevalidatedByHash) {
+    Http::FakeTransport transport;
+    transport.SetRoute("GET", Url("/assets/index.js"),
+                       {.response = {200, "console.log(1)", {{"Content-Type", "text/javascript"}}}});
+    auto proxy = MakeProxy(transport);
+
+    const auto first = proxy.Handle(Request("GET", "/assets/index.js"));
+    ASSERT_EQ(first.status, 200);
+    EXPECT_EQ(first.body, "console.log(1)");
+    EXPECT_EQ(first.header("Content-Type"), "text/javascript");
+
+    auto revalidate = Request("GET", "/assets/index.js");
+    revalidate.headers.emplace("If-None-Match", std::string(first.header("ETag")));
+    const auto second = proxy.Handle(revalidate);
+    EXPECT_EQ(second.status, 304);
+    EXPECT_TRUE(second.body.empty());
+
+    EXPECT_EQ(transport.RequestCount("GET", Url("/assets/index.js")), 1u);
+    EXPECT_EQ(proxy.GetStats().hits, 1u);
+}
+
+TEST(AssetProxy, UnreachableServerIsBadGateway) {
+    Http::FakeTransport transport;
+    transport.FailNext(2);
+    auto proxy = MakeProxy(transport);
+
+    EXPECT_EQ(proxy.Handle(Request("GET", "/config")).status, 502);
+    EXPECT_EQ(proxy.Handle(Request("PUT", "/config", "{}", "application/json")).status, 502);
+}
@@ -0,0 +1,287 @@
+// CommandJournal and the controller's saved toggles: what survives a crash, and retries while the server is up
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "FakeServer.h"
+#include "skyrimnet/CommandJournal.h"
+#include "skyrimnet/GameMasterController.h"
+
+using namespace SkyrimNetUI;
+using namespace SkyrimNetUI::Tests;
+
+namespace {
+    namespace fs = std::filesystem;
+
+    constexpr std::string_view kName = "gamemaster.enabled";
+    constexpr auto Queued = SkyrimNet::CommandJournal::QueueResult::Queued;
+
+    std::string ReadFile(const fs::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), {}};
+    }
+
+    /**
+     * @brief Config, status and commit endpoints whose state lives on disk
+     *
+     * The gamemaster flag and the Idempotency-Key of every commit it took outlast a client
+     * that is killed mid-request. Commits can also kill the client right after they are applied.
+     */
+    class DiskServer {
+    public:
+        explicit DiskServer(const fs::path& dir) : state_(dir / "server.state"), commits_(dir / "commits.log") {
+            std::ofstream(state_) << 0;
+        }
+
+        void Route(Http::FakeTransport& transport, bool killAfterCommit = false) const {
+            const auto state = state_;
+            const auto commits = commits_;
+            transport.SetRoute("GET", Url("/config?api=get&name=game"), {.handler = [state](const Http::FakeRequest&) {
+                                   const std::string value = ReadEnabled(state) ? "true" : "false";
+                                   return JsonResponse(R"({"gamemaster":{"enabled":)" + value +
+                                                       R"(,"agentEnabled":)" + value + "}}");
+                               }});
+            transport.SetRoute("GET", Url("/?api=gamemaster-status"), {.handler = [state](const Http::FakeRequest&) {
+                                   const std::string value = ReadEnabled(state) ? "true" : "false";
+                                   return JsonResponse(R"({"status":{"agent_enabled":)" + value + "}}");
+                               }});
+            transport.SetRoute("POST", Url("/config?api=update"),
+                               {.handler = [state, commits, killAfterCommit](const Http::FakeRequest& request) {
+                                   const bool enabled = request.body.find(R"("enabled":true)") != std::string::npos;
+                                   std::ofstream(state) << (enabled ? 1 : 0);
+                                   const auto key = request.headers.find("Idempotency-Key");
+                                   std::ofstream(commits, std::ios::app)
+                                       << (key != request.headers.end() ? key->second : "-") << '\n';
+                                   if (killAfterCommit) {
+                                       ::kill(::getpid(), SIGKILL);
+                                   }
+                                   return JsonResponse("{}");
+                               }});
+        }
+
+        [[nodiscard]] bool Enabled() const { return ReadEnabled(state_); }
+
+        [[nodiscard]] std::vector<std::string> Commits() const {
+            std::vector<std::string> keys;
+            std::ifstream file(commits_);
+            for (std::string key; std::getline(file, key);) {
+                keys.push_back(key);
+            }
+            return keys;
+        }
+
+    private:
+        static bool ReadEnabled(const fs::path& state) {
+            int value = 0;
+            std::ifstream(state) >> value;
+            return value == 1;
+        }
+
+        fs::path state_;
+        fs::path commits_;
+    };
+
+    /// Run body in a forked process; @return its exit code, or 128 + the signal that ended it
+    template <typename Body>
+    int InChild(Body body) {
+        const pid_t pid = ::fork();
+        if (pid == 0) {
+            ::_exit(body());
+        }
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        return WIFSIGNALED(status) ? 128 + WTERMSIG(status) : WEXITSTATUS(status);
+    }
+
+    /// A forked child only has the forking thread, so scheduler workers started earlier would be missing
+    bool SingleThreaded() {
+        return std::distance(fs::directory_iterator("/proc/self/task"), fs::directory_iterator{}) == 1;
+    }
+
+    class JournalFiles : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            dir_ = fs::temp_directory_path() /
+                   ("skyrimnet-" + std::to_string(::getpid()) + "-" +
+                    ::testing::UnitTest::GetInstance()->current_test_info()->name());
+            fs::remove_all(dir_);
+            fs::create_directories(dir_);
+        }
+
+        void TearDown() override {
+            std::error_code error;
+            fs::remove_all(dir_, error);
+        }
+
+        [[nodiscard]] const fs::path& Dir() const noexcept { return dir_; }
+        [[nodiscard]] fs::path JournalPath() const { return dir_ / "commands.journal"; }
+
+    private:
+        fs::path dir_;
+    };
+}
+
+TEST_F(JournalFiles, TogglesThatCancelOutLeaveNothingPending) {
+    {
+        SkyrimNet::CommandJournal journal(JournalPath());
+        ASSERT_EQ(journal.Queue(kName, true, false), Queued);
+        EXPECT_EQ(journal.Queue(kName, false, false), SkyrimNet::CommandJournal::QueueResult::Cancelled);
+        EXPECT_FALSE(journal.HasPending());
+
+        ASSERT_EQ(journal.Queue(kName, true, false), Queued);
+        EXPECT_EQ(journal.GetStats().collapsed, 1u);
+    }
+
+    SkyrimNet::CommandJournal reopened(JournalPath());
+    const auto pending = reopened.GetPending();
+    ASSERT_EQ(pending.size(), 1u);
+    EXPECT_TRUE(pending[0].value);
+    EXPECT_FALSE(pending[0].baseline);
+}
+
+TEST_F(JournalFiles, TornLastLineIsDroppedOnOpen) {
+    {
+        SkyrimNet::CommandJournal journal(JournalPath());
+        ASSERT_EQ(journal.Queue(kName, true, false), Queued);
+    }
+    // A crash part way through writing the next command
+    std::ofstream(JournalPath(), std::ios::app | std::ios::binary) << "Q 99-torn gamemaster.en";
+
+    SkyrimNet::CommandJournal reopened(JournalPath());
+    const auto pending = reopened.GetPending();
+    ASSERT_EQ(pending.size(), 1u);
+    EXPECT_TRUE(pending[0].value);
+    EXPECT_EQ(ReadFile(JournalPath()).find("torn"), std::string::npos);
+}
+
+TEST_F(JournalFiles, ToggleThatCantBeSavedIsReportedAsFailed) {
+    // A directory where the journal file should be, so every write fails
+    fs::create_directories(JournalPath());
+
+    Http::FakeTransport transport;
+    GameMasterServer server(transport);
+    server.SetOnline(false);
+    SkyrimNet::Controller controller(transport, FakeSettings());
+    controller.OpenJournal(JournalPath());
+
+    std::mutex mutex;
+    std::vector<SkyrimNet::GameMasterStatus> reported;
+    controller.SetStatusListener([&](SkyrimNet::GameMasterStatus status) {
+        std::lock_guard lock(mutex);
+        reported.push_back(status);
+    });
+
+    EXPECT_FALSE(controller.Toggle());
+    EXPECT_FALSE(controller.GetJournal()->HasPending());
+    EXPECT_EQ(controller.GetJournal()->GetStats().writeFailures, 1u);
+
+    // The view's pending indicator goes back to the state before the toggle
+    ASSERT_TRUE(controller.ToggleAsync());
+    ASSERT_TRUE(Eventually([&controller]() { return !controller.IsTogglePending(); }));
+    controller.Shutdown();
+    std::lock_guard lock(mutex);
+    EXPECT_EQ(reported, (std::vector{SkyrimNet::GameMasterStatus::Pending, SkyrimNet::GameMasterStatus::Disabled}));
+    EXPECT_FALSE(controller.GetJournal()->HasPending());
+}
+
+TEST_F(JournalFiles, ReplayKilledAfterTheServerAppliedItIsNotSentAgain) {
+    if (!SingleThreaded()) {
+        GTEST_SKIP() << "Forks the process; run it on its own (ctest does)";
+    }
+    const DiskServer server(Dir());
+
+    // Toggled while the server was down
+    EXPECT_EQ(InChild([this]() {
+                  Http::FakeTransport transport;
+                  GameMasterServer offline(transport);
+                  offline.SetOnline(false);
+                  SkyrimNet::Controller controller(transport, FakeSettings());
+                  controller.OpenJournal(JournalPath());
+                  const bool saved = controller.Toggle() && controller.GetJournal()->GetPending().size() == 1;
+                  controller.Shutdown();
+                  return saved ? 0 : 1;
+              }),
+              0);
+    EXPECT_TRUE(server.Commits().empty());
+
+    // Killed once the server has taken it, before the journal heard back
+    EXPECT_EQ(InChild([this, &server]() {
+                  Http::FakeTransport transport;
+                  server.Route(transport, true);
+                  SkyrimNet::Controller controller(transport, FakeSettings());
+                  controller.OpenJournal(JournalPath());
+                  controller.ReplayJournal();
+                  Eventually([&controller]() { return !controller.IsTogglePending(); });
+                  return 0;
+              }),
+              128 + SIGKILL);
+    EXPECT_TRUE(server.Enabled());
+    ASSERT_EQ(server.Commits().size(), 1u);
+
+    // Restarted: the server already reflects it, so it is only marked done
+    EXPECT_EQ(InChild([this, &server]() {
+                  Http::FakeTransport transport;
+                  server.Route(transport);
+                  SkyrimNet::Controller controller(transport, FakeSettings());
+                  controller.OpenJournal(JournalPath());
+                  if (controller.GetJournal()->GetPending().size() != 1 || !controller.ReplayJournal()) {
+                      return 1;
+                  }
+                  Eventually([&controller]() { return !controller.IsTogglePending(); });
+                  const bool done = !controller.GetJournal()->HasPending() && controller.IsEnabled();
+                  controller.Shutdown();
+                  return done ? 0 : 2;
+              }),
+              0);
+    EXPECT_EQ(server.Commits().size(), 1u);
+    EXPECT_FALSE(SkyrimNet::CommandJournal(JournalPath()).HasPending());
+}
+
+TEST_F(JournalFiles, CommitTurnedDownWhileTheServerIsUpIsRetried) {
+    Http::FakeTransport transport;
+    GameMasterServer server(transport);
+    transport.SetRoute("POST", Url("/config?api=update"), {.response = {503, {}, {}}});
+    auto settings = FakeSettings();
+    settings.backoff = {.initial = std::chrono::milliseconds(10),
+                        .max = std::chrono::milliseconds(40),
+                        .multiplier = 2.0,
+                        .jitter = 0.0};
+    SkyrimNet::Controller controller(transport, settings);
+    controller.OpenJournal(JournalPath());
+
+    std::mutex mutex;
+    std::vector<SkyrimNet::GameMasterStatus> reported;
+    controller.SetStatusListener([&](SkyrimNet::GameMasterStatus status) {
+        std::lock_guard lock(mutex);
+        reported.push_back(status);
+    });
+    const auto last = [&]() {
+        std::lock_guard lock(mutex);
+        return reported.empty() ? SkyrimNet::GameMasterStatus::Disabled : reported.back();
+    };
+
+    // Saved and retried on its own; once a retry is turned down the view stops promising it
+    ASSERT_TRUE(controller.Toggle());
+    EXPECT_TRUE(controller.GetJournal()->HasPending());
+    ASSERT_TRUE(Eventually([&]() { return transport.RequestCount("POST", Url("/config?api=update")) >= 3; }));
+    EXPECT_EQ(last(), SkyrimNet::GameMasterStatus::Pending);
+
+    // The server takes commits again: the next retry lands without another toggle
+    GameMasterServer restarted(transport, server.Enabled());
+    ASSERT_TRUE(Eventually([&]() { return !controller.GetJournal()->HasPending(); }));
+    EXPECT_TRUE(Eventually([&]() { return last() == SkyrimNet::GameMasterStatus::Enabled; }));
+    EXPECT_TRUE(restarted.Enabled());
+    EXPECT_TRUE(controller.IsEnabled());
+    controller.Shutdown();
+}
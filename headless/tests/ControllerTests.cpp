@@ -0,0 +1,285 @@
+// Controller and GameConfig against a scripted server: toggles, commits and status updates
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "FakeServer.h"
+#include "skyrimnet/GameConfig.h"
+#include "skyrimnet/GameMasterController.h"
+
+using namespace SkyrimNetUI;
+using namespace SkyrimNetUI::Tests;
+
+namespace {
+    // Callers are the game's main thread and PrismaUI callbacks; a frame is about 16 ms
+    constexpr auto kPromptly = std::chrono::milliseconds(100);
+    constexpr auto kBlocked = std::chrono::seconds(30);
+
+    template <typename Call>
+    std::chrono::steady_clock::duration Time(Call call) {
+        const auto start = std::chrono::steady_clock::now();
+        call();
+        return std::chrono::steady_clock::now() - start;
+    }
+
+    SkyrimNet::ServerSettings PatchSettings() {
+        auto settings = FakeSettings();
+        settings.patchPath = std::string(kPatchPath);
+        return settings;
+    }
+}
+
+TEST(Controller, ToggleCommitsFullDocumentAndReportsServerState) {
+    Http::FakeTransport transport;
+    GameMasterServer server(transport);
+    SkyrimNet::Controller controller(transport, FakeSettings());
+
+    std::vector<SkyrimNet::GameMasterStatus> reported;
+    controller.SetStatusListener([&reported](SkyrimNet::GameMasterStatus status) { reported.push_back(status); });
+
+    ASSERT_TRUE(controller.Toggle());
+    EXPECT_TRUE(server.Enabled());
+    EXPECT_TRUE(controller.IsEnabled());
+    EXPECT_EQ(reported, std::vector{SkyrimNet::GameMasterStatus::Enabled});
+    EXPECT_EQ(transport.RequestCount("POST", Url("/config?api=update")), 1u);
+    EXPECT_EQ(transport.RequestCount("POST", Url(kPatchPath)), 0u);
+
+    ASSERT_TRUE(controller.Toggle());
+    EXPECT_FALSE(server.Enabled());
+    EXPECT_FALSE(controller.IsEnabled());
+}
+
+TEST(Controller, ToggleFailsWithoutCommitWhenConfigIsUnreachable) {
+    Http::FakeTransport transport;
+    GameMasterServer server(transport);
+    server.SetOnline(false);
+    SkyrimNet::Controller controller(transport, FakeSettings());
+
+    EXPECT_FALSE(controller.Toggle());
+    EXPECT_FALSE(controller.IsEnabled());
+    EXPECT_EQ(transport.RequestCount("POST", Url("/config?api=update")), 0u);
+}
+
+TEST(Controller, ToggleAsyncReportsPendingThenResult) {
+    Http::FakeTransport transport;
+    GameMasterServer server(transport);
+    SkyrimNet::Controller controller(transport, FakeSettings());
+
+    std::mutex mutex;
+    std::vector<SkyrimNet::GameMasterStatus> reported;
+    controller.SetStatusListener([&](SkyrimNet::GameMasterStatus status) {
+        std::lock_guard lock(mutex);
+        reported.push_back(status);
+    });
+
+    ASSERT_TRUE(controller.ToggleAsync());
+    ASSERT_TRUE(Eventually([&controller]() { return !controller.IsTogglePending(); }));
+    controller.Shutdown();
+    std::lock_guard lock(mutex);
+    EXPECT_EQ(reported, (std::vector{SkyrimNet::GameMasterStatus::Pending, SkyrimNet::GameMasterStatus::Enabled}));
+    EXPECT_TRUE(server.Enabled());
+}
+
+TEST(Controller, ToggleAsyncReturnsWhileTheServerIsBlocked) {
+    Http::FakeTransport transport;
+    GameMasterServer server(transport);
+    transport.SetRoute("GET", Url("/config?api=get&name=game"), {.latency = kBlocked});
+    SkyrimNet::Controller controller(transport, FakeSettings());
+
+    EXPECT_LT(Time([&controller]() { EXPECT_TRUE(controller.ToggleAsync()); }), kPromptly);
+    ASSERT_TRUE(Eventually([&transport]() { return transport.RequestCount("GET", Url("/config?api=get&name=game")); }));
+    // A second toggle is turned away rather than queued behind the blocked one
+    EXPECT_LT(Time([&controller]() { EXPECT_FALSE(controller.ToggleAsync()); }), kPromptly);
+    EXPECT_TRUE(controller.IsTogglePending());
+
+    // The blocked config read is cancelled rather than waited out
+    EXPECT_LT(Time([&controller]() { controller.Shutdown(); }), kPromptly);
+    EXPECT_FALSE(server.Enabled());
+}
+
+TEST(Controller, StopPollingReturnsWhileAStatusRequestIsBlocked) {
+    Http::FakeTransport transport;
+    GameMasterServer server(transport);
+    transport.SetRoute("GET", Url("/?api=gamemaster-status"), {.latency = kBlocked});
+    SkyrimNet::Controller controller(transport, FakeSettings());
+    controller.SetPushEnabled(false);
+
+    controller.StartPolling();
+    ASSERT_TRUE(Eventually([&transport]() { return transport.RequestCount("GET", Url("/?api=gamemaster-status")); }));
+    EXPECT_LT(Time([&controller]() { controller.StopPolling(); }), kPromptly);
+    // Waiting for the poll task to finish shows the blocked request was aborted
+    EXPECT_LT(Time([&controller]() { controller.Shutdown(); }), kPromptly);
+}
+
+TEST(Controller, PollingReportsServerChanges) {
+    Http::FakeTransport transport;
+    GameMasterServer server(transport);
+    auto settings = FakeSettings();
+    settings.pollInterval = std::chrono::milliseconds(5);
+    SkyrimNet::Controller controller(transport, settings);
+    controller.SetPushEnabled(false);
+
+    controller.StartPolling();
+    server.SetEnabled(true);
+    EXPECT_TRUE(Eventually([&controller]() { return controller.IsEnabled(); }));
+    server.SetEnabled(false);
+    EXPECT_TRUE(Eventually([&controller]() { return !controller.IsEnabled(); }));
+    controller.Shutdown();
+}
+
+// A pushed status must not leave the status cache vouching for the body it replaced
+TEST(Controller, FetchAfterPushedStatusIsParsedEvenIfBodyIsUnchanged) {
+    Http::FakeTransport transport;
+    GameMasterServer server(transport);
+    // The first connection pushes "enabled" without the server's status changing, later ones stay quiet
+    auto connects = std::make_shared<std::atomic<int>>(0);
+    transport.SetRoute("STREAM", Url("/?api=gamemaster-events"), {.handler = [connects](const Http::FakeRequest&) {
+                           Http::Response stream{200, ": keep-alive\n\n", {}};
+                           if (connects->fetch_add(1) == 0) {
+                               stream.body = "event: status\ndata: {\"status\":{\"agent_enabled\":true}}\n\n";
+                           }
+                           stream.headers.emplace("Content-Type", "text/event-stream");
+                           return stream;
+                       }});
+    SkyrimNet::Controller controller(transport, FakeSettings());
+
+    controller.StartPolling();
+    ASSERT_TRUE(Eventually([&controller]() { return controller.IsEnabled(); }));
+    // The stream closed after the push; the status fetched on reconnect is the one cached before it
+    EXPECT_TRUE(Eventually([&controller]() { return !controller.IsEnabled(); }));
+    controller.Shutdown();
+}
+
+TEST(Controller, StatusPushesComeFromTheConfiguredPath) {
+    Http::FakeTransport transport;
+    GameMasterServer server(transport);
+    auto settings = FakeSettings();
+    settings.statusEventsPath = "/events/gamemaster";
+    transport.SetRoute("STREAM", Url(settings.statusEventsPath), {.handler = [](const Http::FakeRequest&) {
+                           Http::Response stream{200, "event: status\ndata: {\"status\":{\"agent_enabled\":true}}\n\n"};
+                           stream.headers.emplace("Content-Type", "text/event-stream");
+                           return stream;
+                       }});
+    SkyrimNet::Controller controller(transport, settings);
+
+    controller.StartPolling();
+    EXPECT_TRUE(Eventually([&controller]() { return controller.IsEnabled(); }));
+    controller.Shutdown();
+    EXPECT_EQ(transport.RequestCount("STREAM", Url("/?api=gamemaster-events")), 0u);
+}
+
+TEST(Controller, StatusIsPolledFromTheConfiguredPath) {
+    Http::FakeTransport transport;
+    GameMasterServer server(transport);
+    auto settings = FakeSettings();
+    settings.statusPath = "/status/gamemaster";
+    transport.SetRoute("GET", Url(settings.statusPath),
+                       {.response = JsonResponse(R"({"status":{"agent_enabled":true}})")});
+    SkyrimNet::Controller controller(transport, settings);
+    controller.SetPushEnabled(false);
+
+    controller.StartPolling();
+    EXPECT_TRUE(Eventually([&controller]() { return controller.IsEnabled(); }));
+    controller.Shutdown();
+    EXPECT_EQ(transport.RequestCount("GET", Url("/?api=gamemaster-status")), 0u);
+}
+
+TEST(GameConfig, CommitsFullDocumentByDefault) {
+    Http::FakeTransport transport;
+    GameMasterServer server(transport);
+    SkyrimNet::GameConfig config(transport, FakeSettings());
+
+    ASSERT_TRUE(config.Refresh());
+    config.SetGameMasterEnabled(true);
+    ASSERT_TRUE(config.Commit());
+    EXPECT_TRUE(server.Enabled());
+    EXPECT_FALSE(config.IsDirty());
+    EXPECT_EQ(config.GetStats().partialCommits, 0u);
+    EXPECT_EQ(transport.RequestCount("POST", Url(kPatchPath)), 0u);
+}
+
+TEST(GameConfig, ConfirmedPatchEndpointTakesLaterCommits) {
+    Http::FakeTransport transport;
+    GameMasterServer server(transport);
+    SkyrimNet::GameConfig config(transport, PatchSettings());
+
+    ASSERT_TRUE(config.Refresh());
+    for (bool enabled : {true, false, true}) {
+        config.SetGameMasterEnabled(enabled);
+        ASSERT_TRUE(config.Commit());
+        EXPECT_EQ(server.Enabled(), enabled);
+    }
+    EXPECT_EQ(config.GetStats().partialCommits, 3u);
+    EXPECT_EQ(transport.RequestCount("POST", Url("/config?api=update")), 0u);
+}
+
+// A server answering unknown api= values with 200 must not swallow toggles
+TEST(GameConfig, PatchEndpointThatIgnoresUpdatesFallsBackToFullDocument) {
+    Http::FakeTransport transport;
+    GameMasterServer server(transport);
+    transport.SetRoute("POST", Url(kPatchPath), {.response = JsonResponse("{}")});
+    SkyrimNet::GameConfig config(transport, PatchSettings());
+
+    ASSERT_TRUE(config.Refresh());
+    config.SetGameMasterEnabled(true);
+    ASSERT_TRUE(config.Commit());
+    EXPECT_TRUE(server.Enabled());
+
+    config.SetGameMasterEnabled(false);
+    ASSERT_TRUE(config.Commit());
+    EXPECT_FALSE(server.Enabled());
+    EXPECT_EQ(transport.RequestCount("POST", Url(kPatchPath)), 1u);
+    EXPECT_EQ(config.GetStats().partialCommits, 0u);
+}
+
+TEST(GameConfig, PatchEndpointErrorFallsBackToFullDocument) {
+    Http::FakeTransport transport;
+    GameMasterServer server(transport);
+    transport.SetRoute("POST", Url(kPatchPath), {.response = {500, {}, {}}});
+    SkyrimNet::GameConfig config(transport, PatchSettings());
+
+    ASSERT_TRUE(config.Refresh());
+    config.SetGameMasterEnabled(true);
+    ASSERT_TRUE(config.Commit());
+    EXPECT_TRUE(server.Enabled());
+}
+
+// Only the top-level gamemaster object is read and patched, wherever else the name appears
+TEST(GameConfig, NestedGamemasterObjectsAreLeftAlone) {
+    Http::FakeTransport transport;
+    transport.SetRoute("GET", Url("/config?api=get&name=game"),
+                       {.response = JsonResponse(R"({"profiles":{"gamemaster":{"enabled":true,"agentEnabled":true}},)"
+                                                 R"("gamemaster":{"enabled":false,"agentEnabled":false}})")});
+    transport.SetRoute("POST", Url("/config?api=update"), {.response = JsonResponse("{}")});
+    SkyrimNet::GameConfig config(transport, FakeSettings());
+
+    ASSERT_TRUE(config.Refresh());
+    ASSERT_TRUE(config.GetGameMaster().has_value());
+    EXPECT_FALSE(config.GetGameMaster()->enabled);
+
+    config.SetGameMasterEnabled(true);
+    ASSERT_TRUE(config.Commit());
+    const auto requests = transport.GetRequests();
+    ASSERT_FALSE(requests.empty());
+    EXPECT_EQ(requests.back().body, R"({"profiles":{"gamemaster":{"enabled":true,"agentEnabled":true}},)"
+                                    R"("gamemaster":{"enabled":true,"agentEnabled":true}})");
+}
+
+TEST(GameConfig, CommitSendsIdempotencyKey) {
+    Http::FakeTransport transport;
+    GameMasterServer server(transport);
+    SkyrimNet::GameConfig config(transport, FakeSettings());
+
+    ASSERT_TRUE(config.Refresh());
+    config.SetGameMasterEnabled(true);
+    ASSERT_TRUE(config.Commit(nullptr, "1-0"));
+    const auto requests = transport.GetRequests();
+    ASSERT_FALSE(requests.empty());
+    EXPECT_EQ(requests.back().method, "POST");
+    EXPECT_EQ(requests.back().headers.at("Idempotency-Key"), "1-0");
+}
@@ -0,0 +1,51 @@
+// EventFeed against a scripted server: reconnect pacing while the server is down
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "FakeServer.h"
+#include "skyrimnet/EventFeed.h"
+
+using namespace SkyrimNetUI;
+using namespace SkyrimNetUI::Tests;
+
+TEST(EventFeed, BacksOffWhileTheServerIsDownAndReconnectsWhenItIsBack) {
+    Http::FakeTransport transport;
+    transport.SetRoute("STREAM", Url("/?api=events"), {.response = {}});
+    auto settings = FakeSettings();
+    settings.backoff = {.initial = std::chrono::milliseconds(20),
+                        .max = std::chrono::seconds(5),
+                        .multiplier = 10.0,
+                        .jitter = 0.0};
+    SkyrimNet::EventFeed feed(transport, settings);
+
+    // Attempts at 0, 20 and 220 ms; the next one would be two seconds later
+    feed.Start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    const auto attempts = feed.GetStats().connects;
+    EXPECT_GE(attempts, 2u);
+    EXPECT_LE(attempts, 3u);
+
+    transport.SetRoute("STREAM", Url("/?api=events"),
+                       {.response = {200, "event: line\ndata: hello\n\n", {{"Content-Type", "text/event-stream"}}}});
+    feed.Reconnect();
+    EXPECT_TRUE(Eventually([&feed]() { return feed.GetStats().received > 0; }, std::chrono::seconds(1)));
+    feed.Shutdown();
+}
+
+TEST(EventFeed, ReconnectLeavesAnOpenStreamAlone) {
+    Http::FakeTransport transport;
+    transport.SetRoute("STREAM", Url("/?api=events"),
+                       {.response = {200, "event: line\ndata: hello\n\n", {{"Content-Type", "text/event-stream"}}},
+                        .latency = std::chrono::milliseconds(50)});
+    SkyrimNet::EventFeed feed(transport, FakeSettings());
+
+    feed.Start();
+    ASSERT_TRUE(Eventually([&feed]() { return feed.GetStats().connects > 0; }));
+    feed.Reconnect();
+    ASSERT_TRUE(Eventually([&feed]() { return feed.GetStats().received > 0; }));
+    EXPECT_EQ(feed.GetStats().connects, 1u);
+    feed.Shutdown();
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+// Scripted SkyrimNet server for the headless tests, answering through FakeTransport
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "http/FakeTransport.h"
+#include "skyrimnet/ServerSettings.h"
+
+namespace SkyrimNetUI::Tests {
+
+    inline constexpr std::string_view kBaseUrl = "http://fake.invalid";
+    inline constexpr std::string_view kPatchPath = "/config?api=patch&name=game";
+
+    inline std::string Url(std::string_view path) { return std::string(kBaseUrl).append(path); }
+
+    inline SkyrimNet::ServerSettings FakeSettings() { return {.baseUrl = std::string(kBaseUrl)}; }
+
+    inline Http::Response JsonResponse(std::string body) {
+        Http::Response response{200, std::move(body), {}};
+        response.headers.emplace("Content-Type", "application/json");
+        return response;
+    }
+
+    /// Poll condition until it holds or timeout passes
+    template <typename Condition>
+    bool Eventually(Condition condition, std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!condition()) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        return true;
+    }
+
+    /**
+     * @brief Config, status and health endpoints backed by one gamemaster flag
+     *
+     * Full updates and partial updates (at kPatchPath) set the flag from the request body;
+     * the config read and the status endpoint report it. While offline every route fails
+     * as if the connection was refused.
+     */
+    class GameMasterServer {
+    public:
+        explicit GameMasterServer(Http::FakeTransport& transport, bool enabled = false)
+            : state_(std::make_shared<State>()) {
+            state_->enabled = enabled;
+            auto state = state_;
+            transport.SetRoute("GET", Url("/config?api=get&name=game"), {.handler = [state](const Http::FakeRequest&) {
+                                   const std::string value = state->enabled ? "true" : "false";
+                                   return state->online ? JsonResponse(R"({"gamemaster":{"enabled":)" + value +
+                                                                       R"(,"agentEnabled":)" + value + "}}")
+                                                        : Http::Response{};
+                               }});
+            transport.SetRoute("GET", Url("/?api=gamemaster-status"), {.handler = [state](const Http::FakeRequest&) {
+                                   const std::string value = state->enabled ? "true" : "false";
+                                   return state->online ? JsonResponse(R"({"status":{"agent_enabled":)" + value + "}}")
+                                                        : Http::Response{};
+                               }});
+            transport.SetRoute("HEAD", Url("/config"), {.handler = [state](const Http::FakeRequest&) {
+                                   return state->online ? Http::Response{200, {}, {}} : Http::Response{};
+                               }});
+            const auto commit = [state](const Http::FakeRequest& request) {
+                if (!state->online) {
+                    return Http::Response{};
+                }
+                state->enabled = request.body.find(R"("enabled":true)") != std::string::npos;
+                return JsonResponse("{}");
+            };
+            transport.SetRoute("POST", Url("/config?api=update"), {.handler = commit});
+            transport.SetRoute("POST", Url(kPatchPath), {.handler = commit});
+        }
+
+        [[nodiscard]] bool Enabled() const noexcept { return state_->enabled; }
+        void SetEnabled(bool enabled) noexcept { state_->enabled = enabled; }
+        void SetOnline(bool online) noexcept { state_->online = online; }
+
+    private:
+        struct State {
+            std::atomic<bool> enabled{false};
+            std::atomic<bool> online{true};
+        };
+
+        std::shared_ptr<State> state_;
+    };
+
+}  // namespace SkyrimNetUI::Tests
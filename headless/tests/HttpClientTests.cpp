@@ -0,0 +1,140 @@
+// HttpClient against a loopback server: cancelling requests that are blocked on the server
+
+#include <gtest/gtest.h>
+
+#include <httplib.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "http/HttpClient.h"
+#include "http/Transport.h"
+#include "skyrimnet/GameMasterController.h"
+
+using namespace SkyrimNetUI;
+
+namespace {
+    // Far below the read timeouts, so only an aborted socket gets there
+    constexpr auto kPromptly = std::chrono::milliseconds(250);
+    constexpr Http::Timeouts kLongRead{.connect = std::chrono::seconds(2), .read = std::chrono::seconds(10)};
+
+    /**
+     * @brief Server on a loopback port that holds requests to / and /block until released
+     *
+     * /ping answers at once, to find out whether loopback sockets work here at all.
+     */
+    class LoopbackServer {
+    public:
+        LoopbackServer() {
+            server_.Get("/ping", [](const httplib::Request&, httplib::Response& res) {
+                res.set_content("{}", "application/json");
+            });
+            const auto block = [this](const httplib::Request&, httplib::Response& res) {
+                std::unique_lock lock(mutex_);
+                ++blocked_;
+                changed_.notify_all();
+                changed_.wait_for(lock, std::chrono::seconds(20), [this]() { return released_; });
+                res.set_content(R"({"status":{"agent_enabled":false}})", "application/json");
+            };
+            server_.Get("/", block);
+            server_.Get("/block", block);
+            port_ = server_.bind_to_any_port("127.0.0.1");
+            listener_ = std::thread([this]() { server_.listen_after_bind(); });
+            server_.wait_until_ready();
+        }
+
+        ~LoopbackServer() {
+            Release();
+            server_.stop();
+            listener_.join();
+        }
+
+        LoopbackServer(const LoopbackServer&) = delete;
+        LoopbackServer& operator=(const LoopbackServer&) = delete;
+
+        [[nodiscard]] std::string Url(std::string_view path = {}) const {
+            return "http://127.0.0.1:" + std::to_string(port_) + std::string(path);
+        }
+
+        [[nodiscard]] bool Reachable() const { return Http::Get(Url("/ping")).ok(); }
+
+        /// @return true once count requests have reached a blocking route
+        bool WaitForBlocked(int count) {
+            std::unique_lock lock(mutex_);
+            return changed_.wait_for(lock, std::chrono::seconds(5), [this, count]() { return blocked_ >= count; });
+        }
+
+        void Release() {
+            std::lock_guard lock(mutex_);
+            released_ = true;
+            changed_.notify_all();
+        }
+
+    private:
+        httplib::Server server_;
+        std::thread listener_;
+        int port_ = 0;
+        std::mutex mutex_;
+        std::condition_variable changed_;
+        int blocked_ = 0;
+        bool released_ = false;
+    };
+}
+
+TEST(CancelToken, AbortsEveryRequestBoundToIt) {
+    LoopbackServer server;
+    if (!server.Reachable()) {
+        GTEST_SKIP() << "No loopback server in this build";
+    }
+
+    Http::CancelToken cancel;
+    std::vector<Http::Response> responses(2);
+    std::vector<std::thread> requests;
+    for (auto& response : responses) {
+        requests.emplace_back([&server, &cancel, &response]() {
+            response = Http::Get(server.Url("/block"), {.cancel = &cancel, .timeouts = kLongRead});
+        });
+    }
+    ASSERT_TRUE(server.WaitForBlocked(2));
+
+    const auto start = std::chrono::steady_clock::now();
+    cancel.Cancel();
+    for (auto& request : requests) {
+        request.join();
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, kPromptly);
+    for (const auto& response : responses) {
+        EXPECT_EQ(response.status, 0);
+    }
+
+    // Still cancelled: the next request doesn't reach the server
+    EXPECT_EQ(Http::Get(server.Url("/ping"), {.cancel = &cancel}).status, 0);
+    cancel.Reset();
+    EXPECT_TRUE(Http::Get(server.Url("/ping"), {.cancel = &cancel}).ok());
+}
+
+TEST(CancelToken, StopPollingAbortsABlockedStatusRequest) {
+    LoopbackServer server;
+    if (!server.Reachable()) {
+        GTEST_SKIP() << "No loopback server in this build";
+    }
+
+    Http::HttplibTransport transport;
+    SkyrimNet::ServerSettings settings{.baseUrl = server.Url()};
+    settings.statusTimeouts = kLongRead;
+    SkyrimNet::Controller controller(transport, settings);
+    controller.SetPushEnabled(false);
+
+    controller.StartPolling();
+    ASSERT_TRUE(server.WaitForBlocked(1));
+
+    const auto start = std::chrono::steady_clock::now();
+    controller.StopPolling();
+    // Returns once the poll task has finished, which the blocked read would hold up
+    controller.Shutdown();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, kPromptly);
+}
@@ -0,0 +1,149 @@
+// InteropDispatcher against a recording PrismaUI: what is held, coalesced, dropped and sent
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "PrismaUI_API.h"
+#include "ui/InteropDispatcher.h"
+
+using namespace SkyrimNetUI;
+
+namespace {
+    /// PrismaUI stand-in that records every Invoke script; every view is valid
+    class RecordingPrismaUI final : public PRISMA_UI_API::IVPrismaUI1 {
+    public:
+        std::vector<std::pair<PrismaView, std::string>> invokes;
+
+        void Invoke(PrismaView view, const char* script, PRISMA_UI_API::JSCallback) noexcept override {
+            invokes.emplace_back(view, script);
+        }
+
+        PrismaView CreateView(const char*, PRISMA_UI_API::OnDomReadyCallback) noexcept override { return 0; }
+        void InteropCall(PrismaView, const char*, const char*) noexcept override {}
+        void RegisterJSListener(PrismaView, const char*, PRISMA_UI_API::JSListenerCallback) noexcept override {}
+        bool HasFocus(PrismaView) noexcept override { return false; }
+        bool Focus(PrismaView, bool, bool) noexcept override { return true; }
+        void Unfocus(PrismaView) noexcept override {}
+        void Show(PrismaView) noexcept override {}
+        void Hide(PrismaView) noexcept override {}
+        bool IsHidden(PrismaView) noexcept override { return false; }
+        int GetScrollingPixelSize(PrismaView) noexcept override { return 0; }
+        void SetScrollingPixelSize(PrismaView, int) noexcept override {}
+        bool IsValid(PrismaView) noexcept override { return true; }
+        void Destroy(PrismaView) noexcept override {}
+        void SetOrder(PrismaView, int) noexcept override {}
+        int GetOrder(PrismaView) noexcept override { return 0; }
+        void CreateInspectorView(PrismaView) noexcept override {}
+        void SetInspectorVisibility(PrismaView, bool) noexcept override {}
+        bool IsInspectorVisible(PrismaView) noexcept override { return false; }
+        void SetInspectorBounds(PrismaView, float, float, unsigned int, unsigned int) noexcept override {}
+        bool HasAnyActiveFocus() noexcept override { return false; }
+    };
+
+    /// Flushes wait for RunFrame, as they wait for the next game frame in the plugin
+    class Frames {
+    public:
+        UI::InteropDispatcher::FlushScheduler Scheduler() {
+            return [this](std::function<void()> task) { tasks_.push_back(std::move(task)); };
+        }
+
+        void Run() {
+            auto tasks = std::exchange(tasks_, {});
+            for (auto& task : tasks) {
+                task();
+            }
+        }
+
+    private:
+        std::vector<std::function<void()>> tasks_;
+    };
+
+    constexpr PrismaView kView = 7;
+}
+
+TEST(InteropDispatcher, CallsAreHeldUntilTheDomIsReady) {
+    RecordingPrismaUI api;
+    Frames frames;
+    UI::InteropDispatcher dispatcher(frames.Scheduler());
+    dispatcher.Attach(&api, kView);
+
+    dispatcher.Queue("setServerUrl", "http://localhost:8080");
+    dispatcher.Queue("toggleSkyrimNetUIDiv", "show");
+    frames.Run();
+    EXPECT_EQ(dispatcher.Flush(), 0u);
+    EXPECT_TRUE(api.invokes.empty());
+
+    dispatcher.MarkDomReady();
+    frames.Run();
+    ASSERT_EQ(api.invokes.size(), 1u);
+    EXPECT_EQ(api.invokes[0].first, kView);
+    EXPECT_NE(api.invokes[0].second.find(R"(setServerUrl("http://localhost:8080"))"), std::string::npos);
+    EXPECT_NE(api.invokes[0].second.find(R"(toggleSkyrimNetUIDiv("show"))"), std::string::npos);
+
+    const auto stats = dispatcher.GetStats();
+    EXPECT_EQ(stats.queued, 2u);
+    EXPECT_EQ(stats.issued, 2u);
+    EXPECT_EQ(stats.invokes, 1u);
+}
+
+TEST(InteropDispatcher, RepeatedCallsAreCoalescedAndShownValuesDropped) {
+    RecordingPrismaUI api;
+    Frames frames;
+    UI::InteropDispatcher dispatcher(frames.Scheduler());
+    dispatcher.Attach(&api, kView);
+    dispatcher.MarkDomReady();
+
+    // Only the latest argument of a pending call is sent
+    dispatcher.Queue("updateGameMasterStatus", "pending");
+    dispatcher.Queue("updateGameMasterStatus", "true");
+    frames.Run();
+    ASSERT_EQ(api.invokes.size(), 1u);
+    EXPECT_EQ(api.invokes[0].second.find("pending"), std::string::npos);
+    EXPECT_NE(api.invokes[0].second.find(R"(updateGameMasterStatus("true"))"), std::string::npos);
+
+    // Already shown: nothing to send
+    dispatcher.Queue("updateGameMasterStatus", "true");
+    // Undone before the flush: the pending call is dropped too
+    dispatcher.Queue("updateGameMasterStatus", "pending");
+    dispatcher.Queue("updateGameMasterStatus", "true");
+    frames.Run();
+    EXPECT_EQ(api.invokes.size(), 1u);
+
+    const auto stats = dispatcher.GetStats();
+    EXPECT_EQ(stats.queued, 5u);
+    EXPECT_EQ(stats.coalesced, 2u);
+    EXPECT_EQ(stats.dropped, 2u);
+    EXPECT_EQ(stats.issued, 1u);
+    EXPECT_EQ(stats.invokes, 1u);
+}
+
+TEST(InteropDispatcher, ANewViewIsHeldUntilItsOwnDomIsReady) {
+    RecordingPrismaUI api;
+    Frames frames;
+    UI::InteropDispatcher dispatcher(frames.Scheduler());
+    dispatcher.Attach(&api, kView);
+    dispatcher.MarkDomReady();
+    dispatcher.Queue("setPanels", "metrics");
+    frames.Run();
+    ASSERT_EQ(api.invokes.size(), 1u);
+
+    // The value the old view showed is sent again, once the new page can take it
+    dispatcher.Attach(&api, kView + 1);
+    dispatcher.Queue("setPanels", "metrics");
+    frames.Run();
+    EXPECT_EQ(api.invokes.size(), 1u);
+
+    dispatcher.MarkDomReady();
+    frames.Run();
+    ASSERT_EQ(api.invokes.size(), 2u);
+    EXPECT_EQ(api.invokes[1].first, kView + 1);
+
+    const auto stats = dispatcher.GetStats();
+    EXPECT_EQ(stats.dropped, 0u);
+    EXPECT_EQ(stats.issued, 2u);
+    EXPECT_EQ(stats.invokes, 2u);
+}
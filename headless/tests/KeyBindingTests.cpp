@@ -0,0 +1,169 @@
+// KeyHandler against replayed keyboard input: which bindings fire, and what each event costs
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "keyhandler/KeyBinding.h"
+#include "keyhandler/keyhandler.h"
+
+using namespace SkyrimNetUI;
+
+namespace {
+    constexpr uint32_t kF4 = 0x3E;
+    constexpr uint32_t kLeftShift = 0x2A;
+    constexpr uint32_t kLeftCtrl = 0x1D;
+    constexpr uint32_t kLeftAlt = 0x38;
+
+    /// Builds keyboard input the way the game reports it and sends it through the input source
+    class Replay {
+    public:
+        Replay& Down(uint32_t key) { return Add(key, 1.0f, 0.0f); }
+        Replay& Held(uint32_t key, float seconds) { return Add(key, 1.0f, seconds); }
+        Replay& Up(uint32_t key, float seconds = 0.1f) { return Add(key, 0.0f, seconds); }
+
+        /// Send every event added so far, one per frame, and start over
+        void Play() {
+            auto* source = RE::BSInputDeviceManager::GetSingleton();
+            for (auto& event : events_) {
+                RE::InputEvent* list = &event;
+                source->SendEvent(&list);
+            }
+            events_.clear();
+        }
+
+    private:
+        Replay& Add(uint32_t key, float value, float held) {
+            auto& event = events_.emplace_back();
+            event.idCode = key;
+            event.value = value;
+            event.heldDownSecs = held;
+            return *this;
+        }
+
+        std::deque<RE::ButtonEvent> events_;
+    };
+
+    class KeyReplay : public ::testing::Test {
+    protected:
+        static void SetUpTestSuite() { KeyHandler::RegisterSink(); }
+
+        void SetUp() override {
+            // Keys left down by the previous test
+            KeyHandler::GetSingleton()->ResetKeyStates();
+        }
+
+        void TearDown() override {
+            for (auto handle : handles_) {
+                KeyHandler::GetSingleton()->Unregister(handle);
+            }
+        }
+
+        /// Register a binding from its settings text; returns the number of times it has fired
+        const int& Bind(std::string_view text) {
+            const auto binding = ParseKeyBinding(text);
+            EXPECT_TRUE(binding.has_value()) << text;
+            auto& fired = counts_.emplace_back(0);
+            handles_.push_back(KeyHandler::GetSingleton()->Register(binding.value_or(KeyBinding{}),
+                                                                    [&fired]() { ++fired; }));
+            return fired;
+        }
+
+        Replay input;
+
+    private:
+        std::deque<int> counts_;
+        std::vector<KeyHandlerEvent> handles_;
+    };
+}
+
+TEST(KeyBinding, BareKeyMatchesAnyModifiers) {
+    EXPECT_EQ(ParseKeyBinding("F4")->modifiers, kModifierAny);
+    EXPECT_EQ(ParseKeyBinding("F4:Hold=0.75")->modifiers, kModifierAny);
+    EXPECT_EQ(ParseKeyBinding("Ctrl+F4")->modifiers, kModifierCtrl);
+    EXPECT_EQ(ParseKeyBinding("Shift+Ctrl+F4")->modifiers, kModifierShift | kModifierCtrl);
+}
+
+TEST_F(KeyReplay, BareKeyFiresWhileModifiersAreHeld) {
+    const auto& toggled = Bind("F4");
+
+    input.Down(kF4).Up(kF4).Play();
+    input.Down(kLeftAlt).Down(kF4).Up(kF4).Up(kLeftAlt).Play();
+    input.Down(kLeftShift).Down(kLeftCtrl).Down(kF4).Up(kF4).Up(kLeftCtrl).Up(kLeftShift).Play();
+
+    EXPECT_EQ(toggled, 3);
+}
+
+TEST_F(KeyReplay, ChordsMatchTheirModifiersExactly) {
+    const auto& chord = Bind("Ctrl+F4");
+
+    input.Down(kF4).Up(kF4).Play();
+    EXPECT_EQ(chord, 0);
+    input.Down(kLeftCtrl).Down(kF4).Up(kF4).Play();
+    EXPECT_EQ(chord, 1);
+    input.Down(kLeftShift).Down(kF4).Up(kF4).Up(kLeftShift).Up(kLeftCtrl).Play();
+    EXPECT_EQ(chord, 1);
+}
+
+TEST_F(KeyReplay, HoldFiresOnceWhenItsThresholdIsCrossed) {
+    const auto& held = Bind("F4:Hold=0.5");
+
+    input.Down(kF4).Held(kF4, 0.2f).Held(kF4, 0.4f).Up(kF4, 0.45f).Play();
+    EXPECT_EQ(held, 0);
+    input.Down(kF4).Held(kF4, 0.3f).Held(kF4, 0.6f).Held(kF4, 0.9f).Up(kF4, 1.0f).Play();
+    EXPECT_EQ(held, 1);
+}
+
+TEST_F(KeyReplay, DoubleTapNeedsTwoPressesInsideTheWindow) {
+    const auto& doubled = Bind("F4:DoubleTap");
+
+    input.Down(kF4).Up(kF4).Down(kF4).Up(kF4).Play();
+    EXPECT_EQ(doubled, 1);
+    // The third press starts a new pair
+    input.Down(kF4).Up(kF4).Play();
+    EXPECT_EQ(doubled, 1);
+}
+
+TEST_F(KeyReplay, ResetForgetsKeyUpsThatWentElsewhere) {
+    const auto& chord = Bind("Ctrl+F4");
+    const auto& toggled = Bind("F4");
+
+    // Ctrl goes down in game and comes up while another window has focus
+    input.Down(kLeftCtrl).Play();
+    KeyHandler::GetSingleton()->ResetKeyStates();
+    input.Down(kF4).Up(kF4).Play();
+
+    EXPECT_EQ(chord, 0);
+    EXPECT_EQ(toggled, 1);
+}
+
+TEST_F(KeyReplay, PerEventCostStaysSmall) {
+    constexpr int kRounds = 2000;
+    const auto& toggled = Bind("F4");
+    const auto& chord = Bind("Ctrl+F4");
+    Bind("F4:Hold=0.5");
+    Bind("F4:DoubleTap");
+    // Unrelated bindings, as other plugins' keys would be
+    for (char letter = 'A'; letter <= 'Z'; ++letter) {
+        Bind(std::string("Shift+") + letter);
+        Bind(std::string(1, letter) + ":Up");
+    }
+
+    for (int i = 0; i < kRounds; ++i) {
+        input.Down(kLeftCtrl).Down(kF4).Held(kF4, 0.6f).Up(kF4, 0.7f).Up(kLeftCtrl);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    input.Play();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(toggled, kRounds);
+    EXPECT_EQ(chord, kRounds);
+
+    const auto perEvent = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed) / (kRounds * 5);
+    RecordProperty("nanoseconds_per_event", static_cast<int>(perEvent.count()));
+    // Input runs once per frame; a generous bound that still catches a per-event allocation or lock storm
+    EXPECT_LT(perEvent, std::chrono::microseconds(20));
+}
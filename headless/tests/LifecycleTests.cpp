@@ -0,0 +1,78 @@
+// Background services managed by the lifecycle manager
+
+#include <gtest/gtest.h>
+
+#include "FakeServer.h"
+#include "lifecycle/Lifecycle.h"
+#include "skyrimnet/GameMasterController.h"
+#include "skyrimnet/HealthMonitor.h"
+
+using namespace SkyrimNetUI;
+using namespace SkyrimNetUI::Tests;
+
+TEST(Lifecycle, NothingReachesTheServerWhileSuspended) {
+    Http::FakeTransport transport;
+    GameMasterServer server(transport);
+
+    // Short intervals so that work leaking past a suspend shows up within the check below
+    auto settings = FakeSettings();
+    settings.pollInterval = std::chrono::milliseconds(1);
+    settings.monitorUpInterval = std::chrono::milliseconds(1);
+    settings.monitorDownInterval = std::chrono::milliseconds(1);
+    SkyrimNet::Controller controller(transport, settings);
+    controller.SetPushEnabled(false);
+    SkyrimNet::HealthMonitor monitor(transport, settings);
+
+    Lifecycle::Manager lifecycle;
+    lifecycle.Register(
+        "polling", Lifecycle::kAllReasons, [&controller]() { controller.StartPolling(); },
+        [&controller]() { controller.StopPolling(); });
+    lifecycle.Register(
+        "health", Lifecycle::kAllReasons, [&monitor]() { monitor.Start(); }, [&monitor]() { monitor.Stop(); });
+
+    for (int i = 0; i < 5; ++i) {
+        const size_t before = transport.GetRequests().size();
+        lifecycle.Resume(Lifecycle::Reason::ViewHidden);
+        ASSERT_TRUE(Eventually([&]() { return transport.GetRequests().size() > before + 2; }));
+        lifecycle.Suspend(Lifecycle::Reason::ViewHidden);
+    }
+
+    // Loading on top of a hidden view, then the view opened during the load: all still suspended
+    lifecycle.Suspend(Lifecycle::Reason::Loading);
+    lifecycle.Resume(Lifecycle::Reason::ViewHidden);
+    EXPECT_FALSE(lifecycle.IsRunning("polling"));
+    EXPECT_FALSE(lifecycle.IsRunning("health"));
+
+    const size_t before = transport.GetRequests().size();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(transport.GetRequests().size(), before);
+
+    lifecycle.Resume(Lifecycle::Reason::Loading);
+    EXPECT_TRUE(Eventually([&]() { return transport.GetRequests().size() > before; }));
+    lifecycle.UnregisterAll();
+    controller.Shutdown();
+    monitor.Shutdown();
+}
+
+TEST(Lifecycle, ASaveLoadAndTheLoadingScreenEachHoldServicesOnTheirOwn) {
+    Lifecycle::Manager lifecycle(0);
+    lifecycle.Register("feed", Lifecycle::kLoadingReasons, []() {}, []() {});
+
+    // The save reports loaded while its loading screen is still up
+    lifecycle.Suspend(Lifecycle::Reason::Loading);
+    lifecycle.Suspend(Lifecycle::Reason::LoadingScreen);
+    lifecycle.Resume(Lifecycle::Reason::Loading);
+    EXPECT_FALSE(lifecycle.IsRunning("feed"));
+    lifecycle.Resume(Lifecycle::Reason::LoadingScreen);
+    EXPECT_TRUE(lifecycle.IsRunning("feed"));
+
+    // The loading screen closes before the save has finished loading
+    lifecycle.Suspend(Lifecycle::Reason::LoadingScreen);
+    lifecycle.Suspend(Lifecycle::Reason::Loading);
+    lifecycle.Resume(Lifecycle::Reason::LoadingScreen);
+    EXPECT_FALSE(lifecycle.IsRunning("feed"));
+    EXPECT_TRUE(lifecycle.IsAnyActive(Lifecycle::kLoadingReasons));
+    lifecycle.Resume(Lifecycle::Reason::Loading);
+    EXPECT_TRUE(lifecycle.IsRunning("feed"));
+    EXPECT_FALSE(lifecycle.IsAnyActive(Lifecycle::kLoadingReasons));
+}
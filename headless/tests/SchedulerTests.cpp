@@ -0,0 +1,214 @@
+// TaskScheduler: lane ordering, delays, cancellation and the stream lane
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FakeServer.h"
+#include "scheduler/TaskScheduler.h"
+
+using namespace SkyrimNetUI;
+using namespace SkyrimNetUI::Tests;
+
+namespace {
+    using Scheduler::Lane;
+
+    constexpr auto kPromptly = std::chrono::milliseconds(100);
+
+    /// Holds the tasks waiting on it until opened, and tells the test when they got there
+    class Gate {
+    public:
+        void Wait() {
+            std::unique_lock lock(mutex_);
+            ++waiting_;
+            changed_.notify_all();
+            changed_.wait(lock, [this]() { return open_; });
+        }
+
+        void Open() {
+            std::lock_guard lock(mutex_);
+            open_ = true;
+            changed_.notify_all();
+        }
+
+        /// @return true once count tasks are waiting (or have waited) on the gate
+        bool Reached(int count) {
+            std::unique_lock lock(mutex_);
+            return changed_.wait_for(lock, std::chrono::seconds(5), [this, count]() { return waiting_ >= count; });
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable changed_;
+        int waiting_ = 0;
+        bool open_ = false;
+    };
+
+    /// Names of tasks in the order they started
+    class RunLog {
+    public:
+        Scheduler::Task Record(std::string name) {
+            return [this, name = std::move(name)]() {
+                std::lock_guard lock(mutex_);
+                runs_.push_back(name);
+            };
+        }
+
+        [[nodiscard]] std::vector<std::string> Runs() const {
+            std::lock_guard lock(mutex_);
+            return runs_;
+        }
+
+        [[nodiscard]] size_t Count() const { return Runs().size(); }
+
+    private:
+        mutable std::mutex mutex_;
+        std::vector<std::string> runs_;
+    };
+}
+
+TEST(Scheduler, QueuedUiTasksRunAheadOfBackgroundOnesInPostOrder) {
+    // Worker 0 only runs the UI lane, worker 1 both
+    Scheduler::TaskScheduler scheduler(2, 1);
+    Gate uiWorker;
+    Gate sharedWorker;
+    // Background first: only the shared worker can take it, which leaves the UI task to worker 0
+    scheduler.Post(Lane::Background, [&sharedWorker]() { sharedWorker.Wait(); });
+    ASSERT_TRUE(sharedWorker.Reached(1));
+    scheduler.Post(Lane::UI, [&uiWorker]() { uiWorker.Wait(); });
+    ASSERT_TRUE(uiWorker.Reached(1));
+
+    RunLog log;
+    scheduler.Post(Lane::Background, log.Record("background 1"));
+    scheduler.Post(Lane::Background, log.Record("background 2"));
+    scheduler.Post(Lane::UI, log.Record("ui 1"));
+    scheduler.Post(Lane::UI, log.Record("ui 2"));
+
+    // Only the shared worker is free, so it alone decides the order
+    sharedWorker.Open();
+    ASSERT_TRUE(Eventually([&log]() { return log.Count() == 4; }));
+    EXPECT_EQ(log.Runs(), (std::vector<std::string>{"ui 1", "ui 2", "background 1", "background 2"}));
+    uiWorker.Open();
+}
+
+TEST(Scheduler, UiTasksAreNotHeldUpByABlockedBackgroundTask) {
+    Scheduler::TaskScheduler scheduler(2, 1);
+    Gate background;
+    scheduler.Post(Lane::Background, [&background]() { background.Wait(); });
+    ASSERT_TRUE(background.Reached(1));
+
+    std::atomic<bool> ran{false};
+    scheduler.Post(Lane::UI, [&ran]() { ran = true; });
+    EXPECT_TRUE(Eventually([&ran]() { return ran.load(); }, kPromptly));
+    background.Open();
+}
+
+TEST(Scheduler, PostDelayedWaitsForItsDelay) {
+    Scheduler::TaskScheduler scheduler(2, 1);
+    constexpr auto kDelay = std::chrono::milliseconds(50);
+
+    RunLog log;
+    const auto posted = Scheduler::Clock::now();
+    std::atomic<Scheduler::Clock::time_point> ranAt{};
+    scheduler.PostDelayed(Lane::Background, kDelay, [&]() {
+        ranAt = Scheduler::Clock::now();
+        log.Record("delayed")();
+    });
+    scheduler.Post(Lane::Background, log.Record("immediate"));
+
+    ASSERT_TRUE(Eventually([&log]() { return log.Count() == 2; }));
+    EXPECT_GE(ranAt.load() - posted, kDelay);
+    EXPECT_EQ(log.Runs(), (std::vector<std::string>{"immediate", "delayed"}));
+}
+
+TEST(Scheduler, CancelledTasksDontRun) {
+    Scheduler::TaskScheduler scheduler(2, 1);
+    std::atomic<int> delayedRuns{0};
+    std::atomic<int> periodicRuns{0};
+
+    auto delayed = scheduler.PostDelayed(Lane::Background, std::chrono::milliseconds(20), [&]() { ++delayedRuns; });
+    EXPECT_TRUE(delayed.IsActive());
+    delayed.Cancel();
+    EXPECT_FALSE(delayed.IsActive());
+
+    auto periodic = scheduler.PostPeriodic(Lane::Background, std::chrono::milliseconds(1), [&]() { ++periodicRuns; });
+    ASSERT_TRUE(Eventually([&]() { return periodicRuns.load() >= 3; }));
+    periodic.CancelAndWait();
+    const int runs = periodicRuns.load();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(delayedRuns.load(), 0);
+    EXPECT_EQ(periodicRuns.load(), runs);
+}
+
+TEST(Scheduler, CancelAndWaitReturnsOnceTheRunningTaskHasFinished) {
+    Scheduler::TaskScheduler scheduler(2, 1);
+    Gate started;
+    std::atomic<bool> finished{false};
+    auto task = scheduler.Post(Lane::Background, [&]() {
+        started.Open();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        finished = true;
+    });
+
+    started.Wait();
+    task.CancelAndWait();
+    EXPECT_TRUE(finished.load());
+    EXPECT_FALSE(task.IsActive());
+}
+
+TEST(Scheduler, CancelAndWaitFromInsideTheTaskDoesntDeadlock) {
+    Scheduler::TaskScheduler scheduler(2, 1);
+    Scheduler::TaskHandle self;
+    std::mutex mutex;
+    std::atomic<bool> returned{false};
+    {
+        // Held until the handle is stored, so the task sees its own handle
+        std::lock_guard lock(mutex);
+        self = scheduler.Post(Lane::Background, [&]() {
+            Scheduler::TaskHandle handle;
+            {
+                std::lock_guard taskLock(mutex);
+                handle = self;
+            }
+            handle.CancelAndWait();
+            returned = true;
+        });
+    }
+    EXPECT_TRUE(Eventually([&returned]() { return returned.load(); }));
+}
+
+TEST(Scheduler, StreamTasksDontTakeBackgroundWorkers) {
+    // One shared worker and one stream worker: a stream on the shared worker would stall everything else
+    Scheduler::TaskScheduler scheduler(2, 1);
+    Gate stream;
+    scheduler.Post(Lane::Stream, [&stream]() { stream.Wait(); });
+    ASSERT_TRUE(stream.Reached(1));
+
+    RunLog log;
+    for (int i = 0; i < 3; ++i) {
+        scheduler.Post(Lane::Background, log.Record("background"));
+        scheduler.PostDelayed(Lane::Background, std::chrono::milliseconds(5), log.Record("delayed"));
+    }
+    EXPECT_TRUE(Eventually([&log]() { return log.Count() == 6; }, kPromptly));
+
+    // A second stream waits for the stream worker rather than borrowing another
+    std::atomic<bool> secondStream{false};
+    scheduler.Post(Lane::Stream, [&secondStream]() { secondStream = true; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(secondStream.load());
+
+    stream.Open();
+    ASSERT_TRUE(Eventually([&secondStream]() { return secondStream.load(); }));
+
+    const auto stats = scheduler.GetStats();
+    EXPECT_EQ(stats.threadsCreated, 3u);
+    EXPECT_EQ(stats.streamTasksRun, 2u);
+    EXPECT_EQ(stats.backgroundTasksRun, 6u);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace SkyrimNetUI::Config {
+
+    /// Location of the plugin's settings file, relative to the game directory
+    inline constexpr const char* kSettingsPath = "Data/SKSE/Plugins/PrismaUI-SkyrimNet-UI.ini";
+
+    /**
+     * @brief Case-insensitive ordering for section and key names
+     */
+    struct NameLess {
+        using is_transparent = void;
+        bool operator()(std::string_view lhs, std::string_view rhs) const noexcept;
+    };
+
+    /**
+     * @brief Minimal INI reader
+     * Supports [sections], key = value pairs, and ; or # comment lines. Names are
+     * case-insensitive; values are trimmed and may be wrapped in double quotes.
+     */
+    class IniFile {
+    public:
+        using Entries = std::vector<std::pair<std::string, std::string>>;
+
+        /// @return nullopt if the file can't be read
+        static std::optional<IniFile> Load(const std::filesystem::path& path);
+
+        static IniFile Parse(std::string_view text);
+
+        /// @return Last value of key in section, if present
+        std::optional<std::string_view> Get(std::string_view section, std::string_view key) const;
+
+        /// @return Entries of a section in file order (empty if the section is missing)
+        const Entries& Section(std::string_view section) const;
+
+        // Typed lookups; a missing or malformed value yields fallback
+        bool GetBool(std::string_view section, std::string_view key, bool fallback) const;
+        int64_t GetInt(std::string_view section, std::string_view key, int64_t fallback) const;
+        double GetFloat(std::string_view section, std::string_view key, double fallback) const;
+
+    private:
+        std::map<std::string, Entries, NameLess> sections_;
+    };
+
+    /**
+     * @brief Plugin settings, read from kSettingsPath on first use
+     * A missing file yields empty settings so every consumer falls back to its defaults.
+     */
+    const IniFile& GetSettings();
+
+}  // namespace SkyrimNetUI::Config
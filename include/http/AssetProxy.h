@@ -0,0 +1,121 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "http/Transport.h"
+
+namespace SkyrimNetUI::Http {
+
+    /**
+     * @brief Request received by the local proxy, as sent by the view
+     */
+    struct ProxyRequest {
+        std::string method;  ///< Any method; only GET and HEAD of assets are cached
+        std::string target;  ///< Path and query, e.g. /assets/index.js
+        Headers headers;
+        std::string body;
+    };
+
+    /**
+     * @brief Caching front for the SkyrimNet web UI
+     *
+     * Static assets (scripts, styles, images, fonts) are kept in memory after the first
+     * fetch and answered with a content-hash ETag and a Cache-Control max age, so the view
+     * either keeps them itself or revalidates with a bodyless 304. Past the max age an
+     * entry is revalidated upstream (conditionally when the server sent validators) and is
+     * still served if the server can't be reached. Pages and API calls pass through with
+     * their method, body and Content-Type as sent. WebSocket upgrades can't be relayed and
+     * are refused with a 501, so a web UI that needs them should be loaded without the proxy.
+     *
+     * Safe to call from several threads at once. ProxyServer puts this on a loopback port.
+     */
+    class AssetProxy {
+    public:
+        struct Settings {
+            std::string upstream{kDefaultBaseUrl};                  ///< Server root without a trailing slash
+            std::chrono::seconds maxAge{std::chrono::minutes(10)};  ///< Freshness of assets, here and in the view
+            size_t maxBytes = 32 << 20;                             ///< Cached bodies beyond this evict the oldest
+            Timeouts timeouts{std::chrono::seconds(2), std::chrono::seconds(15)};
+            Timeouts streamTimeouts{std::chrono::seconds(2), std::chrono::seconds(60)};  ///< Longest gap between events
+        };
+
+        struct Stats {
+            uint64_t requests = 0;       ///< Requests handled
+            uint64_t passedThrough = 0;  ///< Pages and API calls forwarded uncached
+            uint64_t streams = 0;        ///< Event streams relayed
+            uint64_t hits = 0;           ///< Assets answered from memory
+            uint64_t notModified = 0;    ///< Hits answered with a 304 because the view had the same hash
+            uint64_t fetched = 0;        ///< Asset bodies downloaded
+            uint64_t revalidated = 0;    ///< Stale assets the server confirmed unchanged
+            uint64_t upstreamBytes = 0;  ///< Body bytes received from the server
+            uint64_t servedBytes = 0;    ///< Body bytes sent to the view
+            size_t cachedBytes = 0;
+            size_t entries = 0;
+        };
+
+        AssetProxy(Transport& upstream, Settings settings);
+
+        AssetProxy(const AssetProxy&) = delete;
+        AssetProxy& operator=(const AssetProxy&) = delete;
+
+        /**
+         * @brief Answer a request from the view
+         * Connection failures come back as 502, WebSocket upgrades as 501. Event streams must go
+         * through Stream instead.
+         */
+        Response Handle(const ProxyRequest& request);
+
+        /// @return Whether the view asked for server-sent events
+        static bool WantsEventStream(const ProxyRequest& request);
+
+        /**
+         * @brief Relay an event stream from the server chunk by chunk
+         */
+        StreamResult Stream(const ProxyRequest& request, const ChunkHandler& onChunk, CancelToken* cancel);
+
+        /// @return Whether target names a static asset by its file extension
+        static bool IsAsset(std::string_view target);
+
+        /// Drop cached assets
+        void Clear();
+
+        [[nodiscard]] Stats GetStats() const;
+
+        [[nodiscard]] const Settings& GetSettings() const noexcept { return settings_; }
+
+    private:
+        struct Entry {
+            std::string body;
+            std::string contentType;
+            std::string etag;          ///< Quoted content hash sent to the view
+            std::string upstreamEtag;  ///< Validators from the server, for revalidation
+            std::string lastModified;
+            std::chrono::steady_clock::time_point fetched;
+            uint64_t lastUsed = 0;
+        };
+
+        Response PassThrough(const ProxyRequest& request);
+        Response ServeAsset(const ProxyRequest& request);
+        void CountHitLocked();
+        Response FromEntryLocked(Entry& entry, const ProxyRequest& request);
+        /// Takes entry unless it exceeds maxBytes on its own; @return The cached entry, or nullptr
+        Entry* StoreLocked(const std::string& target, Entry& entry);
+
+        Transport& upstream_;
+        const Settings settings_;
+        const std::string cacheControl_;
+
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, Entry> entries_;
+        size_t cachedBytes_ = 0;
+        uint64_t useSequence_ = 0;
+        Stats stats_;
+    };
+
+}  // namespace SkyrimNetUI::Http
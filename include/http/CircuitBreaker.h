@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace SkyrimNetUI::Http {
+
+    /**
+     * @brief Retry timing after failed requests
+     */
+    struct BackoffPolicy {
+        std::chrono::milliseconds initial{std::chrono::seconds(5)};  ///< Delay after the first failure
+        std::chrono::milliseconds max{std::chrono::seconds(60)};     ///< Upper bound before jitter
+        double multiplier = 2.0;                                      ///< Growth per consecutive failure
+        double jitter = 0.2;         ///< Each delay is scaled by a random factor in [1 - jitter, 1 + jitter]
+        uint32_t openAfter = 3;      ///< Consecutive failures that open the breaker (0 = never)
+    };
+
+    /**
+     * @brief Exponential backoff with jitter and a circuit breaker for one server
+     *
+     * Every failure grows the retry delay. After policy.openAfter consecutive failures the
+     * breaker opens; callers should then stop regular requests and only send health probes,
+     * still paced by the delay. A successful probe half-opens the breaker: the next regular
+     * request decides whether it closes (success) or reopens at once (failure). A success
+     * closes the breaker and resets the delay.
+     */
+    class CircuitBreaker {
+    public:
+        enum class State : uint8_t { Closed, Open, HalfOpen };
+
+        struct Stats {
+            uint64_t failures = 0;             ///< Failures recorded
+            uint64_t opened = 0;               ///< Times the breaker opened from closed
+            uint32_t consecutiveFailures = 0;  ///< Failures since the last success
+            State state = State::Closed;
+        };
+
+        explicit CircuitBreaker(BackoffPolicy policy = {}) : policy_(policy) {}
+
+        CircuitBreaker(const CircuitBreaker&) = delete;
+        CircuitBreaker& operator=(const CircuitBreaker&) = delete;
+
+        /// Close the breaker and reset the delay
+        void RecordSuccess();
+
+        /// Let one regular request through to test the server; keeps the delay
+        void RecordProbeSuccess();
+
+        /**
+         * @brief Record a failed request or probe
+         * @return Delay before the next attempt
+         */
+        std::chrono::milliseconds RecordFailure();
+
+        [[nodiscard]] State GetState() const;
+
+        /// @return true if regular requests should be held back until a probe succeeds
+        [[nodiscard]] bool IsOpen() const;
+
+        [[nodiscard]] Stats GetStats() const;
+
+        [[nodiscard]] const BackoffPolicy& GetPolicy() const noexcept { return policy_; }
+
+    private:
+        const BackoffPolicy policy_;
+
+        mutable std::mutex mutex_;
+        Stats stats_;
+    };
+
+}  // namespace SkyrimNetUI::Http
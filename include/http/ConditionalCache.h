@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "http/HttpClient.h"
+
+namespace SkyrimNetUI::Http {
+
+    /**
+     * @brief Validator and body-hash cache for a single repeatedly fetched resource
+     *
+     * Adds If-None-Match / If-Modified-Since to the next request when the server sent
+     * an ETag or Last-Modified, so an unchanged resource costs a bodyless 304. For
+     * servers without validators, a 64-bit FNV-1a hash of the body tells the caller the
+     * content is unchanged so it can skip parsing it.
+     */
+    class ConditionalCache {
+    public:
+        enum class Outcome : uint8_t {
+            Error,        ///< Request failed or returned a non-2xx/304 status
+            NotModified,  ///< 304; the cached body (if kept) is still current
+            Unchanged,    ///< 2xx with a body identical to the previous one
+            Changed,      ///< 2xx with new content
+        };
+
+        /**
+         * @brief Transfer savings since the cache was created
+         */
+        struct Stats {
+            uint64_t notModified = 0;   ///< 304 responses received
+            uint64_t unchanged = 0;     ///< 2xx bodies skipped by hash
+            uint64_t bytesAvoided = 0;  ///< Body bytes not downloaded thanks to 304s
+        };
+
+        /// @param keepBody Keep a copy of the last body so 304 callers can still read it
+        explicit ConditionalCache(bool keepBody = false) : keepBody_(keepBody) {}
+
+        ConditionalCache(const ConditionalCache&) = delete;
+        ConditionalCache& operator=(const ConditionalCache&) = delete;
+
+        /// Add conditional request headers for the cached validators
+        void AddValidators(Headers& headers) const;
+
+        /// Record a response and classify it against the cached state
+        Outcome Update(const Response& response);
+
+        /// Forget validators and hash so the next response counts as Changed
+        void Invalidate();
+
+        /// @return copy of the last body (empty unless constructed with keepBody)
+        [[nodiscard]] std::string Body() const;
+
+        [[nodiscard]] Stats GetStats() const noexcept {
+            return {notModified_.load(std::memory_order_relaxed), unchanged_.load(std::memory_order_relaxed),
+                    bytesAvoided_.load(std::memory_order_relaxed)};
+        }
+
+        static uint64_t HashBody(std::string_view body) noexcept;
+
+    private:
+        const bool keepBody_;
+
+        mutable std::mutex mutex_;
+        std::string etag_;
+        std::string lastModified_;
+        std::string body_;
+        uint64_t bodyHash_ = 0;
+        size_t bodySize_ = 0;
+        bool valid_ = false;
+
+        std::atomic<uint64_t> notModified_{0};
+        std::atomic<uint64_t> unchanged_{0};
+        std::atomic<uint64_t> bytesAvoided_{0};
+    };
+
+}  // namespace SkyrimNetUI::Http
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace SkyrimNetUI::Http {
+
+    /**
+     * @brief A single Server-Sent Event
+     */
+    struct ServerSentEvent {
+        std::string event = "message";  ///< Event type ("message" when the server sends none)
+        std::string data;               ///< Data lines joined with '\n'
+        std::string id;                 ///< Last event id, if any
+    };
+
+    /**
+     * @brief Incremental text/event-stream parser
+     * Chunks can split lines and events at any byte; complete events are handed to the
+     * callback as soon as their terminating blank line arrives.
+     */
+    class SseParser {
+    public:
+        using EventHandler = std::function<void(const ServerSentEvent&)>;
+
+        explicit SseParser(EventHandler onEvent) : onEvent_(std::move(onEvent)) {}
+
+        /// Feed the next chunk of the response body
+        void Feed(std::string_view chunk);
+
+        /// Drop any partially received line or event (e.g. after a reconnect)
+        void Reset();
+
+    private:
+        void ProcessLine(std::string_view line);
+        void Dispatch();
+
+        EventHandler onEvent_;
+        std::string line_;
+        ServerSentEvent pending_;
+        bool hasData_ = false;
+        bool skipLineFeed_ = false;  ///< Previous chunk ended in '\r' of a "\r\n" pair
+    };
+
+}  // namespace SkyrimNetUI::Http
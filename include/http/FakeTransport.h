@@ -0,0 +1,96 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "http/Transport.h"
+
+namespace SkyrimNetUI::Http {
+
+    /**
+     * @brief A request seen by FakeTransport
+     */
+    struct FakeRequest {
+        std::string method;  ///< "GET", "HEAD", "POST", "STREAM" or whatever method Send was given
+        std::string url;
+        std::string body;
+        Headers headers;
+    };
+
+    /**
+     * @brief Canned answer for one method and URL
+     */
+    struct FakeRoute {
+        Response response;                          ///< Returned as-is (status 0 simulates a network error)
+        std::chrono::milliseconds latency{0};       ///< Delay before answering; cut short by cancellation
+        uint32_t failEvery = 0;                     ///< Every Nth request fails with status 0 (0 = never)
+        size_t padTo = 0;                           ///< Pad a JSON object body to this many bytes
+        size_t chunkSize = 0;                       ///< Stream only: deliver the body in chunks of this size
+        std::chrono::microseconds chunkInterval{0};  ///< Stream only: pace chunks this far apart
+        std::function<Response(const FakeRequest&)> handler;  ///< Computes the response instead, if set
+    };
+
+    /**
+     * @brief In-process Transport with scripted responses
+     *
+     * Answers from a route table instead of the network, with optional latency, failures
+     * and padded payloads, so controllers can be exercised and timed without a server.
+     * Unrouted requests get a 404. All requests are recorded in order.
+     */
+    class FakeTransport final : public Transport {
+    public:
+        FakeTransport() = default;
+        FakeTransport(const FakeTransport&) = delete;
+        FakeTransport& operator=(const FakeTransport&) = delete;
+
+        /// Answer method ("GET", "HEAD", "POST", "STREAM" or any other) requests for url with route
+        void SetRoute(std::string method, std::string url, FakeRoute route);
+
+        void ClearRoutes();
+
+        /// The next count requests fail with status 0, whatever their route says
+        void FailNext(uint32_t count);
+
+        [[nodiscard]] std::vector<FakeRequest> GetRequests() const;
+
+        [[nodiscard]] size_t RequestCount(std::string_view method, std::string_view url) const;
+
+        void ClearRequests();
+
+        Response Get(const std::string& url, const RequestOptions& options = {}) override;
+        Response Head(const std::string& url, const RequestOptions& options = {}) override;
+        Response Post(const std::string& url, const std::string& jsonData, const RequestOptions& options = {}) override;
+        /// Content-Type is recorded with the request's headers
+        Response Send(const std::string& method, const std::string& url, const std::string& body,
+                      std::string_view contentType, const RequestOptions& options = {}) override;
+        StreamResult Stream(const std::string& url, std::string_view contentType, const ChunkHandler& onChunk,
+                            const RequestOptions& options = {}) override;
+
+    private:
+        struct RouteState {
+            FakeRoute route;
+            uint64_t hits = 0;
+        };
+
+        struct StreamPacing {
+            size_t chunkSize = 0;
+            std::chrono::microseconds chunkInterval{0};
+        };
+
+        /// Record the request and work out its response, honouring latency and cancellation
+        Response Answer(FakeRequest request, const RequestOptions& options, StreamPacing* pacing = nullptr);
+
+        mutable std::mutex mutex_;
+        std::map<std::pair<std::string, std::string>, RouteState, std::less<>> routes_;
+        std::vector<FakeRequest> requests_;
+        uint32_t failNext_ = 0;
+    };
+
+}  // namespace SkyrimNetUI::Http
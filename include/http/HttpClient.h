@@ -1,36 +1,195 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
 #include <string>
+#include <string_view>
 
 namespace SkyrimNetUI::Http {
 
+    /**
+     * @brief Case-insensitive ordering for header names
+     */
+    struct HeaderNameLess {
+        using is_transparent = void;
+        bool operator()(std::string_view lhs, std::string_view rhs) const noexcept;
+    };
+
+    using Headers = std::map<std::string, std::string, HeaderNameLess>;
+
     /**
      * @brief HTTP response with status code and body
      */
     struct Response {
         int status = 0;      ///< HTTP status code (0 = network/connection error)
         std::string body;    ///< Response body
+        Headers headers;     ///< Response headers (last value wins for repeated names)
 
         /// @return true if request completed with 2xx status
         [[nodiscard]] bool ok() const { return status >= 200 && status < 300; }
 
+        /// @return true if a conditional request found the resource unchanged (304, empty body)
+        [[nodiscard]] bool notModified() const { return status == 304; }
+
         /// @return true if request reached the server (status != 0)
         explicit operator bool() const { return status != 0; }
+
+        /// @return header value, or an empty view if absent
+        [[nodiscard]] std::string_view header(std::string_view name) const {
+            auto it = headers.find(name);
+            return it != headers.end() ? std::string_view(it->second) : std::string_view{};
+        }
+    };
+
+    /**
+     * @brief Aborts in-flight requests from another thread
+     * Cancelling shuts down the sockets of every request currently bound to the token, so
+     * blocked reads return immediately instead of waiting out the read timeout. One token
+     * may be shared by requests on several threads. Requests started with an already
+     * cancelled token fail without touching the network.
+     */
+    class CancelToken {
+    public:
+        CancelToken() = default;
+        CancelToken(const CancelToken&) = delete;
+        CancelToken& operator=(const CancelToken&) = delete;
+
+        /// Cancel the bound requests (if any) and all future requests until Reset()
+        void Cancel();
+
+        /// Re-arm the token for new requests
+        void Reset() noexcept { cancelled_.store(false); }
+
+        [[nodiscard]] bool IsCancelled() const noexcept { return cancelled_.load(); }
+
+    private:
+        friend class CancelBinding;
+
+        std::atomic<bool> cancelled_{false};
+        std::mutex mutex_;
+        std::list<std::function<void()>> aborts_;  ///< Shut down the bound requests' sockets, one per request
+    };
+
+    /**
+     * @brief Socket timeouts of one request
+     */
+    struct Timeouts {
+        std::chrono::milliseconds connect{std::chrono::seconds(30)};  ///< TCP connect
+        std::chrono::milliseconds read{std::chrono::seconds(30)};     ///< Longest wait for the next bytes
+    };
+
+    /**
+     * @brief Per-request options
+     */
+    struct RequestOptions {
+        CancelToken* cancel = nullptr;  ///< Optional token that can abort the request
+        Headers headers;                ///< Extra request headers (e.g. If-None-Match)
+        Timeouts timeouts;              ///< Applied to the (possibly pooled) connection for this request
+        /// GET only: accept an identical GET's response up to this old, or join one in flight
+        /// (see SingleFlightTransport; 0 = always fetch fresh)
+        std::chrono::milliseconds maxAge{0};
+    };
+
+    /**
+     * @brief Outcome of a streaming request
+     */
+    struct StreamResult {
+        int status = 0;         ///< HTTP status code (0 = network/connection error or cancellation)
+        bool accepted = false;  ///< Server answered 2xx with the requested content type
+    };
+
+    /**
+     * @brief Receives body chunks of a streaming request as they arrive
+     * @return false to close the stream
+     */
+    using ChunkHandler = std::function<bool(std::string_view chunk)>;
+
+    /**
+     * @brief Counters for the keep-alive client pool
+     */
+    struct PoolStats {
+        uint64_t created = 0;      ///< Clients (and therefore TCP connections) opened
+        uint64_t reused = 0;       ///< Pooled checkouts whose connection was still open
+        uint64_t reconnected = 0;  ///< Pooled checkouts whose connection had closed, so the request dialled again
+        uint64_t evicted = 0;      ///< Idle clients closed by the idle timeout or size limit
+        size_t idle = 0;           ///< Clients currently parked in the pool
     };
 
     /**
      * @brief Performs HTTP GET request
      * @param url URL to request (e.g., "http://localhost:8080/path")
-     * @return Response with status and body; status=0 on connection failure
+     * @param options Per-request options
+     * @return Response with status and body; status=0 on connection failure or cancellation
+     */
+    Response Get(const std::string& url, const RequestOptions& options = {});
+
+    /**
+     * @brief Performs HTTP HEAD request
+     * Cheapest way to check that the server answers: no body is transferred.
+     * @param url URL to request
+     * @param options Per-request options
+     * @return Response with status and headers; status=0 on connection failure or cancellation
      */
-    Response Get(const std::string& url);
+    Response Head(const std::string& url, const RequestOptions& options = {});
 
     /**
      * @brief Performs HTTP POST request with JSON payload
      * @param url URL to request (e.g., "http://localhost:8080/path")
      * @param jsonData JSON payload as string
-     * @return Response with status and body; status=0 on connection failure
+     * @param options Per-request options
+     * @return Response with status and body; status=0 on connection failure or cancellation
+     */
+    Response Post(const std::string& url, const std::string& jsonData, const RequestOptions& options = {});
+
+    /**
+     * @brief Performs an HTTP request with any method, passing the body through untouched
+     * Used to relay requests whose method and body encoding the caller doesn't control.
+     * @param method Request method, e.g. "PUT" or "DELETE"
+     * @param url URL to request
+     * @param body Request body; may be empty
+     * @param contentType Sent as Content-Type unless empty
+     * @param options Per-request options
+     * @return Response with status and body; status=0 on connection failure or cancellation
+     */
+    Response Send(const std::string& method, const std::string& url, const std::string& body,
+                  std::string_view contentType, const RequestOptions& options = {});
+
+    /**
+     * @brief Performs a long-lived HTTP GET whose body is delivered incrementally
+     * Used for text/event-stream subscriptions. The request uses its own connection
+     * (not the keep-alive pool) and returns when the server closes the stream, the
+     * handler returns false, the read times out or the request is cancelled. The read
+     * timeout should exceed the server's keep-alive comment interval.
+     * @param url URL to request
+     * @param contentType Sent as Accept; the body is only streamed if the response
+     *        Content-Type starts with it
+     * @param onChunk Handler for body chunks
+     * @param options Per-request options
+     */
+    StreamResult Stream(const std::string& url, std::string_view contentType, const ChunkHandler& onChunk,
+                        const RequestOptions& options = {});
+
+    /**
+     * @brief Enable or disable the per-origin keep-alive pool
+     * When disabled every request opens (and closes) its own connection, which is
+     * the pre-pool behaviour and is kept for comparison.
+     */
+    void SetPoolingEnabled(bool enabled);
+
+    /**
+     * @brief Close all idle pooled connections
+     */
+    void ClosePool();
+
+    /**
+     * @brief Snapshot of the keep-alive pool counters
      */
-    Response Post(const std::string& url, const std::string& jsonData);
+    PoolStats GetPoolStats();
 
 }  // namespace SkyrimNetUI::Http
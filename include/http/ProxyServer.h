@@ -0,0 +1,54 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "http/AssetProxy.h"
+
+namespace httplib {
+    class Server;
+}
+
+namespace SkyrimNetUI::Http {
+
+    /**
+     * @brief Serves an AssetProxy on a loopback port so the view can load the web UI through it
+     */
+    class ProxyServer {
+    public:
+        ProxyServer(Transport& upstream, AssetProxy::Settings settings);
+        ~ProxyServer();
+
+        ProxyServer(const ProxyServer&) = delete;
+        ProxyServer& operator=(const ProxyServer&) = delete;
+
+        /**
+         * @brief Listen on 127.0.0.1 from a background thread
+         * @param port Preferred port; a free one is picked if it is 0 or taken. The view's
+         *             storage is per origin, so a stable port keeps what the web UI saved.
+         */
+        bool Start(int port);
+
+        /// Stop listening and end relayed event streams
+        void Stop();
+
+        /// @return http://127.0.0.1:port, or empty if not running
+        [[nodiscard]] std::string Url() const;
+
+        AssetProxy& GetProxy() noexcept { return proxy_; }
+
+    private:
+        AssetProxy proxy_;
+        std::unique_ptr<httplib::Server> server_;
+        std::thread thread_;
+        int port_ = 0;
+
+        std::mutex streamsMutex_;
+        std::vector<CancelToken*> streams_;  ///< Event streams being relayed, cancelled by Stop
+        bool stopping_ = false;
+    };
+
+}  // namespace SkyrimNetUI::Http
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "http/Transport.h"
+
+namespace SkyrimNetUI::Http {
+
+    /**
+     * @brief Transport decorator that merges identical concurrent GETs
+     *
+     * GETs with the same URL and headers share one request: the first caller issues it and
+     * callers that arrive while it is in flight wait for its response. Successful responses
+     * are also kept briefly so a repeat within the caller's RequestOptions::maxAge is served
+     * from memory.
+     *
+     * Only callers that accept a stale answer (maxAge > 0) join or read the cache; others
+     * always issue their own request, which tolerant callers can then join. Any POST (or
+     * other write sent through Send) drops the cache and stops later callers joining GETs
+     * that started before it, so a read never returns state older than a write this process made.
+     */
+    class SingleFlightTransport final : public Transport {
+    public:
+        struct Stats {
+            uint64_t issued = 0;     ///< GETs passed to the wrapped transport
+            uint64_t merged = 0;     ///< GETs answered by another caller's in-flight request
+            uint64_t cacheHits = 0;  ///< GETs answered from the response cache
+        };
+
+        explicit SingleFlightTransport(Transport& inner) : inner_(inner) {}
+
+        SingleFlightTransport(const SingleFlightTransport&) = delete;
+        SingleFlightTransport& operator=(const SingleFlightTransport&) = delete;
+
+        Response Get(const std::string& url, const RequestOptions& options = {}) override;
+
+        /// Probes are only useful fresh and are never shared
+        Response Head(const std::string& url, const RequestOptions& options = {}) override;
+
+        Response Post(const std::string& url, const std::string& jsonData, const RequestOptions& options = {}) override;
+
+        Response Send(const std::string& method, const std::string& url, const std::string& body,
+                      std::string_view contentType, const RequestOptions& options = {}) override;
+
+        /// Streams are long-lived and never shared
+        StreamResult Stream(const std::string& url, std::string_view contentType, const ChunkHandler& onChunk,
+                            const RequestOptions& options = {}) override;
+
+        /// Drop cached responses
+        void Clear();
+
+        [[nodiscard]] Stats GetStats() const;
+
+    private:
+        struct Result {
+            Response response;
+            bool cancelled = false;  ///< The issuing caller cancelled; waiters should retry on their own
+        };
+
+        struct Flight {
+            std::promise<Result> promise;
+            std::shared_future<Result> future{promise.get_future().share()};
+            uint64_t writeGeneration = 0;  ///< Writes seen before the request was issued
+        };
+
+        struct CachedResponse {
+            Response response;
+            std::chrono::steady_clock::time_point fetched;
+        };
+
+        static std::string Key(const std::string& url, const Headers& headers);
+        Response Wait(const std::shared_ptr<Flight>& flight, const std::string& url, const RequestOptions& options);
+
+        Transport& inner_;
+
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, std::shared_ptr<Flight>> flights_;
+        std::unordered_map<std::string, CachedResponse> cache_;
+        uint64_t writeGeneration_ = 0;
+        Stats stats_;
+    };
+
+}  // namespace SkyrimNetUI::Http
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "http/HttpClient.h"
+
+namespace SkyrimNetUI::Http {
+
+    /// Where SkyrimNet listens unless configured otherwise
+    inline constexpr std::string_view kDefaultBaseUrl = "http://localhost:8080";
+
+    /**
+     * @brief Request backend used by the SkyrimNet clients
+     * Implementations must be safe to call from several threads at once.
+     */
+    class Transport {
+    public:
+        virtual ~Transport() = default;
+
+        /// @see Http::Get
+        virtual Response Get(const std::string& url, const RequestOptions& options = {}) = 0;
+
+        /// @see Http::Head
+        virtual Response Head(const std::string& url, const RequestOptions& options = {}) = 0;
+
+        /// @see Http::Post
+        virtual Response Post(const std::string& url, const std::string& jsonData,
+                              const RequestOptions& options = {}) = 0;
+
+        /// @see Http::Send
+        virtual Response Send(const std::string& method, const std::string& url, const std::string& body,
+                              std::string_view contentType, const RequestOptions& options = {}) = 0;
+
+        /// @see Http::Stream
+        virtual StreamResult Stream(const std::string& url, std::string_view contentType, const ChunkHandler& onChunk,
+                                    const RequestOptions& options = {}) = 0;
+    };
+
+    /**
+     * @brief Transport backed by the pooled cpp-httplib client in HttpClient.h
+     */
+    class HttplibTransport final : public Transport {
+    public:
+        Response Get(const std::string& url, const RequestOptions& options = {}) override;
+        Response Head(const std::string& url, const RequestOptions& options = {}) override;
+        Response Post(const std::string& url, const std::string& jsonData, const RequestOptions& options = {}) override;
+        Response Send(const std::string& method, const std::string& url, const std::string& body,
+                      std::string_view contentType, const RequestOptions& options = {}) override;
+        StreamResult Stream(const std::string& url, std::string_view contentType, const ChunkHandler& onChunk,
+                            const RequestOptions& options = {}) override;
+    };
+
+    /**
+     * @brief Shared transport used by the global controller
+     * A SingleFlightTransport over an HttplibTransport, so identical status reads are merged.
+     */
+    Transport& GetDefaultTransport();
+
+}  // namespace SkyrimNetUI::Http
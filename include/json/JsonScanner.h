@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace SkyrimNetUI::Json {
+
+    /**
+     * @brief Structure-aware, non-allocating lookups on raw JSON text
+     *
+     * Values are returned as views of their raw text inside the document (strings keep
+     * their quotes), so nothing is copied or decoded unless the caller asks for it.
+     * Keys only match real object members at the expected depth; text inside string
+     * values or nested objects never produces a false hit.
+     */
+
+    /// Maximum number of pointers Resolve() handles in one pass
+    inline constexpr size_t kMaxPointers = 64;
+
+    /**
+     * @brief Resolve several RFC 6901 JSON pointers in a single pass over the document
+     * @param doc JSON text
+     * @param pointers Pointers such as "/gamemaster/agentEnabled" ("" is the whole document)
+     * @param results Receives the raw value text for each pointer, or nullopt if absent;
+     *        must be the same size as pointers
+     * @return false if the document is malformed or more than kMaxPointers are given
+     */
+    bool Resolve(std::string_view doc, std::span<const std::string_view> pointers,
+                 std::span<std::optional<std::string_view>> results);
+
+    /**
+     * @brief Resolve a single JSON pointer
+     * @return raw value text, or nullopt if absent or the document is malformed
+     */
+    std::optional<std::string_view> Find(std::string_view doc, std::string_view pointer);
+
+    /**
+     * @brief Find the first member named key at any depth (document order)
+     * For responses whose envelope isn't fixed; prefer Find() when the path is known.
+     * @return raw value text, or nullopt if absent or the document is malformed
+     */
+    std::optional<std::string_view> FindMember(std::string_view doc, std::string_view key);
+
+    /**
+     * @brief Interpret raw value text as a boolean literal
+     */
+    std::optional<bool> AsBool(std::string_view value) noexcept;
+
+    /**
+     * @brief Replacement of one value's raw text
+     */
+    struct Patch {
+        std::string_view target;       ///< Value text as returned by Find/Resolve (must point into the document)
+        std::string_view replacement;  ///< New raw JSON text
+    };
+
+    /**
+     * @brief Apply non-overlapping patches to a document into one output buffer
+     * @return patched document, or nullopt if a target lies outside doc or targets overlap
+     */
+    std::optional<std::string> ApplyPatches(std::string_view doc, std::span<Patch> patches);
+
+}  // namespace SkyrimNetUI::Json
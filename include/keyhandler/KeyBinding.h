@@ -0,0 +1,52 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace SkyrimNetUI {
+
+    enum class KeyEventType : uint8_t { KEY_DOWN, KEY_UP, KEY_HOLD, KEY_DOUBLE_TAP };
+
+    enum KeyModifier : uint8_t {
+        kModifierNone = 0,
+        kModifierShift = 1 << 0,
+        kModifierCtrl = 1 << 1,
+        kModifierAlt = 1 << 2,
+        kModifierAny = 0xFF,  ///< Match regardless of which modifiers are held
+    };
+
+    /// Distinct Shift/Ctrl/Alt combinations
+    inline constexpr size_t kModifierCombinations = 8;
+
+    inline constexpr float kDefaultHoldSeconds = 0.5f;
+    inline constexpr std::chrono::milliseconds kDoubleTapWindow{300};
+
+    /**
+     * @brief A key, the modifiers that must be held with it, and how it has to be pressed
+     */
+    struct KeyBinding {
+        uint32_t key = 0;                          ///< DirectInput scan code
+        uint8_t modifiers = kModifierAny;          ///< Exact KeyModifier mask, or kModifierAny
+        KeyEventType type = KeyEventType::KEY_DOWN;
+        float holdSeconds = kDefaultHoldSeconds;   ///< KEY_HOLD only
+    };
+
+    /**
+     * @brief Parse a binding such as "F4", "Ctrl+Shift+F4", "F4:Hold=0.8", "F4:DoubleTap" or "F4:Up"
+     * Names are case-insensitive; a key can also be given as a hex scan code ("0x3E").
+     * A binding without modifiers fires whatever is held; one with modifiers matches them exactly,
+     * so "Ctrl+F4" doesn't fire on Ctrl+Shift+F4.
+     * @return nullopt if the text isn't a valid binding
+     */
+    std::optional<KeyBinding> ParseKeyBinding(std::string_view text);
+
+    /**
+     * @brief Modifier bit for a scan code
+     * @return The KeyModifier for Shift/Ctrl/Alt keys (either side), otherwise kModifierNone
+     */
+    uint8_t ModifierForScanCode(uint32_t dxScanCode) noexcept;
+
+}  // namespace SkyrimNetUI
@@ -2,12 +2,16 @@
 
 #include <RE/Skyrim.h>
 
+#include <array>
 #include <atomic>
 #include <cstdint>
 #include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
-#include <shared_mutex>
+#include <vector>
+
+#include "keyhandler/KeyBinding.h"
 
 namespace SkyrimNetUI {
 
@@ -16,11 +20,8 @@ namespace SkyrimNetUI {
 
     inline constexpr KeyHandlerEvent INVALID_REGISTRATION_HANDLE = 0;
 
-    enum class KeyEventType : uint8_t { KEY_DOWN, KEY_UP };
-
     struct CallbackInfo {
-        uint32_t key = 0;
-        KeyEventType type = KeyEventType::KEY_DOWN;
+        KeyBinding binding;
     };
 
     class KeyHandler : public RE::BSTEventSink<RE::InputEvent*> {
@@ -33,28 +34,91 @@ namespace SkyrimNetUI {
         static KeyHandler* GetSingleton();
         static void RegisterSink();
 
+        /// Bind a key regardless of held modifiers
         [[nodiscard]] KeyHandlerEvent Register(uint32_t dxScanCode, KeyEventType eventType, KeyCallback callback);
 
+        /// Bind a chord, hold or double-tap
+        [[nodiscard]] KeyHandlerEvent Register(const KeyBinding& binding, KeyCallback callback);
+
         void Unregister(KeyHandlerEvent handle);
 
+        /**
+         * @brief Forget which keys are held
+         * For when key-ups may have gone elsewhere, e.g. while the overlay or another window had focus.
+         * Takes effect on the input thread before the next event is matched.
+         */
+        void ResetKeyStates() noexcept { _resetPending.store(true, std::memory_order_release); }
+
     private:
-        KeyHandler() = default;
+        /// DirectInput scan codes are a single byte
+        static constexpr size_t kMaxScanCodes = 256;
+
+        struct Binding {
+            KeyHandlerEvent handle = INVALID_REGISTRATION_HANDLE;
+            std::shared_ptr<const KeyCallback> callback;
+            float holdSeconds = 0.0f;
+        };
+
+        struct Triggers {
+            std::vector<Binding> down;
+            std::vector<Binding> up;
+            std::vector<Binding> hold;
+            std::vector<Binding> doubleTap;
+
+            std::vector<Binding>& For(KeyEventType type);
+        };
+
+        /// Bindings of one key: one slot per exact modifier mask plus the modifier-agnostic slot
+        struct KeyEntry {
+            std::array<Triggers, kModifierCombinations> exact;
+            Triggers any;
+
+            Triggers& For(uint8_t modifiers) { return modifiers == kModifierAny ? any : exact[modifiers]; }
+        };
+
+        /**
+         * @brief Immutable registry published to the input thread
+         * Matching an event is two table lookups regardless of how many bindings exist.
+         * Register/Unregister copy the table, replace the one KeyEntry they change and swap it in;
+         * untouched entries are shared between snapshots.
+         */
+        struct Snapshot {
+            std::array<std::shared_ptr<const KeyEntry>, kMaxScanCodes> keys;
+        };
+
+        /// Per-key input state, only touched by ProcessEvent on the input thread
+        struct KeyState {
+            bool pressed = false;
+            float heldSeconds = 0.0f;  ///< Hold duration seen by the previous event
+            bool tapArmed = false;     ///< A first tap is waiting for its double
+            std::chrono::steady_clock::time_point lastTap;
+        };
+
+        KeyHandler();
         ~KeyHandler() override = default;
 
         RE::BSEventNotifyControl ProcessEvent(RE::InputEvent* const* a_eventList,
                                               RE::BSTEventSource<RE::InputEvent*>* a_eventSource) override;
 
-        struct KeyCallbacks {
-            std::map<KeyHandlerEvent, KeyCallback> down;
-            std::map<KeyHandlerEvent, KeyCallback> up;
-        };
+        void PublishLocked(std::unique_ptr<Snapshot> next);
+        uint8_t HeldModifiers() noexcept;
+        static void Run(const std::vector<Binding>& bindings);
+        static void RunHolds(const std::vector<Binding>& bindings, float previous, float current);
 
-        std::map<uint32_t, KeyCallbacks> _registeredCallbacks;
+        /// Read without locks by ProcessEvent
+        std::atomic<const Snapshot*> _snapshot{nullptr};
+
+        // Writer state, guarded by _mutex. Replaced snapshots are retired rather than freed so a
+        // dispatch in progress never sees freed memory; registrations are rare, so this stays small.
+        std::vector<std::unique_ptr<const Snapshot>> _snapshots;
         std::map<KeyHandlerEvent, CallbackInfo> _handleMap;
 
+        std::array<KeyState, kMaxScanCodes> _keyStates{};
+        std::atomic<bool> _resetPending{false};
+
         std::atomic<KeyHandlerEvent> _nextHandle = INVALID_REGISTRATION_HANDLE + 1;
 
-        std::shared_mutex _mutex;
+        std::mutex _mutex;
     };
 
 }  // namespace SkyrimNetUI
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SkyrimNetUI::Lifecycle {
+
+    /**
+     * @brief Why background work is not needed right now
+     */
+    enum class Reason : uint8_t {
+        Loading,        ///< Between SKSE reporting a save starting to load and it having loaded
+        LoadingScreen,  ///< The loading screen menu is open, including for in-game transitions
+        Paused,         ///< A game-pausing menu other than our own view is open
+        ViewHidden,     ///< The SkyrimNet view is closed
+    };
+
+    using ReasonMask = uint8_t;
+
+    constexpr ReasonMask Mask(Reason reason) noexcept {
+        return static_cast<ReasonMask>(1u << static_cast<unsigned>(reason));
+    }
+
+    /// A save load and the loading screen overlap without nesting, so each is tracked on its own
+    inline constexpr ReasonMask kLoadingReasons = Mask(Reason::Loading) | Mask(Reason::LoadingScreen);
+
+    inline constexpr ReasonMask kAllReasons = kLoadingReasons | Mask(Reason::Paused) | Mask(Reason::ViewHidden);
+
+    /**
+     * @brief Starts and stops background services as game state changes
+     *
+     * Each service names the reasons that suspend it. A service runs while none of its
+     * reasons are active and is stopped as soon as one becomes active, so suspending for
+     * a loading screen stops every affected service at once. Callbacks run on the thread
+     * that changed the state, under the manager's lock; they must not block or call back
+     * into the manager.
+     */
+    class Manager {
+    public:
+        /**
+         * @brief Transition counters
+         */
+        struct Stats {
+            uint64_t suspends = 0;  ///< Service stop calls
+            uint64_t resumes = 0;   ///< Service start calls
+        };
+
+        /// @param initial Reasons active from the start; the view starts out hidden
+        explicit Manager(ReasonMask initial = Mask(Reason::ViewHidden)) : active_(initial) {}
+
+        Manager(const Manager&) = delete;
+        Manager& operator=(const Manager&) = delete;
+
+        /**
+         * @brief Add a service, replacing one with the same name
+         * The service is started right away unless one of suspendOn is active.
+         */
+        void Register(std::string name, ReasonMask suspendOn, std::function<void()> resume,
+                      std::function<void()> suspend);
+
+        /**
+         * @brief Stop all running services and forget them
+         */
+        void UnregisterAll();
+
+        /// Mark a reason active, stopping the services it affects
+        void Suspend(Reason reason) { Set(reason, true); }
+
+        /// Mark a reason inactive, starting services that have no other active reason
+        void Resume(Reason reason) { Set(reason, false); }
+
+        void Set(Reason reason, bool active);
+
+        [[nodiscard]] bool IsActive(Reason reason) const;
+
+        /// @return true if any of reasons is active
+        [[nodiscard]] bool IsAnyActive(ReasonMask reasons) const;
+
+        /// @return true if the named service is registered and running
+        [[nodiscard]] bool IsRunning(std::string_view name) const;
+
+        Stats GetStats() const;
+
+    private:
+        struct Service {
+            std::string name;
+            ReasonMask suspendOn = 0;
+            std::function<void()> resume;
+            std::function<void()> suspend;
+            bool running = false;
+        };
+
+        void UpdateLocked(Service& service);
+
+        mutable std::mutex mutex_;
+        ReasonMask active_;
+        std::vector<Service> services_;  ///< Started in registration order, stopped in reverse
+        Stats stats_;
+    };
+
+    /**
+     * @brief Manager for the plugin's services
+     */
+    Manager& GetManager();
+
+}  // namespace SkyrimNetUI::Lifecycle
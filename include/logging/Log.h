@@ -0,0 +1,87 @@
+#pragma once
+
+#include <spdlog/common.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace SkyrimNetUI::Log {
+
+    /**
+     * @brief Parts of the plugin with independently configurable log levels
+     * Levels are read from the [Logging] section of the settings file, e.g. "Http = debug".
+     */
+    enum class Subsystem : uint8_t { Core, Http, GameMaster, UI, Input, Count };
+
+    inline constexpr size_t kSubsystemCount = static_cast<size_t>(Subsystem::Count);
+
+    namespace detail {
+        extern std::array<std::atomic<uint8_t>, kSubsystemCount> g_levels;
+    }
+
+    /**
+     * @brief Runtime level check; one relaxed load
+     */
+    inline bool ShouldLog(Subsystem subsystem, spdlog::level::level_enum level) noexcept {
+        return static_cast<uint8_t>(level) >=
+               detail::g_levels[static_cast<size_t>(subsystem)].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Asynchronous logging counters
+     */
+    struct Stats {
+        size_t queueCapacity = 0;   ///< Bounded queue size (messages)
+        size_t queued = 0;          ///< Messages waiting to be written
+        size_t overruns = 0;        ///< Messages discarded because the queue was full
+    };
+
+    /**
+     * @brief Move the default logger onto a background writer thread and apply configured levels
+     * Call after the file logger has been created. [Logging] settings:
+     *   QueueSize (8192), Overflow = block | drop (drop), Level (info), <Subsystem> = level.
+     * The settings file is re-read periodically so levels can be changed while the game runs.
+     */
+    void Initialize();
+
+    /// Flush pending messages and stop the writer thread
+    void Shutdown();
+
+    Stats GetStats();
+
+}  // namespace SkyrimNetUI::Log
+
+// Messages below this level are compiled out entirely (arguments are never evaluated)
+#ifndef SKYRIMNET_LOG_ACTIVE_LEVEL
+    #define SKYRIMNET_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+
+#define SKYRIMNET_LOG_IMPL(fn, level, subsystem, ...)                                                \
+    do {                                                                                             \
+        if (::SkyrimNetUI::Log::ShouldLog(::SkyrimNetUI::Log::Subsystem::subsystem, level)) {        \
+            logger::fn(__VA_ARGS__);                                                                 \
+        }                                                                                            \
+    } while (false)
+
+#if SKYRIMNET_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+    #define LOG_TRACE(subsystem, ...) SKYRIMNET_LOG_IMPL(trace, spdlog::level::trace, subsystem, __VA_ARGS__)
+#else
+    #define LOG_TRACE(subsystem, ...) (void)0
+#endif
+
+#if SKYRIMNET_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+    #define LOG_DEBUG(subsystem, ...) SKYRIMNET_LOG_IMPL(debug, spdlog::level::debug, subsystem, __VA_ARGS__)
+#else
+    #define LOG_DEBUG(subsystem, ...) (void)0
+#endif
+
+#if SKYRIMNET_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+    #define LOG_INFO(subsystem, ...) SKYRIMNET_LOG_IMPL(info, spdlog::level::info, subsystem, __VA_ARGS__)
+#else
+    #define LOG_INFO(subsystem, ...) (void)0
+#endif
+
+#define LOG_WARN(subsystem, ...) SKYRIMNET_LOG_IMPL(warn, spdlog::level::warn, subsystem, __VA_ARGS__)
+#define LOG_ERROR(subsystem, ...) SKYRIMNET_LOG_IMPL(error, spdlog::level::err, subsystem, __VA_ARGS__)
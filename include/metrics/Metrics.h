@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace SkyrimNetUI::Metrics {
+
+    /**
+     * @brief Instrumented operations, each with its own latency histogram
+     */
+    enum class Metric : uint8_t { HttpGet, HttpPost, Toggle, KeyEvent, InteropFlush, Count };
+
+    /**
+     * @brief Plain event counters
+     */
+    enum class Counter : uint8_t {
+        HttpFailures,
+        HttpMerged,
+        HttpCacheHits,
+        ProxyHits,
+        ToggleFailures,
+        InteropCalls,
+        FeedEvents,
+        Count
+    };
+
+    inline constexpr size_t kMetricCount = static_cast<size_t>(Metric::Count);
+    inline constexpr size_t kCounterCount = static_cast<size_t>(Counter::Count);
+
+    /**
+     * @brief Record one latency sample
+     *
+     * Samples go into a log-linear histogram owned by the calling thread (16 sub-buckets per
+     * power of two, so percentiles are within ~6%), using relaxed atomic adds only; no locks
+     * after a thread's first sample. A sample costs ~10 ns; ScopedTimer adds two steady_clock
+     * reads, whose cost depends on the platform timer.
+     */
+    void Record(Metric metric, std::chrono::nanoseconds elapsed) noexcept;
+
+    void Increment(Counter counter, uint64_t amount = 1) noexcept;
+
+    /**
+     * @brief Records the lifetime of the scope into a metric
+     */
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(Metric metric) noexcept : metric_(metric), start_(std::chrono::steady_clock::now()) {}
+        ~ScopedTimer() { Record(metric_, std::chrono::steady_clock::now() - start_); }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        Metric metric_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    struct HistogramSnapshot {
+        uint64_t count = 0;
+        uint64_t totalNanos = 0;
+        uint64_t maxNanos = 0;
+        uint64_t p50Nanos = 0;
+        uint64_t p90Nanos = 0;
+        uint64_t p99Nanos = 0;
+    };
+
+    /**
+     * @brief All histograms and counters merged across threads, since startup
+     */
+    struct Snapshot {
+        std::array<HistogramSnapshot, kMetricCount> histograms;
+        std::array<uint64_t, kCounterCount> counters{};
+    };
+
+    Snapshot TakeSnapshot();
+
+    /// @return {"histograms":{"HttpGet":{"count":..,"p50Us":..},...},"counters":{...}}
+    std::string ToJson(const Snapshot& snapshot);
+
+    /// @return Name used for the metric in ToJson
+    std::string_view Name(Metric metric) noexcept;
+
+    /// @return Name used for the counter in ToJson
+    std::string_view Name(Counter counter) noexcept;
+
+    /**
+     * @brief Private (non-shared) memory of the game process in bytes, or 0 if unavailable
+     * Process-wide, so only differences taken around an operation say anything about it.
+     */
+    uint64_t ProcessPrivateBytes() noexcept;
+
+    /**
+     * @brief Periodically write the snapshot to a JSON file in directory
+     * [Metrics] DumpIntervalSeconds controls the period (default 60, 0 disables).
+     */
+    void StartPeriodicDump(const std::filesystem::path& directory);
+
+    void StopPeriodicDump();
+
+    /**
+     * @brief Hold periodic dumps without forgetting the configured directory and period
+     * Resuming waits a full period before the next dump.
+     */
+    void SetPeriodicDumpSuspended(bool suspended);
+
+}  // namespace SkyrimNetUI::Metrics
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace SkyrimNetUI::MsgPack {
+
+    /**
+     * @brief Appends MessagePack values to a byte string
+     *
+     * Every value uses its smallest encoding. Containers are written as a header with the
+     * element count followed by the elements (key, value, key, value... for maps), so the
+     * count must be known up front.
+     */
+    class Writer {
+    public:
+        Writer() = default;
+
+        /// Start empty but with room for bytes
+        explicit Writer(size_t reserve) { data_.reserve(reserve); }
+
+        void Nil();
+        void Bool(bool value);
+        void Int(int64_t value);
+        void UInt(uint64_t value);
+        void Double(double value);
+        void String(std::string_view value);
+        void Binary(std::string_view bytes);
+
+        /// Header of an array of size elements
+        void Array(uint32_t size);
+
+        /// Header of a map of size key/value pairs
+        void Map(uint32_t size);
+
+        [[nodiscard]] const std::string& Data() const noexcept { return data_; }
+
+        /// @return The encoded bytes, leaving the writer empty
+        std::string Take() noexcept { return std::move(data_); }
+
+        void Clear() noexcept { data_.clear(); }
+
+    private:
+        void Header(uint8_t marker, uint64_t value, size_t bytes);
+
+        std::string data_;
+    };
+
+    /**
+     * @brief Reads MessagePack values in order without allocating
+     *
+     * Each Read call consumes one value and returns nullopt (leaving the reader failed) if
+     * the next value has another type or is truncated. Strings and binaries are views into
+     * the input. Skip steps over a value of any type, e.g. fields added by a newer version.
+     */
+    class Reader {
+    public:
+        enum class Type : uint8_t { Nil, Bool, Int, Double, String, Binary, Array, Map, End, Invalid };
+
+        explicit Reader(std::string_view data) noexcept : data_(data) {}
+
+        /// @return Type of the next value (End once all input is read, Invalid after an error)
+        [[nodiscard]] Type Peek() const noexcept;
+
+        bool ReadNil() noexcept;
+        std::optional<bool> ReadBool() noexcept;
+
+        /// Unsigned values above INT64_MAX don't fit and fail
+        std::optional<int64_t> ReadInt() noexcept;
+
+        /// Integers are converted
+        std::optional<double> ReadDouble() noexcept;
+
+        std::optional<std::string_view> ReadString() noexcept;
+        std::optional<std::string_view> ReadBinary() noexcept;
+
+        /// @return Element count; the elements follow
+        std::optional<uint32_t> ReadArray() noexcept;
+
+        /// @return Pair count; the keys and values follow
+        std::optional<uint32_t> ReadMap() noexcept;
+
+        /// Step over the next value, including the contents of containers
+        bool Skip() noexcept;
+
+        [[nodiscard]] bool Failed() const noexcept { return failed_; }
+        [[nodiscard]] bool AtEnd() const noexcept { return !failed_ && position_ == data_.size(); }
+
+    private:
+        std::optional<uint64_t> Take(size_t bytes) noexcept;
+        std::optional<std::string_view> TakeBytes(size_t length) noexcept;
+        bool SkipDepth(int depth) noexcept;
+        std::nullopt_t Fail() noexcept;
+
+        std::string_view data_;
+        size_t position_ = 0;
+        bool failed_ = false;
+    };
+
+}  // namespace SkyrimNetUI::MsgPack
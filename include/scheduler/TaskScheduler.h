@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace SkyrimNetUI::Scheduler {
+
+    /**
+     * @brief Priority lane of a task
+     * UI tasks are always dispatched before background tasks, and one worker only ever
+     * runs UI tasks so a blocked background task can't delay them. Stream tasks hold a
+     * connection open for as long as it lasts, so they run on workers of their own and
+     * never take a worker away from the other lanes.
+     */
+    enum class Lane : uint8_t { UI, Background, Stream };
+
+    using Clock = std::chrono::steady_clock;
+    using Task = std::function<void()>;
+
+    namespace detail {
+        struct TaskState;
+    }
+
+    /**
+     * @brief Handle to a scheduled task
+     * Handles don't keep the scheduler alive; cancelling after the scheduler is gone is a no-op.
+     */
+    class TaskHandle {
+    public:
+        TaskHandle() = default;
+
+        /// Prevent future runs; a run already in progress completes normally
+        void Cancel() noexcept;
+
+        /// Cancel, then block until a run in progress has returned (no-op when called from the task itself)
+        void CancelAndWait() noexcept;
+
+        /// @return true if the task is still scheduled (not cancelled, and one-shot tasks not yet run)
+        [[nodiscard]] bool IsActive() const noexcept;
+
+        explicit operator bool() const noexcept { return IsActive(); }
+
+    private:
+        friend class TaskScheduler;
+        explicit TaskHandle(std::shared_ptr<detail::TaskState> state) : state_(std::move(state)) {}
+
+        std::shared_ptr<detail::TaskState> state_;
+    };
+
+    /**
+     * @brief Fixed pool of workers running immediate, delayed and periodic tasks
+     */
+    class TaskScheduler {
+    public:
+        static constexpr size_t kDefaultWorkerCount = 4;
+        /// One per long-lived connection the plugin keeps: the status push and the event feed
+        static constexpr size_t kDefaultStreamWorkerCount = 2;
+
+        /**
+         * @brief Dispatch counters
+         */
+        struct Stats {
+            uint64_t threadsCreated = 0;        ///< Worker threads started over the scheduler's lifetime
+            uint64_t uiTasksRun = 0;            ///< UI lane runs
+            uint64_t backgroundTasksRun = 0;    ///< Background lane runs
+            uint64_t streamTasksRun = 0;        ///< Stream lane runs
+            uint64_t totalDispatchMicros = 0;   ///< Sum of ready-to-start latencies
+            uint64_t maxDispatchMicros = 0;     ///< Worst ready-to-start latency
+        };
+
+        /**
+         * @param workerCount Number of UI and background workers (at least 2: one UI-only, one shared)
+         * @param streamWorkerCount Number of workers that only run the stream lane (at least 1)
+         */
+        explicit TaskScheduler(size_t workerCount = kDefaultWorkerCount,
+                               size_t streamWorkerCount = kDefaultStreamWorkerCount);
+        ~TaskScheduler();
+
+        TaskScheduler(const TaskScheduler&) = delete;
+        TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+        /// Run a task as soon as a worker is free
+        TaskHandle Post(Lane lane, Task task);
+
+        /// Run a task once after a delay
+        TaskHandle PostDelayed(Lane lane, std::chrono::milliseconds delay, Task task);
+
+        /**
+         * @brief Run a task repeatedly
+         * The next run is scheduled period after the previous run finishes, so a slow run
+         * never overlaps itself.
+         */
+        TaskHandle PostPeriodic(Lane lane, std::chrono::milliseconds period, Task task,
+                                std::chrono::milliseconds initialDelay = std::chrono::milliseconds::zero());
+
+        /// Stop accepting tasks, drop pending ones and join the workers
+        void Shutdown();
+
+        Stats GetStats() const;
+
+    private:
+        struct TimerEntry {
+            Clock::time_point due;
+            uint64_t sequence;
+            std::shared_ptr<detail::TaskState> task;
+
+            bool operator>(const TimerEntry& other) const {
+                return due != other.due ? due > other.due : sequence > other.sequence;
+            }
+        };
+
+        /// Which lanes a worker takes tasks from
+        enum class Role : uint8_t { UIOnly, Shared, Stream };
+
+        TaskHandle Schedule(Lane lane, Clock::time_point due, std::chrono::milliseconds period, Task task);
+        void EnqueueLocked(std::shared_ptr<detail::TaskState> task, Clock::time_point due);
+        void PushReadyLocked(std::shared_ptr<detail::TaskState> task);
+        void WorkerLoop(Role role);
+        std::shared_ptr<detail::TaskState> NextReadyLocked(Role role);
+        bool PromoteDueTimersLocked(Clock::time_point now);
+
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        std::deque<std::shared_ptr<detail::TaskState>> uiQueue_;
+        std::deque<std::shared_ptr<detail::TaskState>> backgroundQueue_;
+        std::deque<std::shared_ptr<detail::TaskState>> streamQueue_;
+        std::priority_queue<TimerEntry, std::vector<TimerEntry>, std::greater<>> timers_;
+        uint64_t nextSequence_ = 0;
+        bool stopping_ = false;
+
+        std::vector<std::thread> workers_;
+
+        std::atomic<uint64_t> threadsCreated_{0};
+        std::atomic<uint64_t> uiTasksRun_{0};
+        std::atomic<uint64_t> backgroundTasksRun_{0};
+        std::atomic<uint64_t> streamTasksRun_{0};
+        std::atomic<uint64_t> totalDispatchMicros_{0};
+        std::atomic<uint64_t> maxDispatchMicros_{0};
+    };
+
+    /**
+     * @brief Shared plugin-wide scheduler
+     */
+    TaskScheduler& GetScheduler();
+
+}  // namespace SkyrimNetUI::Scheduler
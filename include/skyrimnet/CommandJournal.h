@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SkyrimNetUI::SkyrimNet {
+
+    /**
+     * @brief A setting change waiting for the server
+     */
+    struct JournalCommand {
+        std::string key;        ///< Unique across sessions; sent as the Idempotency-Key of the request
+        std::string name;       ///< Setting, e.g. "gamemaster.enabled"
+        bool value = false;     ///< Value to set
+        bool baseline = false;  ///< Value the server had before the first of the collapsed commands
+    };
+
+    /**
+     * @brief Append-only file of commands that couldn't be sent yet
+     *
+     * Each queued command and each completion is one line, flushed to disk before the call
+     * returns, so a crash loses nothing that was queued:
+     *
+     *     Q <key> <name> <value> <baseline>
+     *     D <key>
+     *
+     * A command for the same setting as the last pending one replaces it; if the two cancel
+     * out (the value is back at the baseline) neither is sent. Opening the journal drops a
+     * torn last line and rewrites the file with only the pending commands.
+     */
+    class CommandJournal {
+    public:
+        /// Outcome of Queue
+        enum class QueueResult : uint8_t {
+            Queued,       ///< Written as a pending command
+            Cancelled,    ///< Back at the baseline, undoing any pending command; nothing is left to send
+            WriteFailed,  ///< The journal couldn't be written; the pending commands are unchanged
+        };
+
+        struct Stats {
+            uint64_t queued = 0;         ///< Commands written
+            uint64_t collapsed = 0;      ///< Commands replaced by a later one for the same setting
+            uint64_t completed = 0;      ///< Commands marked done
+            uint64_t writeFailures = 0;  ///< Lines that couldn't be written
+        };
+
+        /// Load the pending commands from path, creating its directory if needed
+        explicit CommandJournal(std::filesystem::path path);
+
+        CommandJournal(const CommandJournal&) = delete;
+        CommandJournal& operator=(const CommandJournal&) = delete;
+
+        /**
+         * @brief Queue setting name to value
+         * @param baseline The server's value, used if no command for name is pending
+         */
+        [[nodiscard]] QueueResult Queue(std::string_view name, bool value, bool baseline);
+
+        /// Record that the command was applied (or found already applied)
+        void MarkDone(std::string_view key);
+
+        /// @return Pending commands, oldest first
+        std::vector<JournalCommand> GetPending() const;
+
+        /// @return Value of the last pending command for name
+        std::optional<bool> GetPendingValue(std::string_view name) const;
+
+        bool HasPending() const;
+
+        Stats GetStats() const;
+
+        const std::filesystem::path& GetPath() const noexcept { return path_; }
+
+    private:
+        void Load();
+        bool Append(const std::string& line);
+        std::string NextKey();
+
+        const std::filesystem::path path_;
+        mutable std::mutex mutex_;
+        std::vector<JournalCommand> pending_;
+        uint64_t nextKey_ = 0;
+        Stats stats_;
+    };
+
+}  // namespace SkyrimNetUI::SkyrimNet
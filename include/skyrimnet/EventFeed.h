@@ -0,0 +1,163 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "http/HttpClient.h"
+#include "http/Transport.h"
+#include "scheduler/TaskScheduler.h"
+#include "skyrimnet/ServerSettings.h"
+
+namespace SkyrimNetUI::SkyrimNet {
+
+    /**
+     * @brief One event from the server's event stream
+     */
+    struct FeedEvent {
+        uint64_t sequence = 0;  ///< Assigned on arrival, without gaps; a gap on the reader's side means overwrites
+        std::string type;       ///< SSE event name, e.g. "dialogue", "gamemaster" or "error"
+        std::string data;       ///< Event data as sent, usually JSON
+    };
+
+    /**
+     * @brief Fixed-capacity lock-free queue of the newest events
+     *
+     * A bounded MPMC queue with a sequence number per slot. When it is full, Push drops the
+     * oldest event to make room, so readers that fall behind (e.g. while the view is hidden)
+     * find the most recent events rather than the first ones. Neither side ever blocks.
+     */
+    class EventRing {
+    public:
+        /// @param capacity Rounded up to a power of two, at least 2
+        explicit EventRing(size_t capacity);
+
+        EventRing(const EventRing&) = delete;
+        EventRing& operator=(const EventRing&) = delete;
+
+        /// Add an event, dropping the oldest one if the ring is full
+        void Push(FeedEvent event);
+
+        /// @return false if the ring is empty
+        bool Pop(FeedEvent& event);
+
+        /// Move up to max of the oldest events to out
+        size_t Drain(std::vector<FeedEvent>& out, size_t max);
+
+        [[nodiscard]] size_t Capacity() const noexcept { return mask_ + 1; }
+
+        /// @return Events dropped to make room for newer ones
+        [[nodiscard]] uint64_t Overwritten() const noexcept { return overwritten_.load(std::memory_order_relaxed); }
+
+    private:
+        struct Slot {
+            std::atomic<uint64_t> sequence{0};
+            FeedEvent event;
+        };
+
+        bool TryPush(FeedEvent& event);
+
+        const size_t mask_;
+        std::unique_ptr<Slot[]> slots_;
+        alignas(64) std::atomic<uint64_t> head_{0};  ///< Next position to write
+        alignas(64) std::atomic<uint64_t> tail_{0};  ///< Next position to read
+        std::atomic<uint64_t> overwritten_{0};
+    };
+
+    /**
+     * @brief Subscribes to the SkyrimNet event stream
+     *
+     * Keeps one text/event-stream request open on a stream worker and parses dialogue
+     * lines, GameMaster actions, errors and whatever else the server sends into an EventRing.
+     * A reconnect sends the last event id so the server can resume where it left off. Failed
+     * connections are retried with the server settings' backoff, so a server that is down
+     * costs a request a minute rather than one every few seconds; Reconnect cuts the wait
+     * short once something else has seen the server come back. If
+     * the server answers the stream with a non-event-stream response, the feed stays off
+     * until the next Start.
+     */
+    class EventFeed {
+    public:
+        static constexpr size_t kDefaultCapacity = 1024;
+
+        explicit EventFeed(Http::Transport& transport = Http::GetDefaultTransport(), ServerSettings settings = {},
+                           size_t capacity = kDefaultCapacity);
+        /// Stops without waiting, as workers may already be gone at static destruction; see Shutdown
+        ~EventFeed();
+
+        EventFeed(const EventFeed&) = delete;
+        EventFeed& operator=(const EventFeed&) = delete;
+
+        /**
+         * @brief Connect on a stream worker and reconnect whenever the stream ends
+         * Buffered events are kept across Stop/Start.
+         */
+        void Start();
+
+        /**
+         * @brief Close the stream, cancelling the request in flight
+         */
+        void Stop();
+
+        /**
+         * @brief Stop and wait until a connection still being torn down has returned
+         * Call before the feed is destroyed while the scheduler is running.
+         */
+        void Shutdown();
+
+        /**
+         * @brief Connect now if the feed is waiting out a failed connection
+         * For when the server is known to be back, e.g. from the health monitor.
+         */
+        void Reconnect();
+
+        /**
+         * @brief Take up to max buffered events, oldest first
+         * Safe to call from any thread while the stream is running.
+         */
+        std::vector<FeedEvent> TakeBatch(size_t max);
+
+        /**
+         * @brief Stream counters
+         */
+        struct Stats {
+            uint64_t connects = 0;     ///< Stream requests sent
+            uint64_t received = 0;     ///< Events parsed from the stream
+            uint64_t overwritten = 0;  ///< Events dropped from a full ring before anyone took them
+            uint64_t taken = 0;        ///< Events handed out by TakeBatch
+        };
+
+        Stats GetStats() const noexcept;
+
+    private:
+        void Run(uint64_t session);
+        bool IsCurrentSession(uint64_t session) const noexcept;
+        void Schedule(uint64_t session, std::chrono::milliseconds delay);
+        void ScheduleLocked(uint64_t session, std::chrono::milliseconds delay);
+
+        Http::Transport& transport_;
+        const ServerSettings settings_;
+        const std::string eventsUrl_;
+        EventRing ring_;
+        std::atomic<uint64_t> nextSequence_{1};
+        std::atomic<bool> active_{false};
+        std::atomic<uint64_t> session_{0};  ///< Bumped by Start; tasks from older sessions exit
+        std::mutex taskMutex_;              ///< Guards the task handle and lastEventId_
+        std::string lastEventId_;           ///< Sent as Last-Event-ID when reconnecting
+        Scheduler::TaskHandle task_;
+        Http::CancelToken cancel_;
+        Http::CircuitBreaker breaker_;  ///< Paces reconnects after failed connections
+        std::atomic<uint64_t> connects_{0};
+        std::atomic<uint64_t> received_{0};
+        std::atomic<uint64_t> taken_{0};
+    };
+
+    // Global singleton instance, using the controller's server settings and [Events] BufferSize
+    EventFeed& GetEventFeed();
+
+}  // namespace SkyrimNetUI::SkyrimNet
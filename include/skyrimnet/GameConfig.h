@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "http/ConditionalCache.h"
+#include "http/HttpClient.h"
+#include "http/Transport.h"
+#include "skyrimnet/ServerSettings.h"
+
+namespace SkyrimNetUI::SkyrimNet {
+
+    /**
+     * @brief Typed view of the gamemaster section of the game config
+     */
+    struct GameMasterSettings {
+        bool enabled = false;
+        bool agentEnabled = false;
+    };
+
+    /**
+     * @brief Cached SkyrimNet "game" config with dirty-field updates
+     *
+     * The document is fetched once and then revalidated with conditional GETs, so a
+     * refresh of an unchanged config costs a 304. Setters only mark fields dirty;
+     * Commit() patches them into the cached document and POSTs the full document.
+     * If ServerSettings::patchPath is set, Commit() sends just the dirty fields there
+     * instead, once a re-read of the config has shown that the server applied the first
+     * such update; any other answer switches back to full documents for the session.
+     */
+    class GameConfig {
+    public:
+        /**
+         * @brief Bytes sent by Commit() this session
+         */
+        struct Stats {
+            uint64_t commits = 0;          ///< Successful commits
+            uint64_t partialCommits = 0;   ///< Commits that sent only dirty fields
+            uint64_t bytesSent = 0;        ///< Request body bytes sent by successful commits
+            uint64_t fullBytes = 0;        ///< Bytes the same commits would have sent as full documents
+            uint64_t lastCommitBytes = 0;  ///< Request body size of the most recent commit
+        };
+
+        explicit GameConfig(Http::Transport& transport = Http::GetDefaultTransport(),
+                            const ServerSettings& settings = {});
+        GameConfig(const GameConfig&) = delete;
+        GameConfig& operator=(const GameConfig&) = delete;
+
+        /**
+         * @brief Revalidate the cached document against the server
+         * @return true if a current document is cached
+         */
+        bool Refresh(Http::CancelToken* cancel = nullptr);
+
+        /**
+         * @brief Gamemaster settings including uncommitted changes
+         * @return nullopt until a document with a gamemaster section has been fetched
+         */
+        std::optional<GameMasterSettings> GetGameMaster() const;
+
+        /**
+         * @brief Set gamemaster.enabled and gamemaster.agentEnabled (marks them dirty)
+         */
+        void SetGameMasterEnabled(bool enabled);
+
+        /// @return true if there are uncommitted changes
+        bool IsDirty() const;
+
+        /// Forget uncommitted changes, e.g. ones left by a failed Commit
+        void DiscardChanges();
+
+        /**
+         * @brief Send dirty fields to the server
+         * @param idempotencyKey Sent as the Idempotency-Key header if not empty, so the server
+         *        can recognise a retry of a request it already applied
+         * @return true if the server accepted the update (or nothing was dirty)
+         */
+        bool Commit(Http::CancelToken* cancel = nullptr, std::string_view idempotencyKey = {});
+
+        Stats GetStats() const;
+
+        Http::ConditionalCache::Stats GetCacheStats() const noexcept { return cache_.GetStats(); }
+
+    private:
+        enum DirtyField : uint8_t { kDirtyEnabled = 1 << 0, kDirtyAgentEnabled = 1 << 1 };
+
+        enum class PartialSupport : uint8_t { Unknown, Supported, Unsupported };
+
+        bool ParseGameMaster(std::string_view document);
+        std::string BuildPartialUpdate() const;
+        std::optional<std::string> BuildFullDocument() const;
+        /// @return Whether the server holds the sent fields, or nullopt if it couldn't be asked
+        std::optional<bool> ConfirmPartialUpdate(const GameMasterSettings& sent, uint8_t fields,
+                                                 Http::CancelToken* cancel);
+        void RecordCommit(size_t sentBytes, bool partial);
+
+        Http::Transport& transport_;
+        const Http::Timeouts timeouts_;
+        const std::string getUrl_;
+        const std::string updateUrl_;
+        const std::string patchUrl_;  ///< Empty unless partial updates are configured
+        Http::ConditionalCache cache_;
+
+        mutable std::mutex mutex_;
+        std::string document_;
+        std::optional<GameMasterSettings> gamemaster_;
+        uint8_t dirty_ = 0;
+        Stats stats_;
+
+        std::atomic<PartialSupport> partialSupport_;
+    };
+
+}  // namespace SkyrimNetUI::SkyrimNet
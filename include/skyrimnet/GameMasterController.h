@@ -1,17 +1,42 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
-#include <thread>
+#include <string_view>
+
+#include "http/CircuitBreaker.h"
+#include "http/ConditionalCache.h"
+#include "http/HttpClient.h"
+#include "http/Transport.h"
+#include "scheduler/TaskScheduler.h"
+#include "skyrimnet/CommandJournal.h"
+#include "skyrimnet/GameConfig.h"
+#include "skyrimnet/ServerSettings.h"
 
 namespace SkyrimNetUI::SkyrimNet {
 
+    enum class GameMasterStatus : uint8_t { Disabled, Enabled, Pending };
+
+    /**
+     * @brief Receives status changes; called from scheduler threads
+     */
+    using StatusListener = std::function<void(GameMasterStatus status)>;
+
     /**
      * @brief Manages GameMaster agent status monitoring and control
      */
     class Controller {
     public:
-        Controller();
+        explicit Controller(Http::Transport& transport = Http::GetDefaultTransport(),
+                            ServerSettings settings = {});
+        /// Cancels without waiting, as workers may already be gone at static destruction; see Shutdown
         ~Controller();
 
         // Prevent copying
@@ -20,20 +45,49 @@ namespace SkyrimNetUI::SkyrimNet {
 
         /**
          * @brief Start background polling of GameMaster status
+         * Failed requests are retried with exponential backoff. Once the circuit breaker
+         * opens, only health probes are sent until the server answers again.
          */
         void StartPolling();
 
         /**
          * @brief Stop background polling
+         * Cancels an in-flight status request instead of waiting for its read timeout.
          */
         void StopPolling();
 
+        /**
+         * @brief Stop polling, abort a toggle in flight and wait until their tasks have returned
+         * Call before the controller is destroyed while the scheduler is running.
+         */
+        void Shutdown();
+
         /**
          * @brief Toggle GameMaster enabled state
-         * Retrieves current config, updates gamemaster.enabled and gamemaster.agentEnabled,
-         * then sends complete config back to server
+         * Revalidates the cached config, updates gamemaster.enabled and gamemaster.agentEnabled,
+         * then commits them (see GameConfig::Commit). Blocks for the duration of the requests.
+         * With a journal open, a toggle the server can't take is saved for ReplayJournal, and
+         * toggles made while saved ones are waiting queue up behind them. Saved toggles are
+         * retried on the backoff schedule unless the breaker is open, in which case the
+         * server's recovery triggers the replay.
+         * @return true if the server accepted the updated config or the toggle was saved;
+         *         false on failure (including a journal that couldn't be written) or if another
+         *         toggle is already in flight
          */
-        void Toggle();
+        bool Toggle();
+
+        /**
+         * @brief Toggle GameMaster enabled state on the scheduler's UI lane
+         * Returns immediately after reporting a Pending status; the result is reported
+         * through the status listener. Ignored while a toggle is in flight.
+         * @return true if a toggle was started
+         */
+        bool ToggleAsync();
+
+        /**
+         * @brief Check whether an asynchronous toggle is still running
+         */
+        bool IsTogglePending() const noexcept { return toggleInFlight_.load(); }
 
         /**
          * @brief Get current GameMaster enabled state
@@ -41,18 +95,124 @@ namespace SkyrimNetUI::SkyrimNet {
         bool IsEnabled() const noexcept { return enabled_.load(); }
 
         /**
-         * @brief Update UI with current GameMaster status
+         * @brief Save toggles that can't reach the server in an append-only journal file
+         * Call once, before polling or toggling starts. Toggles saved by an earlier session
+         * are sent by the next ReplayJournal.
+         */
+        void OpenJournal(const std::filesystem::path& file);
+
+        /**
+         * @brief Send saved toggles in order on the scheduler's UI lane, e.g. once the server is back
+         * Toggles the server already reflects (applied before a crash) are only marked done.
+         * Ignored while a toggle is in flight. If the server doesn't take them, the status
+         * shown is Pending until it does, and another attempt is scheduled.
+         * @return true if a replay was started
+         */
+        bool ReplayJournal();
+
+        /// @return The journal opened by OpenJournal, if any
+        const CommandJournal* GetJournal() const noexcept { return journal_.get(); }
+
+        /**
+         * @brief Set the receiver of status changes (replaces the previous one)
+         */
+        void SetStatusListener(StatusListener listener);
+
+        /**
+         * @brief Prefer the server's status event stream over interval polling
+         * Falls back to polling automatically when the server doesn't offer the stream.
+         * Takes effect the next time polling starts.
+         */
+        void SetPushEnabled(bool enabled) noexcept { pushEnabled_.store(enabled); }
+
+        /**
+         * @brief Status traffic counters
+         */
+        struct StatusStats {
+            uint64_t requests = 0;    ///< Status GETs and stream connects issued
+            uint64_t pushEvents = 0;  ///< Status events received over the stream
+            bool pushActive = false;  ///< Push is enabled and the server hasn't rejected it
+        };
+
+        StatusStats GetStatusStats() const noexcept {
+            return {statusRequests_.load(std::memory_order_relaxed), pushEvents_.load(std::memory_order_relaxed),
+                    pushEnabled_.load() && !pushUnsupported_.load()};
+        }
+
+        /**
+         * @brief Conditional-request savings for the status and config fetches this session
+         */
+        Http::ConditionalCache::Stats GetCacheStats() const noexcept {
+            const auto status = statusCache_.GetStats();
+            const auto config = config_.GetCacheStats();
+            return {status.notModified + config.notModified, status.unchanged + config.unchanged,
+                    status.bytesAvoided + config.bytesAvoided};
+        }
+
+        const ServerSettings& GetServerSettings() const noexcept { return settings_; }
+
+        /**
+         * @brief Failure and circuit breaker counters for status requests
+         */
+        Http::CircuitBreaker::Stats GetBreakerStats() const { return breaker_.GetStats(); }
+
+        /**
+         * @brief Cached game config used by Toggle
          */
-        void UpdateUI(bool enabled);
+        const GameConfig& GetConfig() const noexcept { return config_; }
 
     private:
-        void PollStatus();
-        bool ParseStatus(const std::string& jsonResponse);
-        std::string UpdateConfigFields(const std::string& configJson, bool newState);
+        void PollStatus(uint64_t session);
+        void RunPushStream(uint64_t session);
+        void ProbeHealth(uint64_t session);
+        void RetryAfterFailure(uint64_t session);
+        void RecordStatusSuccess();
+        bool FetchStatus();
+        bool ApplyStatus(const std::string& body, uint64_t generation);
+        bool IsCurrentSession(uint64_t session) const noexcept;
+        void Schedule(uint64_t session, std::chrono::milliseconds delay, Scheduler::Task task,
+                      Scheduler::Lane lane = Scheduler::Lane::Background);
+        void ScheduleLocked(uint64_t session, std::chrono::milliseconds delay, Scheduler::Task task,
+                            Scheduler::Lane lane = Scheduler::Lane::Background);
+        void ScheduleStatus(uint64_t session, std::chrono::milliseconds delay);
+        void ScheduleStatusLocked(uint64_t session, std::chrono::milliseconds delay);
+        bool ParseStatus(std::string_view jsonResponse);
+        bool RunToggle();
+        bool RunReplay();
+        bool SaveToggle(bool enabled);
+        void ScheduleReplay();
+        void ReportReplayFailed();
+        void ReportServerState(bool expected);
+        void Notify(GameMasterStatus status);
 
+        Http::Transport& transport_;
+        const ServerSettings settings_;
+        const std::string statusUrl_;
+        const std::string eventsUrl_;
+        const std::string healthUrl_;
+        Http::CircuitBreaker breaker_;
+        std::mutex listenerMutex_;
+        StatusListener listener_;
         std::atomic<bool> enabled_{false};
         std::atomic<bool> pollingActive_{false};
-        std::thread pollingThread_;
+        std::atomic<uint64_t> pollSession_{0};  ///< Bumped by StartPolling; tasks from older sessions exit
+        std::mutex pollMutex_;                  ///< Guards the task handles
+        Scheduler::TaskHandle pollTask_;
+        Http::CancelToken pollCancel_;
+        std::atomic<bool> pushEnabled_{true};
+        std::atomic<bool> pushUnsupported_{false};
+        std::atomic<uint64_t> statusRequests_{0};
+        std::atomic<uint64_t> pushEvents_{0};
+        Http::ConditionalCache statusCache_;
+        GameConfig config_;
+        std::atomic<bool> toggleInFlight_{false};
+        std::atomic<uint64_t> toggleGeneration_{0};
+        Scheduler::TaskHandle toggleTask_;
+        Scheduler::TaskHandle replayTask_;  ///< Next attempt at sending saved toggles
+        Http::CancelToken toggleCancel_;
+        std::unique_ptr<CommandJournal> journal_;  ///< Set once by OpenJournal
+        Http::CircuitBreaker replayBackoff_;       ///< Paces replay attempts; only its delays are used
+        std::atomic<bool> replayFailed_{false};    ///< The server turned saved toggles down since the last success
     };
 
     // Global singleton instance
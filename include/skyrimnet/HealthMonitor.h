@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "http/HttpClient.h"
+#include "http/Transport.h"
+#include "scheduler/TaskScheduler.h"
+#include "skyrimnet/ServerSettings.h"
+
+namespace SkyrimNetUI::SkyrimNet {
+
+    enum class ServerHealth : uint8_t { Unknown, Up, Down };
+
+    /**
+     * @brief Receives reachability changes; called from scheduler threads
+     */
+    using HealthListener = std::function<void(bool reachable)>;
+
+    /**
+     * @brief Watches whether the SkyrimNet server answers at all
+     *
+     * Sends a HEAD request for the configured monitor path on a schedule: often while the
+     * server is down, rarely once it is up. Any HTTP answer counts as up. The listener only
+     * hears about transitions, starting with the first probe's result.
+     */
+    class HealthMonitor {
+    public:
+        /// Consecutive failed probes before an up server is reported down
+        static constexpr uint32_t kFailuresBeforeDown = 2;
+
+        explicit HealthMonitor(Http::Transport& transport = Http::GetDefaultTransport(),
+                               ServerSettings settings = {});
+        /// Stops without waiting, as workers may already be gone at static destruction; see Shutdown
+        ~HealthMonitor();
+
+        HealthMonitor(const HealthMonitor&) = delete;
+        HealthMonitor& operator=(const HealthMonitor&) = delete;
+
+        /**
+         * @brief Probe now and then on the monitor interval
+         * The last known health is kept across Stop/Start, so a restart only reports changes.
+         */
+        void Start();
+
+        /**
+         * @brief Stop probing, cancelling a probe in flight
+         */
+        void Stop();
+
+        /**
+         * @brief Stop and wait until a probe still running has returned
+         * Call before the monitor is destroyed while the scheduler is running.
+         */
+        void Shutdown();
+
+        /**
+         * @brief Set the receiver of reachability changes (replaces the previous one)
+         */
+        void SetListener(HealthListener listener);
+
+        ServerHealth GetHealth() const noexcept { return health_.load(); }
+
+        /**
+         * @brief Probe counters
+         */
+        struct Stats {
+            uint64_t probes = 0;       ///< HEAD requests sent
+            uint64_t transitions = 0;  ///< Up/down changes reported
+        };
+
+        Stats GetStats() const noexcept {
+            return {probes_.load(std::memory_order_relaxed), transitions_.load(std::memory_order_relaxed)};
+        }
+
+    private:
+        void Probe(uint64_t session);
+        void Report(bool reachable);
+        bool IsCurrentSession(uint64_t session) const noexcept;
+        void ScheduleLocked(uint64_t session, std::chrono::milliseconds delay);
+
+        Http::Transport& transport_;
+        const ServerSettings settings_;
+        const std::string monitorUrl_;
+        std::atomic<ServerHealth> health_{ServerHealth::Unknown};
+        uint32_t consecutiveFailures_ = 0;  ///< Only touched by the probe task
+        std::mutex listenerMutex_;
+        HealthListener listener_;
+        std::atomic<bool> active_{false};
+        std::atomic<uint64_t> session_{0};  ///< Bumped by Start; probes from older sessions exit
+        std::mutex taskMutex_;              ///< Guards the task handle
+        Scheduler::TaskHandle task_;
+        Http::CancelToken cancel_;
+        std::atomic<uint64_t> probes_{0};
+        std::atomic<uint64_t> transitions_{0};
+    };
+
+    // Global singleton instance, using the controller's server settings
+    HealthMonitor& GetHealthMonitor();
+
+}  // namespace SkyrimNetUI::SkyrimNet
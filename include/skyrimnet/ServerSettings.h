@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include "config/IniFile.h"
+#include "http/CircuitBreaker.h"
+#include "http/HttpClient.h"
+#include "http/Transport.h"
+
+namespace SkyrimNetUI::SkyrimNet {
+
+    /**
+     * @brief Where the SkyrimNet server is and how patiently to talk to it
+     * Read from the [Server] and [Polling] sections of the settings file.
+     */
+    struct ServerSettings {
+        std::string baseUrl{Http::kDefaultBaseUrl};  ///< Server root without a trailing slash
+
+        Http::Timeouts statusTimeouts{std::chrono::seconds(2), std::chrono::seconds(5)};
+        Http::Timeouts configTimeouts{std::chrono::seconds(2), std::chrono::seconds(15)};
+        Http::Timeouts eventsTimeouts{std::chrono::seconds(2), std::chrono::seconds(60)};
+        Http::Timeouts healthTimeouts{std::chrono::seconds(1), std::chrono::seconds(2)};
+
+        std::string healthPath = "/?api=gamemaster-status";  ///< Probed while the breaker is open
+        std::string monitorPath = "/config";                 ///< Requested with HEAD by the health monitor
+        std::string eventsPath = "/?api=events";             ///< Event stream for the overlay's live events
+        std::string statusPath = "/?api=gamemaster-status";        ///< Polled GameMaster status
+        std::string statusEventsPath = "/?api=gamemaster-events";  ///< Pushed GameMaster status changes
+        std::string patchPath;  ///< Endpoint for partial config updates; empty sends full documents
+
+        /// Status reads reuse a response this fresh, or join an identical request in flight
+        std::chrono::milliseconds statusMaxAge{std::chrono::seconds(1)};
+
+        std::chrono::milliseconds pollInterval{std::chrono::seconds(5)};
+        Http::BackoffPolicy backoff;  ///< Starts at pollInterval
+
+        std::chrono::milliseconds monitorDownInterval{std::chrono::seconds(2)};  ///< Health checks while down
+        std::chrono::milliseconds monitorUpInterval{std::chrono::seconds(15)};   ///< Health checks while up
+
+        /// Missing or invalid values keep their defaults
+        static ServerSettings Load(const Config::IniFile& settings);
+    };
+
+}  // namespace SkyrimNetUI::SkyrimNet
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "PrismaUI_API.h"
+#include "msgpack/MsgPack.h"
+#include "ui/InteropDispatcher.h"
+
+namespace SkyrimNetUI::UI {
+
+    /**
+     * @brief Name and version of a channel message
+     * Names use [a-z0-9._-]. Bump the version when the payload layout changes.
+     */
+    struct MessageType {
+        std::string_view name;
+        uint16_t version = 1;
+    };
+
+    /// Standard base64 with padding
+    std::string Base64Encode(std::string_view bytes);
+
+    /// @return Decoded bytes, or nullopt if text isn't padded base64
+    std::optional<std::string> Base64Decode(std::string_view text);
+
+    /**
+     * @brief Framed MessagePack messages between C++ and the view
+     *
+     * InteropCall and JS listeners carry one string, so structured data used to travel as
+     * hand-built JSON. A channel message is a MessagePack payload, base64 encoded and cut
+     * into frames of at most frameSize characters:
+     *
+     *     name|version|id|index|count|base64 chunk
+     *
+     * Frames to the view are batched into one Invoke of interopReceive([...]) per flush, and
+     * a flush sends at most kMaxFlushBytes so a large message is spread over several game
+     * frames. The view sends its frames to the interopFrame listener (see view/interop.js).
+     *
+     * A handler is registered with the newest version it understands; newer messages are
+     * rejected, older ones are passed on with their version so the handler can adapt.
+     */
+    class InteropChannel {
+    public:
+        static constexpr size_t kDefaultFrameSize = 32 << 10;
+        static constexpr size_t kMaxFlushBytes = 256 << 10;
+        static constexpr size_t kMaxInboundBytes = 4 << 20;  ///< Largest message accepted from the view
+
+        /// Receives a message's payload and the version it was sent with
+        using Handler = std::function<void(uint16_t version, MsgPack::Reader& payload)>;
+
+        struct Stats {
+            uint64_t messagesSent = 0;
+            uint64_t framesSent = 0;
+            uint64_t bytesSent = 0;  ///< Frame characters handed to Invoke
+            uint64_t invokes = 0;
+            uint64_t messagesReceived = 0;
+            uint64_t framesReceived = 0;
+            uint64_t rejected = 0;  ///< Malformed, out-of-order, oversized or unhandled messages
+        };
+
+        /// @param scheduler Runs flushes on the thread that owns the view; defaults to the SKSE task queue
+        explicit InteropChannel(InteropDispatcher::FlushScheduler scheduler = {}, size_t frameSize = kDefaultFrameSize);
+
+        InteropChannel(const InteropChannel&) = delete;
+        InteropChannel& operator=(const InteropChannel&) = delete;
+
+        /**
+         * @brief Set the API and view that frames are sent to
+         * Pass nullptr to detach; pending frames are kept until the next Attach.
+         */
+        void Attach(PRISMA_UI_API::IVPrismaUI1* api, PrismaView view);
+
+        /// Queue a message with a MessagePack payload
+        void Send(MessageType type, std::string_view payload);
+
+        void Send(MessageType type, const MsgPack::Writer& payload) { Send(type, payload.Data()); }
+
+        /// Handle messages of type.name up to type.version; replaces an earlier handler
+        void On(MessageType type, Handler handler);
+
+        /**
+         * @brief Take a frame sent by the view
+         * The handler runs on the calling thread once the message's last frame arrives.
+         */
+        void Receive(std::string_view frame);
+
+        /**
+         * @brief Drop pending frames and partly received messages, e.g. after the DOM was reloaded
+         */
+        void Reset();
+
+        /**
+         * @brief Send pending frames, up to kMaxFlushBytes, as one script
+         * @return Number of frames sent
+         */
+        size_t Flush();
+
+        Stats GetStats() const;
+
+        /**
+         * @brief Cut a payload into frames
+         * @param frameSize Largest frame in characters; chunks are a multiple of 4 base64 characters
+         */
+        static std::vector<std::string> MakeFrames(MessageType type, uint32_t id, std::string_view payload,
+                                                   size_t frameSize);
+
+    private:
+        struct Registration {
+            uint16_t version = 0;
+            Handler handler;
+        };
+
+        struct Partial {
+            uint16_t version = 0;
+            uint32_t next = 0;  ///< Index of the frame expected next
+            uint32_t count = 0;
+            std::string base64;
+        };
+
+        void ScheduleFlush();
+
+        InteropDispatcher::FlushScheduler scheduler_;
+        const size_t frameSize_;
+
+        mutable std::mutex mutex_;
+        PRISMA_UI_API::IVPrismaUI1* api_ = nullptr;
+        PrismaView view_ = 0;
+        std::deque<std::string> pending_;
+        bool flushScheduled_ = false;
+        uint32_t nextId_ = 0;
+        std::unordered_map<std::string, Registration> handlers_;
+        std::unordered_map<std::string, Partial> partials_;  ///< Keyed by name|id
+        Stats stats_;
+    };
+
+    /**
+     * @brief Channel of the main SkyrimNet view
+     */
+    InteropChannel& GetChannel();
+
+}  // namespace SkyrimNetUI::UI
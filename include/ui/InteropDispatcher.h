@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "PrismaUI_API.h"
+
+namespace SkyrimNetUI::UI {
+
+    /**
+     * @brief Batches C++ to JS interop calls
+     *
+     * Calls are queued instead of sent immediately. Repeated calls to the same function
+     * before a flush keep only the latest argument, and calls whose argument matches
+     * what the view already shows are dropped. The first queued call schedules a flush
+     * for the next frame, which sends everything pending as a single Invoke script.
+     * Nothing is sent until the view's DOM is ready, since the page's functions don't exist before.
+     */
+    class InteropDispatcher {
+    public:
+        /**
+         * @brief Call counters since construction
+         */
+        struct Stats {
+            uint64_t queued = 0;     ///< Queue() calls
+            uint64_t issued = 0;     ///< Calls delivered to the view
+            uint64_t coalesced = 0;  ///< Calls replaced by a later call to the same function
+            uint64_t dropped = 0;    ///< Calls skipped because the view already had that value
+            uint64_t invokes = 0;    ///< Batched Invoke scripts sent
+        };
+
+        /// Runs a flush on the thread that owns the view
+        using FlushScheduler = std::function<void(std::function<void()>)>;
+
+        /// @param scheduler Defaults to the SKSE task queue (next game frame)
+        explicit InteropDispatcher(FlushScheduler scheduler = {});
+
+        InteropDispatcher(const InteropDispatcher&) = delete;
+        InteropDispatcher& operator=(const InteropDispatcher&) = delete;
+
+        /**
+         * @brief Set the API and view that flushes are sent to
+         * Pass nullptr to detach; pending calls are kept until the next Attach. Calls to
+         * another view are held until MarkDomReady.
+         */
+        void Attach(PRISMA_UI_API::IVPrismaUI1* api, PrismaView view);
+
+        /**
+         * @brief Let flushes reach the attached view; call from its DOM-ready callback
+         * Schedules a flush of the calls held while the page loaded.
+         */
+        void MarkDomReady();
+
+        /**
+         * @brief Queue a call of functionName(argument) in the view
+         */
+        void Queue(std::string_view functionName, std::string_view argument);
+
+        /**
+         * @brief Forget what the view is showing, e.g. after its DOM was reloaded
+         */
+        void Reset();
+
+        /**
+         * @brief Send all pending calls now as one script
+         * @return Number of calls sent
+         */
+        size_t Flush();
+
+        Stats GetStats() const;
+
+    private:
+        void ScheduleFlushLocked();
+
+        FlushScheduler scheduler_;
+
+        mutable std::mutex mutex_;
+        PRISMA_UI_API::IVPrismaUI1* api_ = nullptr;
+        PrismaView view_ = 0;
+        bool domReady_ = false;
+        std::vector<std::pair<std::string, std::string>> pending_;  ///< In first-queued order
+        std::unordered_map<std::string, std::string> delivered_;    ///< Last argument sent per function
+        bool flushScheduled_ = false;
+        Stats stats_;
+    };
+
+    /**
+     * @brief Dispatcher for the main SkyrimNet view
+     */
+    InteropDispatcher& GetDispatcher();
+
+}  // namespace SkyrimNetUI::UI
@@ -25,13 +25,18 @@ namespace SkyrimNetUI::UI {
      */
     void UpdateGameMasterStatus(bool enabled);
 
+    /**
+     * @brief Show the GameMaster status indicator as pending while a toggle is in flight
+     */
+    void UpdateGameMasterPending();
+
     /**
      * @brief Get the current PrismaUI view handle
      */
     PrismaView GetView();
 
     /**
-     * @brief Check if UI has focus
+     * @brief Check if the UI or one of its panels has focus
      */
     bool HasFocus();
 
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "PrismaUI_API.h"
+#include "ui/InteropDispatcher.h"
+
+namespace SkyrimNetUI::UI {
+
+    /**
+     * @brief An overlay panel shown in its own PrismaUI view
+     */
+    struct PanelSpec {
+        std::string htmlPath;  ///< Page of a dedicated view; empty to mount url into a pooled host view
+        std::string url;       ///< Loaded by the host page (pooled panels only)
+        int order = 0;         ///< Base z-order; among equal orders the most recently opened panel is on top
+    };
+
+    /**
+     * @brief Receives a JS listener call for a panel; called on PrismaUI's thread
+     */
+    using PanelListener = std::function<void(std::string_view argument)>;
+
+    /**
+     * @brief Called when a panel's view is ready to take interop calls
+     * For pooled panels this runs on every assignment, as the host page is already loaded.
+     */
+    using PanelReadyHandler = std::function<void(PrismaView view)>;
+
+    /**
+     * @brief Owns the plugin's PrismaUI views
+     *
+     * Panels are defined by name. A dedicated panel gets its own view on first use. Pooled
+     * panels are mounted into host views (kPanelHostPath) that are created hidden ahead of
+     * time by Prewarm and handed back to the pool by Release. When the pool is empty the
+     * least recently opened closed panel gives up its view before a new one is created, so
+     * switching panels normally costs an interop call instead of a CreateView.
+     *
+     * PrismaUI callbacks are plain function pointers, so DOM-ready and JS listener calls
+     * are routed to the global instance (GetViewManager) through per-view trampolines.
+     * Call from the game thread; listener and ready handlers run on PrismaUI's thread.
+     */
+    class ViewManager {
+    public:
+        static constexpr size_t kMaxViews = 8;
+        static constexpr size_t kMaxListenersPerView = 16;
+        static constexpr const char* kPanelHostPath = "PrismaUI-SkyrimNet-UI/panel.html";
+
+        /**
+         * @brief Creation cost and use of one view
+         */
+        struct ViewStats {
+            PrismaView view = 0;
+            std::string panel;          ///< Assigned panel (empty while pooled)
+            uint64_t createMicros = 0;  ///< Time spent in CreateView
+            uint64_t loadMicros = 0;    ///< CreateView to DOM ready (0 while loading)
+            int64_t privateBytes = 0;   ///< Growth of process private memory from CreateView to DOM ready
+            uint64_t assignments = 0;   ///< Panels assigned to this view
+        };
+
+        struct Stats {
+            uint64_t created = 0;   ///< CreateView calls
+            uint64_t reused = 0;    ///< Panels given an existing pooled or reclaimed view
+            uint64_t failures = 0;  ///< Panels that couldn't get a view
+            std::vector<ViewStats> views;
+        };
+
+        ViewManager() = default;
+
+        ViewManager(const ViewManager&) = delete;
+        ViewManager& operator=(const ViewManager&) = delete;
+
+        /**
+         * @brief Set the API used to create and drive views (nullptr detaches)
+         * @param scheduler Runs interop flushes of views created from now on; defaults to the SKSE task queue
+         */
+        void Attach(PRISMA_UI_API::IVPrismaUI1* api, InteropDispatcher::FlushScheduler scheduler = {});
+
+        /**
+         * @brief Define or redefine a panel; takes effect the next time it gets a view
+         */
+        void Define(std::string name, PanelSpec spec);
+
+        /**
+         * @brief Handle calls to window[jsFunction] from the panel's view
+         * Registered on whichever view the panel gets, now or later.
+         */
+        void AddListener(std::string_view panel, std::string jsFunction, PanelListener listener);
+
+        void SetReadyHandler(std::string_view panel, PanelReadyHandler handler);
+
+        /**
+         * @brief Create hidden host views until count are pooled
+         */
+        void Prewarm(size_t count);
+
+        /**
+         * @brief Give the panel a view if it has none, without showing it
+         * @return View handle, or 0 if no view could be created
+         */
+        PrismaView Acquire(std::string_view panel);
+
+        /**
+         * @brief Show the panel above the others, acquiring a view if needed
+         * @param focus Also give the view input focus (pausing the game)
+         */
+        bool Open(std::string_view panel, bool focus = true);
+
+        /**
+         * @brief Hide the panel; it keeps its view until the view is needed elsewhere
+         */
+        void Close(std::string_view panel);
+
+        /**
+         * @brief Hide the panel and return its view to the pool (dedicated views are kept)
+         */
+        void Release(std::string_view panel);
+
+        /**
+         * @brief Close every open panel
+         */
+        void CloseAll();
+
+        /// @return Whether any of the manager's views has input focus
+        [[nodiscard]] bool HasFocus() const;
+
+        /// @return The panel's view, or 0 if it has none
+        [[nodiscard]] PrismaView GetView(std::string_view panel) const;
+
+        /// @return Names of the pooled panels, in definition order
+        [[nodiscard]] std::vector<std::string> GetPooledPanels() const;
+
+        /**
+         * @brief Interop dispatcher of the panel's current view, or nullptr if it has none
+         * The main view keeps using the global GetDispatcher().
+         */
+        [[nodiscard]] InteropDispatcher* GetDispatcher(std::string_view panel);
+
+        Stats GetStats() const;
+
+        /// @return {"created":..,"reused":..,"views":[{"panel":..,"createUs":..,"loadUs":..,"privateBytes":..},..]}
+        std::string StatsToJson() const;
+
+        /**
+         * @brief Destroy every view and forget the panels
+         */
+        void Shutdown();
+
+        /// Trampoline entry points; not for direct use
+        void HandleDomReady(PrismaView view);
+        void HandleListener(size_t slot, size_t index, const char* argument);
+
+    private:
+        struct Panel {
+            PanelSpec spec;
+            std::vector<std::pair<std::string, PanelListener>> listeners;
+            PanelReadyHandler ready;
+            size_t slot = kMaxViews;  ///< kMaxViews = no view
+            uint64_t lastOpened = 0;
+            bool open = false;
+        };
+
+        struct Slot {
+            PrismaView view = 0;
+            bool pooled = false;  ///< Host view that can be reassigned
+            std::string panel;    ///< Assigned panel (empty while pooled)
+            bool domReady = false;
+            std::vector<std::string> registeredListeners;  ///< Index = trampoline index
+            std::unique_ptr<InteropDispatcher> dispatcher;
+            std::chrono::steady_clock::time_point created;
+            uint64_t privateBytesAtCreate = 0;
+            ViewStats stats;
+        };
+
+        size_t CreateSlotLocked(const std::string& htmlPath, bool pooled);
+        size_t FindFreeSlotLocked(std::string_view except);
+        void AssignLocked(size_t slot, const std::string& name, Panel& panel);
+        void RegisterListenersLocked(size_t slot, const Panel& panel);
+        Panel* FindPanelLocked(std::string_view name);
+        const Panel* FindPanelLocked(std::string_view name) const;
+        void NotifyReady(size_t slot);
+
+        mutable std::mutex mutex_;
+        PRISMA_UI_API::IVPrismaUI1* api_ = nullptr;
+        InteropDispatcher::FlushScheduler flushScheduler_;
+        std::vector<std::pair<std::string, Panel>> panels_;  ///< In definition order
+        std::array<Slot, kMaxViews> slots_;
+        std::vector<PrismaView> readyBeforeCreated_;  ///< DOM-ready callbacks that beat CreateView's return
+        uint64_t openSequence_ = 0;
+        Stats stats_;
+    };
+
+    /**
+     * @brief Manager for the plugin's views
+     */
+    ViewManager& GetViewManager();
+
+}  // namespace SkyrimNetUI::UI
@@ -0,0 +1,148 @@
+#include "config/IniFile.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+
+#include "pch.h"
+
+namespace SkyrimNetUI::Config {
+
+    namespace {
+        char Lower(char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); }
+
+        std::string_view Trim(std::string_view text) {
+            constexpr std::string_view kSpace = " \t\r\n";
+            const auto first = text.find_first_not_of(kSpace);
+            if (first == std::string_view::npos) {
+                return {};
+            }
+            return text.substr(first, text.find_last_not_of(kSpace) - first + 1);
+        }
+
+        std::string_view Unquote(std::string_view value) {
+            if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+                return value.substr(1, value.size() - 2);
+            }
+            return value;
+        }
+
+        const IniFile::Entries kNoEntries;
+    }
+
+    bool NameLess::operator()(std::string_view lhs, std::string_view rhs) const noexcept {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                                            [](char a, char b) { return Lower(a) < Lower(b); });
+    }
+
+    std::optional<IniFile> IniFile::Load(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return std::nullopt;
+        }
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        return Parse(contents.str());
+    }
+
+    IniFile IniFile::Parse(std::string_view text) {
+        IniFile ini;
+        Entries* section = &ini.sections_[""];
+
+        while (!text.empty()) {
+            const auto end = text.find('\n');
+            std::string_view line = Trim(text.substr(0, end));
+            text = end == std::string_view::npos ? std::string_view{} : text.substr(end + 1);
+
+            if (line.empty() || line.front() == ';' || line.front() == '#') {
+                continue;
+            }
+
+            if (line.front() == '[') {
+                const auto close = line.find(']');
+                if (close != std::string_view::npos) {
+                    section = &ini.sections_[std::string(Trim(line.substr(1, close - 1)))];
+                }
+                continue;
+            }
+
+            const auto equals = line.find('=');
+            if (equals == std::string_view::npos) {
+                continue;
+            }
+
+            auto value = Trim(line.substr(equals + 1));
+            // Trailing comments, unless the value is quoted
+            if (!value.starts_with('"')) {
+                value = Trim(value.substr(0, value.find_first_of(";#")));
+            }
+            section->emplace_back(Trim(line.substr(0, equals)), Unquote(value));
+        }
+        return ini;
+    }
+
+    const IniFile::Entries& IniFile::Section(std::string_view section) const {
+        auto it = sections_.find(section);
+        return it != sections_.end() ? it->second : kNoEntries;
+    }
+
+    std::optional<std::string_view> IniFile::Get(std::string_view section, std::string_view key) const {
+        const auto& entries = Section(section);
+        auto it = std::find_if(entries.rbegin(), entries.rend(), [key](const auto& entry) {
+            return std::ranges::equal(entry.first, key, [](char a, char b) { return Lower(a) == Lower(b); });
+        });
+        if (it == entries.rend()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    bool IniFile::GetBool(std::string_view section, std::string_view key, bool fallback) const {
+        auto value = Get(section, key);
+        if (!value) {
+            return fallback;
+        }
+        std::string lowered(*value);
+        std::transform(lowered.begin(), lowered.end(), lowered.begin(), Lower);
+        if (lowered == "1" || lowered == "true" || lowered == "yes" || lowered == "on") {
+            return true;
+        }
+        if (lowered == "0" || lowered == "false" || lowered == "no" || lowered == "off") {
+            return false;
+        }
+        return fallback;
+    }
+
+    int64_t IniFile::GetInt(std::string_view section, std::string_view key, int64_t fallback) const {
+        auto value = Get(section, key);
+        int64_t result = 0;
+        if (!value || std::from_chars(value->data(), value->data() + value->size(), result).ec != std::errc{}) {
+            return fallback;
+        }
+        return result;
+    }
+
+    double IniFile::GetFloat(std::string_view section, std::string_view key, double fallback) const {
+        auto value = Get(section, key);
+        double result = 0.0;
+        if (!value || std::from_chars(value->data(), value->data() + value->size(), result).ec != std::errc{}) {
+            return fallback;
+        }
+        return result;
+    }
+
+    const IniFile& GetSettings() {
+        static const IniFile settings = []() {
+            if (auto ini = IniFile::Load(kSettingsPath)) {
+                logger::info("Loaded settings from {}", kSettingsPath);
+                return std::move(*ini);
+            }
+            logger::info("No settings file at {}, using defaults", kSettingsPath);
+            return IniFile{};
+        }();
+        return settings;
+    }
+
+}  // namespace SkyrimNetUI::Config
@@ -0,0 +1,272 @@
+#include "http/AssetProxy.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+
+#include "http/ConditionalCache.h"
+#include "logging/Log.h"
+#include "metrics/Metrics.h"
+#include "pch.h"
+
+namespace SkyrimNetUI::Http {
+
+    namespace {
+        constexpr std::array kAssetExtensions = {"js",  "mjs",  "css", "map", "png", "jpg", "jpeg", "gif", "svg",
+                                                 "ico", "webp", "woff", "woff2", "ttf", "otf", "wasm"};
+
+        // Per connection, or describing a body encoding that doesn't survive the proxy
+        constexpr std::array kHopHeaders = {"Connection", "Keep-Alive", "Transfer-Encoding", "Content-Length",
+                                            "Content-Encoding", "Host", "Accept-Encoding", "Upgrade"};
+
+        bool IsHopHeader(std::string_view name) {
+            return std::ranges::any_of(kHopHeaders, [name](std::string_view hop) {
+                return !HeaderNameLess{}(name, hop) && !HeaderNameLess{}(hop, name);
+            });
+        }
+
+        Headers CopyHeaders(const Headers& headers) {
+            Headers result;
+            for (const auto& [name, value] : headers) {
+                if (!IsHopHeader(name)) {
+                    result.emplace(name, value);
+                }
+            }
+            return result;
+        }
+
+        std::string HashTag(std::string_view body) {
+            constexpr char kHex[] = "0123456789abcdef";
+            const uint64_t hash = ConditionalCache::HashBody(body);
+            std::string tag(18, '"');
+            for (int i = 0; i < 16; ++i) {
+                tag[static_cast<size_t>(16 - i)] = kHex[(hash >> (i * 4)) & 0xF];
+            }
+            return tag;
+        }
+
+        constexpr std::string_view kEventStreamType = "text/event-stream";
+
+        Response BadGateway() { return {502, "SkyrimNet server unreachable", {{"Content-Type", "text/plain"}}}; }
+
+        Response NotRelayed() {
+            return {501, "WebSocket connections are not relayed by the asset proxy", {{"Content-Type", "text/plain"}}};
+        }
+    }
+
+    AssetProxy::AssetProxy(Transport& upstream, Settings settings)
+        : upstream_(upstream),
+          settings_(std::move(settings)),
+          cacheControl_("public, max-age=" + std::to_string(settings_.maxAge.count())) {}
+
+    bool AssetProxy::IsAsset(std::string_view target) {
+        target = target.substr(0, target.find_first_of("?#"));
+        const auto slash = target.rfind('/');
+        const auto dot = target.rfind('.');
+        if (dot == std::string_view::npos || (slash != std::string_view::npos && dot < slash)) {
+            return false;
+        }
+        const auto extension = target.substr(dot + 1);
+        return std::ranges::any_of(kAssetExtensions, [extension](std::string_view known) {
+            return std::ranges::equal(extension, known, [](char a, char b) {
+                return std::tolower(static_cast<unsigned char>(a)) == b;
+            });
+        });
+    }
+
+    Response AssetProxy::Handle(const ProxyRequest& request) {
+        {
+            std::lock_guard lock(mutex_);
+            ++stats_.requests;
+        }
+        if ((request.method == "GET" || request.method == "HEAD") && IsAsset(request.target)) {
+            return ServeAsset(request);
+        }
+        return PassThrough(request);
+    }
+
+    bool AssetProxy::WantsEventStream(const ProxyRequest& request) {
+        const auto accept = request.headers.find("Accept");
+        return request.method == "GET" && accept != request.headers.end() &&
+               accept->second.find(kEventStreamType) != std::string::npos;
+    }
+
+    StreamResult AssetProxy::Stream(const ProxyRequest& request, const ChunkHandler& onChunk, CancelToken* cancel) {
+        {
+            std::lock_guard lock(mutex_);
+            ++stats_.requests;
+            ++stats_.streams;
+        }
+        RequestOptions options{
+            .cancel = cancel, .headers = CopyHeaders(request.headers), .timeouts = settings_.streamTimeouts};
+        // Transport::Stream sets its own Accept
+        options.headers.erase("Accept");
+        return upstream_.Stream(settings_.upstream + request.target, kEventStreamType, onChunk, options);
+    }
+
+    Response AssetProxy::PassThrough(const ProxyRequest& request) {
+        {
+            std::lock_guard lock(mutex_);
+            ++stats_.passedThrough;
+        }
+
+        // Upgrade is a hop header and the relay ends with the response, so a WebSocket would
+        // silently turn into a plain request; refuse it where the web UI can see why
+        if (request.headers.contains("Upgrade")) {
+            LOG_WARN(Http, "Proxy can't relay the {} upgrade for {}", request.headers.find("Upgrade")->second,
+                     request.target);
+            return NotRelayed();
+        }
+
+        RequestOptions options{.headers = CopyHeaders(request.headers), .timeouts = settings_.timeouts};
+        const auto url = settings_.upstream + request.target;
+        Response response;
+        if (request.method == "GET") {
+            response = upstream_.Get(url, options);
+        } else if (request.method == "HEAD") {
+            response = upstream_.Head(url, options);
+        } else {
+            // Forms, uploads and JSON alike keep the encoding the view gave them
+            const auto contentType = request.headers.find("Content-Type");
+            options.headers.erase("Content-Type");
+            response = upstream_.Send(request.method, url, request.body,
+                                      contentType != request.headers.end() ? contentType->second : std::string(),
+                                      options);
+        }
+
+        if (!response) {
+            return BadGateway();
+        }
+        response.headers = CopyHeaders(response.headers);
+        std::lock_guard lock(mutex_);
+        stats_.upstreamBytes += response.body.size();
+        stats_.servedBytes += response.body.size();
+        return response;
+    }
+
+    Response AssetProxy::ServeAsset(const ProxyRequest& request) {
+        RequestOptions options{.headers = CopyHeaders(request.headers), .timeouts = settings_.timeouts};
+        // The view's validators are our content hashes, which mean nothing upstream
+        options.headers.erase("If-None-Match");
+        options.headers.erase("If-Modified-Since");
+        bool cached = false;
+        {
+            std::lock_guard lock(mutex_);
+            if (auto it = entries_.find(request.target); it != entries_.end()) {
+                if (std::chrono::steady_clock::now() - it->second.fetched < settings_.maxAge) {
+                    CountHitLocked();
+                    return FromEntryLocked(it->second, request);
+                }
+                cached = true;
+                if (!it->second.upstreamEtag.empty()) {
+                    options.headers.insert_or_assign("If-None-Match", it->second.upstreamEtag);
+                }
+                if (!it->second.lastModified.empty()) {
+                    options.headers.insert_or_assign("If-Modified-Since", it->second.lastModified);
+                }
+            }
+        }
+
+        auto response = upstream_.Get(settings_.upstream + request.target, options);
+
+        std::lock_guard lock(mutex_);
+        auto it = entries_.find(request.target);
+        cached = cached && it != entries_.end();
+        if (cached && response.notModified()) {
+            ++stats_.revalidated;
+            it->second.fetched = std::chrono::steady_clock::now();
+            CountHitLocked();
+            return FromEntryLocked(it->second, request);
+        }
+        if (cached && (!response || response.status >= 500)) {
+            LOG_DEBUG(Http, "Proxy serving stale {} (server answered {})", request.target, response.status);
+            CountHitLocked();
+            return FromEntryLocked(it->second, request);
+        }
+        if (!response) {
+            return BadGateway();
+        }
+
+        stats_.upstreamBytes += response.body.size();
+        if (!response.ok() || response.header("Cache-Control").find("no-store") != std::string_view::npos) {
+            response.headers = CopyHeaders(response.headers);
+            stats_.servedBytes += response.body.size();
+            return response;
+        }
+
+        ++stats_.fetched;
+        Entry entry;
+        entry.etag = HashTag(response.body);
+        entry.contentType = response.header("Content-Type");
+        entry.upstreamEtag = response.header("ETag");
+        entry.lastModified = response.header("Last-Modified");
+        entry.body = std::move(response.body);
+        entry.fetched = std::chrono::steady_clock::now();
+
+        // Answer from the entry just stored, or from a temporary one if it is too big to keep
+        if (auto* stored = StoreLocked(request.target, entry)) {
+            return FromEntryLocked(*stored, request);
+        }
+        return FromEntryLocked(entry, request);
+    }
+
+    void AssetProxy::CountHitLocked() {
+        ++stats_.hits;
+        Metrics::Increment(Metrics::Counter::ProxyHits);
+    }
+
+    Response AssetProxy::FromEntryLocked(Entry& entry, const ProxyRequest& request) {
+        entry.lastUsed = ++useSequence_;
+
+        Response response{200, {}, {{"ETag", entry.etag}, {"Cache-Control", cacheControl_}}};
+        const auto validator = request.headers.find("If-None-Match");
+        if (validator != request.headers.end() && validator->second.find(entry.etag) != std::string::npos) {
+            ++stats_.notModified;
+            response.status = 304;
+            return response;
+        }
+
+        if (!entry.contentType.empty()) {
+            response.headers.emplace("Content-Type", entry.contentType);
+        }
+        if (request.method != "HEAD") {
+            response.body = entry.body;
+            stats_.servedBytes += entry.body.size();
+        }
+        return response;
+    }
+
+    AssetProxy::Entry* AssetProxy::StoreLocked(const std::string& target, Entry& entry) {
+        if (auto it = entries_.find(target); it != entries_.end()) {
+            cachedBytes_ -= it->second.body.size();
+            entries_.erase(it);
+        }
+        if (entry.body.size() > settings_.maxBytes) {
+            return nullptr;
+        }
+
+        while (!entries_.empty() && cachedBytes_ + entry.body.size() > settings_.maxBytes) {
+            auto oldest = std::ranges::min_element(entries_, {}, [](const auto& item) { return item.second.lastUsed; });
+            cachedBytes_ -= oldest->second.body.size();
+            entries_.erase(oldest);
+        }
+
+        cachedBytes_ += entry.body.size();
+        return &entries_.insert_or_assign(target, std::move(entry)).first->second;
+    }
+
+    void AssetProxy::Clear() {
+        std::lock_guard lock(mutex_);
+        entries_.clear();
+        cachedBytes_ = 0;
+    }
+
+    AssetProxy::Stats AssetProxy::GetStats() const {
+        std::lock_guard lock(mutex_);
+        Stats stats = stats_;
+        stats.cachedBytes = cachedBytes_;
+        stats.entries = entries_.size();
+        return stats;
+    }
+
+}  // namespace SkyrimNetUI::Http
@@ -0,0 +1,65 @@
+#include "http/CircuitBreaker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "pch.h"
+
+namespace SkyrimNetUI::Http {
+
+    namespace {
+        double RandomUnit() {
+            thread_local std::minstd_rand engine{std::random_device{}()};
+            return std::uniform_real_distribution<double>(-1.0, 1.0)(engine);
+        }
+    }
+
+    void CircuitBreaker::RecordSuccess() {
+        std::lock_guard lock(mutex_);
+        stats_.consecutiveFailures = 0;
+        stats_.state = State::Closed;
+    }
+
+    void CircuitBreaker::RecordProbeSuccess() {
+        std::lock_guard lock(mutex_);
+        if (stats_.state == State::Open) {
+            stats_.state = State::HalfOpen;
+        }
+    }
+
+    std::chrono::milliseconds CircuitBreaker::RecordFailure() {
+        uint32_t failures = 0;
+        {
+            std::lock_guard lock(mutex_);
+            ++stats_.failures;
+            failures = ++stats_.consecutiveFailures;
+            if (stats_.state == State::HalfOpen) {
+                stats_.state = State::Open;
+            } else if (stats_.state == State::Closed && policy_.openAfter > 0 && failures >= policy_.openAfter) {
+                stats_.state = State::Open;
+                ++stats_.opened;
+            }
+        }
+
+        // Exponent is capped so the power can't overflow before the clamp to max
+        const double growth = std::pow(policy_.multiplier, static_cast<double>(std::min(failures - 1, 32u)));
+        const double base = std::min(static_cast<double>(policy_.initial.count()) * growth,
+                                     static_cast<double>(policy_.max.count()));
+        const double jitter = std::clamp(policy_.jitter, 0.0, 1.0);
+        return std::chrono::milliseconds(static_cast<int64_t>(base * (1.0 + jitter * RandomUnit())));
+    }
+
+    bool CircuitBreaker::IsOpen() const { return GetState() == State::Open; }
+
+    CircuitBreaker::State CircuitBreaker::GetState() const {
+        std::lock_guard lock(mutex_);
+        return stats_.state;
+    }
+
+    CircuitBreaker::Stats CircuitBreaker::GetStats() const {
+        std::lock_guard lock(mutex_);
+        return stats_;
+    }
+
+}  // namespace SkyrimNetUI::Http
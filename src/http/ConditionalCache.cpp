@@ -0,0 +1,79 @@
+#include "http/ConditionalCache.h"
+
+#include "pch.h"
+
+namespace SkyrimNetUI::Http {
+
+    uint64_t ConditionalCache::HashBody(std::string_view body) noexcept {
+        uint64_t hash = 14695981039346656037ull;
+        for (unsigned char c : body) {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    void ConditionalCache::AddValidators(Headers& headers) const {
+        std::lock_guard lock(mutex_);
+        if (!valid_) {
+            return;
+        }
+        if (!etag_.empty()) {
+            headers.insert_or_assign("If-None-Match", etag_);
+        }
+        if (!lastModified_.empty()) {
+            headers.insert_or_assign("If-Modified-Since", lastModified_);
+        }
+    }
+
+    ConditionalCache::Outcome ConditionalCache::Update(const Response& response) {
+        std::lock_guard lock(mutex_);
+
+        if (response.notModified()) {
+            if (!valid_) {
+                // A 304 we didn't ask for; nothing cached to fall back on
+                return Outcome::Error;
+            }
+            notModified_.fetch_add(1, std::memory_order_relaxed);
+            bytesAvoided_.fetch_add(bodySize_, std::memory_order_relaxed);
+            return Outcome::NotModified;
+        }
+
+        if (!response.ok()) {
+            return Outcome::Error;
+        }
+
+        etag_ = response.header("ETag");
+        lastModified_ = response.header("Last-Modified");
+
+        const uint64_t hash = HashBody(response.body);
+        if (valid_ && hash == bodyHash_ && response.body.size() == bodySize_) {
+            unchanged_.fetch_add(1, std::memory_order_relaxed);
+            return Outcome::Unchanged;
+        }
+
+        bodyHash_ = hash;
+        bodySize_ = response.body.size();
+        if (keepBody_) {
+            body_ = response.body;
+        }
+        valid_ = true;
+        return Outcome::Changed;
+    }
+
+    void ConditionalCache::Invalidate() {
+        std::lock_guard lock(mutex_);
+        etag_.clear();
+        lastModified_.clear();
+        body_.clear();
+        bodyHash_ = 0;
+        bodySize_ = 0;
+        valid_ = false;
+    }
+
+    std::string ConditionalCache::Body() const {
+        std::lock_guard lock(mutex_);
+        return body_;
+    }
+
+}  // namespace SkyrimNetUI::Http
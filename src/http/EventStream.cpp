@@ -0,0 +1,81 @@
+#include "http/EventStream.h"
+
+#include "pch.h"
+
+namespace SkyrimNetUI::Http {
+
+    void SseParser::Feed(std::string_view chunk) {
+        for (char c : chunk) {
+            if (skipLineFeed_) {
+                skipLineFeed_ = false;
+                if (c == '\n') {
+                    continue;
+                }
+            }
+
+            // Lines end with "\r\n", "\n" or a lone "\r"
+            if (c == '\r' || c == '\n') {
+                skipLineFeed_ = (c == '\r');
+                ProcessLine(line_);
+                line_.clear();
+            } else {
+                line_.push_back(c);
+            }
+        }
+    }
+
+    void SseParser::Reset() {
+        line_.clear();
+        pending_ = {};
+        hasData_ = false;
+        skipLineFeed_ = false;
+    }
+
+    void SseParser::ProcessLine(std::string_view line) {
+        if (line.empty()) {
+            Dispatch();
+            return;
+        }
+
+        // Comment lines (": keep-alive") only keep the connection warm
+        if (line.front() == ':') {
+            return;
+        }
+
+        std::string_view field = line;
+        std::string_view value;
+        if (size_t colon = line.find(':'); colon != std::string_view::npos) {
+            field = line.substr(0, colon);
+            value = line.substr(colon + 1);
+            if (!value.empty() && value.front() == ' ') {
+                value.remove_prefix(1);
+            }
+        }
+
+        if (field == "event") {
+            pending_.event = value;
+        } else if (field == "data") {
+            if (hasData_) {
+                pending_.data.push_back('\n');
+            }
+            pending_.data.append(value);
+            hasData_ = true;
+        } else if (field == "id") {
+            pending_.id = value;
+        }
+        // "retry" and unknown fields are ignored; reconnect timing is owned by the caller
+    }
+
+    void SseParser::Dispatch() {
+        if (hasData_ && onEvent_) {
+            onEvent_(pending_);
+        }
+
+        // The last event id persists across events per the SSE spec
+        std::string lastId = std::move(pending_.id);
+        pending_ = {};
+        pending_.id = std::move(lastId);
+        hasData_ = false;
+    }
+
+}  // namespace SkyrimNetUI::Http
@@ -0,0 +1,169 @@
+#include "http/FakeTransport.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace SkyrimNetUI::Http {
+
+    namespace {
+        constexpr auto kCancelCheckInterval = std::chrono::milliseconds(1);
+
+        // Insert a filler member before the closing brace so the body stays valid JSON
+        void PadJson(std::string& body, size_t size) {
+            constexpr std::string_view kPrefix = ",\"padding\":\"";
+            const auto close = body.rfind('}');
+            if (close == std::string::npos || body.size() + kPrefix.size() + 1 >= size) {
+                return;
+            }
+            const size_t filler = size - body.size() - kPrefix.size() - 1;
+            std::string padding(kPrefix);
+            padding.append(filler, 'x').push_back('"');
+            body.insert(close, padding);
+        }
+
+        // @return false if the token was cancelled while waiting
+        bool Wait(std::chrono::milliseconds latency, const CancelToken* cancel) {
+            const auto deadline = std::chrono::steady_clock::now() + latency;
+            while (std::chrono::steady_clock::now() < deadline) {
+                if (cancel && cancel->IsCancelled()) {
+                    return false;
+                }
+                std::this_thread::sleep_for(
+                    std::min<std::chrono::steady_clock::duration>(kCancelCheckInterval,
+                                                                  deadline - std::chrono::steady_clock::now()));
+            }
+            return !(cancel && cancel->IsCancelled());
+        }
+    }
+
+    void FakeTransport::SetRoute(std::string method, std::string url, FakeRoute route) {
+        std::lock_guard lock(mutex_);
+        routes_.insert_or_assign({std::move(method), std::move(url)}, RouteState{std::move(route)});
+    }
+
+    void FakeTransport::ClearRoutes() {
+        std::lock_guard lock(mutex_);
+        routes_.clear();
+    }
+
+    void FakeTransport::FailNext(uint32_t count) {
+        std::lock_guard lock(mutex_);
+        failNext_ = count;
+    }
+
+    std::vector<FakeRequest> FakeTransport::GetRequests() const {
+        std::lock_guard lock(mutex_);
+        return requests_;
+    }
+
+    size_t FakeTransport::RequestCount(std::string_view method, std::string_view url) const {
+        std::lock_guard lock(mutex_);
+        return static_cast<size_t>(std::ranges::count_if(
+            requests_, [&](const FakeRequest& request) { return request.method == method && request.url == url; }));
+    }
+
+    void FakeTransport::ClearRequests() {
+        std::lock_guard lock(mutex_);
+        requests_.clear();
+    }
+
+    Response FakeTransport::Answer(FakeRequest request, const RequestOptions& options, StreamPacing* pacing) {
+        if (options.cancel && options.cancel->IsCancelled()) {
+            return {};
+        }
+
+        Response response{404, {}, {}};
+        std::chrono::milliseconds latency{0};
+        std::function<Response(const FakeRequest&)> handler;
+        bool fail = false;
+        size_t padTo = 0;
+        {
+            std::lock_guard lock(mutex_);
+            requests_.push_back(request);
+
+            if (failNext_ > 0) {
+                --failNext_;
+                fail = true;
+            }
+            auto it = routes_.find(std::pair(request.method, request.url));
+            if (it != routes_.end()) {
+                auto& state = it->second;
+                ++state.hits;
+                fail = fail || (state.route.failEvery > 0 && state.hits % state.route.failEvery == 0);
+                response = state.route.response;
+                latency = state.route.latency;
+                handler = state.route.handler;
+                padTo = state.route.padTo;
+                if (pacing) {
+                    *pacing = {state.route.chunkSize, state.route.chunkInterval};
+                }
+            }
+        }
+
+        if (!Wait(latency, options.cancel) || fail) {
+            return {};
+        }
+        if (handler) {
+            response = handler(request);
+        }
+        if (padTo > 0) {
+            PadJson(response.body, padTo);
+        }
+        return response;
+    }
+
+    Response FakeTransport::Get(const std::string& url, const RequestOptions& options) {
+        return Answer({"GET", url, {}, options.headers}, options);
+    }
+
+    Response FakeTransport::Head(const std::string& url, const RequestOptions& options) {
+        auto response = Answer({"HEAD", url, {}, options.headers}, options);
+        response.body.clear();
+        return response;
+    }
+
+    Response FakeTransport::Post(const std::string& url, const std::string& jsonData, const RequestOptions& options) {
+        return Answer({"POST", url, jsonData, options.headers}, options);
+    }
+
+    Response FakeTransport::Send(const std::string& method, const std::string& url, const std::string& body,
+                                 std::string_view contentType, const RequestOptions& options) {
+        FakeRequest request{method, url, body, options.headers};
+        if (!contentType.empty()) {
+            request.headers.insert_or_assign("Content-Type", std::string(contentType));
+        }
+        auto response = Answer(std::move(request), options);
+        if (method == "HEAD") {
+            response.body.clear();
+        }
+        return response;
+    }
+
+    StreamResult FakeTransport::Stream(const std::string& url, std::string_view contentType,
+                                       const ChunkHandler& onChunk, const RequestOptions& options) {
+        StreamPacing pacing;
+        auto response = Answer({"STREAM", url, {}, options.headers}, options, &pacing);
+
+        StreamResult result{response.status, response.ok() && response.header("Content-Type").starts_with(contentType)};
+        if (!result.accepted) {
+            return result;
+        }
+
+        // The stream ends once the body has been delivered, as if the server closed it. Paced
+        // chunks are due at fixed offsets from the start, so a slow reader doesn't lower the rate.
+        std::string_view body = response.body;
+        const size_t step = pacing.chunkSize > 0 ? pacing.chunkSize : std::max<size_t>(body.size(), 1);
+        auto due = std::chrono::steady_clock::now();
+        for (size_t offset = 0; offset < body.size(); offset += step) {
+            if (pacing.chunkInterval.count() > 0 && offset > 0) {
+                due += pacing.chunkInterval;
+                std::this_thread::sleep_until(due);
+            }
+            if ((options.cancel && options.cancel->IsCancelled()) || !onChunk(body.substr(offset, step))) {
+                break;
+            }
+        }
+        return result;
+    }
+
+}  // namespace SkyrimNetUI::Http
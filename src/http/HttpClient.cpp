@@ -2,10 +2,42 @@
 
 #include <httplib.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "logging/Log.h"
+#include "metrics/Metrics.h"
 #include "pch.h"
 
 namespace SkyrimNetUI::Http {
 
+    bool HeaderNameLess::operator()(std::string_view lhs, std::string_view rhs) const noexcept {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](char a, char b) {
+            return std::tolower(static_cast<unsigned char>(a)) < std::tolower(static_cast<unsigned char>(b));
+        });
+    }
+
+    static httplib::Headers ToHttplibHeaders(const Headers& headers) {
+        httplib::Headers result;
+        for (const auto& [name, value] : headers) {
+            result.emplace(name, value);
+        }
+        return result;
+    }
+
+    static Response ToResponse(httplib::Response& res) {
+        Response response{res.status, std::move(res.body), {}};
+        for (const auto& [name, value] : res.headers) {
+            response.headers.insert_or_assign(name, value);
+        }
+        return response;
+    }
+
     // Split URL into base (scheme://host:port) and path
     static std::pair<std::string, std::string> SplitUrl(const std::string& url) {
         // Find the third slash (after scheme://)
@@ -22,68 +54,402 @@ namespace SkyrimNetUI::Http {
         return {url.substr(0, pathStart), url.substr(pathStart)};
     }
 
-    Response Get(const std::string& url) {
+    static std::unique_ptr<httplib::Client> CreateClient(const std::string& baseUrl, bool keepAlive) {
+        auto client = std::make_unique<httplib::Client>(baseUrl);
+        client->set_keep_alive(keepAlive);
+        client->set_follow_location(true);
+        client->enable_server_certificate_verification(false);
+        client->enable_server_hostname_verification(false);
+        return client;
+    }
+
+    // Pooled clients are shared by callers with different timeouts, so every request sets its own
+    static void ApplyTimeouts(httplib::Client& client, const Timeouts& timeouts) {
+        client.set_connection_timeout(timeouts.connect);
+        client.set_read_timeout(timeouts.read);
+    }
+
+    /**
+     * Keep-alive clients parked per origin (scheme://host:port).
+     *
+     * httplib::Client serialises requests on its socket, so a client is checked out
+     * for the duration of one request and parked again afterwards. Concurrent callers
+     * for the same origin simply get separate clients. Parked clients older than
+     * kIdleTimeout are closed, and at most kMaxIdleClients are kept in total.
+     */
+    class ClientPool {
+    public:
+        static constexpr size_t kMaxIdleClients = 8;
+        static constexpr auto kIdleTimeout = std::chrono::seconds(30);
+
+        std::unique_ptr<httplib::Client> Acquire(const std::string& origin) {
+            {
+                std::lock_guard lock(mutex_);
+                EvictIdleLocked(std::chrono::steady_clock::now());
+
+                // Most recently parked client is at the back and the most likely to still be connected
+                for (auto it = idle_.rbegin(); it != idle_.rend(); ++it) {
+                    if (it->origin == origin) {
+                        auto client = std::move(it->client);
+                        idle_.erase(std::next(it).base());
+                        // The server may have closed the connection after the last response
+                        // (Connection: close), in which case this request dials again
+                        if (client->is_socket_open()) {
+                            reused_.fetch_add(1, std::memory_order_relaxed);
+                        } else {
+                            reconnected_.fetch_add(1, std::memory_order_relaxed);
+                        }
+                        return client;
+                    }
+                }
+            }
+
+            created_.fetch_add(1, std::memory_order_relaxed);
+            return CreateClient(origin, true);
+        }
+
+        void Release(const std::string& origin, std::unique_ptr<httplib::Client> client) {
+            std::lock_guard lock(mutex_);
+            const auto now = std::chrono::steady_clock::now();
+            EvictIdleLocked(now);
+
+            if (idle_.size() >= kMaxIdleClients) {
+                // Drop the least recently used client to make room
+                idle_.erase(idle_.begin());
+                evicted_.fetch_add(1, std::memory_order_relaxed);
+            }
+            idle_.push_back({origin, std::move(client), now});
+        }
+
+        void Clear() {
+            std::lock_guard lock(mutex_);
+            evicted_.fetch_add(idle_.size(), std::memory_order_relaxed);
+            idle_.clear();
+        }
+
+        PoolStats Stats() const {
+            PoolStats stats;
+            stats.created = created_.load(std::memory_order_relaxed);
+            stats.reused = reused_.load(std::memory_order_relaxed);
+            stats.reconnected = reconnected_.load(std::memory_order_relaxed);
+            stats.evicted = evicted_.load(std::memory_order_relaxed);
+            std::lock_guard lock(mutex_);
+            stats.idle = idle_.size();
+            return stats;
+        }
+
+    private:
+        struct Entry {
+            std::string origin;
+            std::unique_ptr<httplib::Client> client;
+            std::chrono::steady_clock::time_point lastUsed;
+        };
+
+        void EvictIdleLocked(std::chrono::steady_clock::time_point now) {
+            // Entries are appended in release order, so expired ones are at the front
+            size_t expired = 0;
+            while (expired < idle_.size() && now - idle_[expired].lastUsed > kIdleTimeout) {
+                ++expired;
+            }
+            if (expired > 0) {
+                idle_.erase(idle_.begin(), idle_.begin() + static_cast<std::ptrdiff_t>(expired));
+                evicted_.fetch_add(expired, std::memory_order_relaxed);
+            }
+        }
+
+        mutable std::mutex mutex_;
+        std::vector<Entry> idle_;
+        std::atomic<uint64_t> created_{0};
+        std::atomic<uint64_t> reused_{0};
+        std::atomic<uint64_t> reconnected_{0};
+        std::atomic<uint64_t> evicted_{0};
+    };
+
+    static ClientPool& GetPool() {
+        static ClientPool pool;
+        return pool;
+    }
+
+    static std::atomic<bool> g_poolingEnabled{true};
+
+    /**
+     * Checks a client out of the pool (or creates a one-shot client when pooling is
+     * disabled) and parks it again on destruction unless the request failed.
+     */
+    class ClientLease {
+    public:
+        explicit ClientLease(std::string origin, bool pooled = true)
+            : origin_(std::move(origin)), pooled_(pooled && g_poolingEnabled.load(std::memory_order_relaxed)) {
+            client_ = pooled_ ? GetPool().Acquire(origin_) : CreateClient(origin_, false);
+        }
+
+        ~ClientLease() {
+            if (pooled_ && client_ && !broken_) {
+                GetPool().Release(origin_, std::move(client_));
+            }
+        }
+
+        ClientLease(const ClientLease&) = delete;
+        ClientLease& operator=(const ClientLease&) = delete;
+
+        httplib::Client* operator->() const { return client_.get(); }
+        httplib::Client& operator*() const { return *client_; }
+
+        /// Don't return the client to the pool; its connection state is unknown
+        void MarkBroken() { broken_ = true; }
+
+    private:
+        std::string origin_;
+        std::unique_ptr<httplib::Client> client_;
+        bool pooled_;
+        bool broken_ = false;
+    };
+
+    void CancelToken::Cancel() {
+        cancelled_.store(true);
+        std::lock_guard lock(mutex_);
+        for (const auto& abort : aborts_) {
+            abort();
+        }
+    }
+
+    /**
+     * Binds a leased client to a cancel token for the duration of one request.
+     */
+    class CancelBinding {
+    public:
+        CancelBinding(CancelToken* token, ClientLease& client) : token_(token) {
+            if (!token_) {
+                return;
+            }
+            httplib::Client* raw = client.operator->();
+            std::lock_guard lock(token_->mutex_);
+            slot_ = token_->aborts_.emplace(token_->aborts_.end(), [raw]() { raw->stop(); });
+            // Checked once the slot is in place: a Cancel() before this found nothing to abort,
+            // and one after it waits for the lock and then stops this client
+            cancelled_ = token_->IsCancelled();
+        }
+
+        ~CancelBinding() {
+            if (token_) {
+                std::lock_guard lock(token_->mutex_);
+                token_->aborts_.erase(slot_);
+            }
+        }
+
+        CancelBinding(const CancelBinding&) = delete;
+        CancelBinding& operator=(const CancelBinding&) = delete;
+
+        /// @return true if the token was cancelled before or during the request
+        [[nodiscard]] bool Cancelled() const { return cancelled_ || (token_ && token_->IsCancelled()); }
+
+    private:
+        CancelToken* token_;
+        std::list<std::function<void()>>::iterator slot_;
+        bool cancelled_ = false;
+    };
+
+    Response Get(const std::string& url, const RequestOptions& options) {
+        Metrics::ScopedTimer timer(Metrics::Metric::HttpGet);
         try {
             auto [baseUrl, path] = SplitUrl(url);
 
-            httplib::Client client(baseUrl);
-            client.set_connection_timeout(30);
-            client.set_read_timeout(30);
-            client.set_follow_location(true);
-            client.enable_server_certificate_verification(false);
-            client.enable_server_hostname_verification(false);
+            ClientLease client(baseUrl);
+            ApplyTimeouts(*client, options.timeouts);
+            CancelBinding binding(options.cancel, client);
+            if (binding.Cancelled()) {
+                return {};
+            }
 
-            auto res = client.Get(path);
+            auto res = client->Get(path, ToHttplibHeaders(options.headers));
 
             if (!res) {
-                logger::error("GET request failed: {}", httplib::to_string(res.error()));
+                client.MarkBroken();
+                if (binding.Cancelled()) {
+                    LOG_DEBUG(Http, "GET request cancelled: {}", url);
+                } else {
+                    LOG_ERROR(Http, "GET request failed: {}", httplib::to_string(res.error()));
+                    Metrics::Increment(Metrics::Counter::HttpFailures);
+                }
                 return {};
             }
 
             if (res->status >= 400) {
-                logger::warn("GET request returned status {}: {}", res->status, url);
+                LOG_WARN(Http, "GET request returned status {}: {}", res->status, url);
             }
 
-            return {res->status, res->body};
+            return ToResponse(*res);
 
         } catch (const std::exception& e) {
-            logger::error("GET request exception: {}", e.what());
+            LOG_ERROR(Http, "GET request exception: {}", e.what());
             return {};
         }
     }
 
-    Response Post(const std::string& url, const std::string& jsonData) {
-        logger::info("POST Request - URL: {}", url);
-        logger::debug("POST Request - Payload: {}", jsonData);
+    Response Head(const std::string& url, const RequestOptions& options) {
         try {
             auto [baseUrl, path] = SplitUrl(url);
 
-            httplib::Client client(baseUrl);
-            client.set_connection_timeout(30);
-            client.set_read_timeout(30);
-            client.set_follow_location(true);
-            client.enable_server_certificate_verification(false);
-            client.enable_server_hostname_verification(false);
+            ClientLease client(baseUrl);
+            ApplyTimeouts(*client, options.timeouts);
+            CancelBinding binding(options.cancel, client);
+            if (binding.Cancelled()) {
+                return {};
+            }
 
-            auto res = client.Post(path, jsonData, "application/json");
+            auto res = client->Head(path, ToHttplibHeaders(options.headers));
 
             if (!res) {
-                logger::error("POST request failed: {}", httplib::to_string(res.error()));
+                // Expected while the server is down, which is what callers are checking for
+                client.MarkBroken();
+                LOG_TRACE(Http, "HEAD request failed: {}", httplib::to_string(res.error()));
                 return {};
             }
 
-            logger::info("POST request status code: {}", res->status);
+            return ToResponse(*res);
+
+        } catch (const std::exception& e) {
+            LOG_ERROR(Http, "HEAD request exception: {}", e.what());
+            return {};
+        }
+    }
+
+    Response Post(const std::string& url, const std::string& jsonData, const RequestOptions& options) {
+        Metrics::ScopedTimer timer(Metrics::Metric::HttpPost);
+        LOG_DEBUG(Http, "POST Request - URL: {}", url);
+        LOG_TRACE(Http, "POST Request - Payload: {}", jsonData);
+        try {
+            auto [baseUrl, path] = SplitUrl(url);
+
+            ClientLease client(baseUrl);
+            ApplyTimeouts(*client, options.timeouts);
+            CancelBinding binding(options.cancel, client);
+            if (binding.Cancelled()) {
+                return {};
+            }
+
+            auto res = client->Post(path, ToHttplibHeaders(options.headers), jsonData, "application/json");
+
+            if (!res) {
+                client.MarkBroken();
+                if (binding.Cancelled()) {
+                    LOG_DEBUG(Http, "POST request cancelled: {}", url);
+                } else {
+                    LOG_ERROR(Http, "POST request failed: {}", httplib::to_string(res.error()));
+                    Metrics::Increment(Metrics::Counter::HttpFailures);
+                }
+                return {};
+            }
+
+            LOG_DEBUG(Http, "POST request status code: {}", res->status);
 
             if (res->status >= 400 && !res->body.empty()) {
-                logger::error("Server error response: {}", res->body);
+                LOG_ERROR(Http, "Server error response: {}", res->body);
+            }
+
+            return ToResponse(*res);
+
+        } catch (const std::exception& e) {
+            LOG_ERROR(Http, "POST request exception: {}", e.what());
+            return {};
+        }
+    }
+
+    Response Send(const std::string& method, const std::string& url, const std::string& body,
+                  std::string_view contentType, const RequestOptions& options) {
+        LOG_DEBUG(Http, "{} Request - URL: {}", method, url);
+        try {
+            auto [baseUrl, path] = SplitUrl(url);
+
+            ClientLease client(baseUrl);
+            ApplyTimeouts(*client, options.timeouts);
+            CancelBinding binding(options.cancel, client);
+            if (binding.Cancelled()) {
+                return {};
+            }
+
+            httplib::Request request;
+            request.method = method;
+            request.path = std::move(path);
+            request.headers = ToHttplibHeaders(options.headers);
+            if (!contentType.empty()) {
+                request.headers.emplace("Content-Type", std::string(contentType));
             }
+            request.body = body;
 
-            return {res->status, res->body};
+            auto res = client->send(request);
+
+            if (!res) {
+                client.MarkBroken();
+                if (binding.Cancelled()) {
+                    LOG_DEBUG(Http, "{} request cancelled: {}", method, url);
+                } else {
+                    LOG_ERROR(Http, "{} request failed: {}", method, httplib::to_string(res.error()));
+                    Metrics::Increment(Metrics::Counter::HttpFailures);
+                }
+                return {};
+            }
+
+            if (res->status >= 400) {
+                LOG_WARN(Http, "{} request returned status {}: {}", method, res->status, url);
+            }
+
+            return ToResponse(*res);
 
         } catch (const std::exception& e) {
-            logger::error("POST request exception: {}", e.what());
+            LOG_ERROR(Http, "{} request exception: {}", method, e.what());
             return {};
         }
     }
 
+    StreamResult Stream(const std::string& url, std::string_view contentType, const ChunkHandler& onChunk,
+                        const RequestOptions& options) {
+        StreamResult result;
+        try {
+            auto [baseUrl, path] = SplitUrl(url);
+
+            ClientLease client(baseUrl, false);
+            ApplyTimeouts(*client, options.timeouts);
+            CancelBinding binding(options.cancel, client);
+            if (binding.Cancelled()) {
+                return result;
+            }
+
+            auto headers = ToHttplibHeaders(options.headers);
+            headers.emplace("Accept", std::string(contentType));
+            auto res = client->Get(
+                path, headers,
+                [&](const httplib::Response& response) {
+                    result.status = response.status;
+                    result.accepted = response.status >= 200 && response.status < 300 &&
+                                      response.get_header_value("Content-Type").starts_with(contentType);
+                    return result.accepted;
+                },
+                [&](const char* data, size_t length) { return onChunk(std::string_view(data, length)); });
+
+            if (!res && result.status == 0) {
+                if (binding.Cancelled()) {
+                    LOG_DEBUG(Http, "Stream request cancelled: {}", url);
+                } else {
+                    LOG_WARN(Http, "Stream request failed: {}", httplib::to_string(res.error()));
+                }
+            }
+
+        } catch (const std::exception& e) {
+            LOG_ERROR(Http, "Stream request exception: {}", e.what());
+        }
+        return result;
+    }
+
+    void SetPoolingEnabled(bool enabled) {
+        g_poolingEnabled.store(enabled, std::memory_order_relaxed);
+        if (!enabled) {
+            GetPool().Clear();
+        }
+    }
+
+    void ClosePool() { GetPool().Clear(); }
+
+    PoolStats GetPoolStats() { return GetPool().Stats(); }
+
 }  // namespace SkyrimNetUI::Http
@@ -0,0 +1,134 @@
+#include "http/ProxyServer.h"
+
+#include <httplib.h>
+
+#include <algorithm>
+
+#include "logging/Log.h"
+#include "pch.h"
+
+namespace SkyrimNetUI::Http {
+
+    namespace {
+        constexpr const char* kLoopback = "127.0.0.1";
+
+        ProxyRequest ToProxyRequest(const httplib::Request& req) {
+            ProxyRequest request{.method = req.method, .target = req.target, .headers = {}, .body = req.body};
+            for (const auto& [name, value] : req.headers) {
+                request.headers.insert_or_assign(name, value);
+            }
+            return request;
+        }
+
+        void ToHttplibResponse(Response response, httplib::Response& res) {
+            res.status = response.status;
+            std::string contentType(response.header("Content-Type"));
+            response.headers.erase("Content-Type");
+            for (const auto& [name, value] : response.headers) {
+                res.set_header(name, value);
+            }
+            if (!response.body.empty() || !contentType.empty()) {
+                res.set_content(std::move(response.body), contentType.empty() ? "text/plain" : contentType);
+            }
+        }
+    }
+
+    ProxyServer::ProxyServer(Transport& upstream, AssetProxy::Settings settings)
+        : proxy_(upstream, std::move(settings)) {}
+
+    ProxyServer::~ProxyServer() { Stop(); }
+
+    bool ProxyServer::Start(int port) {
+        if (server_) {
+            return true;
+        }
+
+        auto server = std::make_unique<httplib::Server>();
+        const auto handler = [this](const httplib::Request& req, httplib::Response& res) {
+            auto request = ToProxyRequest(req);
+            if (!AssetProxy::WantsEventStream(request)) {
+                ToHttplibResponse(proxy_.Handle(request), res);
+                return;
+            }
+
+            res.set_chunked_content_provider(
+                "text/event-stream", [this, request = std::move(request)](size_t, httplib::DataSink& sink) {
+                    CancelToken cancel;
+                    {
+                        std::lock_guard lock(streamsMutex_);
+                        if (stopping_) {
+                            return false;
+                        }
+                        streams_.push_back(&cancel);
+                    }
+                    // A failed write means the view went away, which closes the upstream stream too
+                    proxy_.Stream(
+                        request, [&sink](std::string_view chunk) { return sink.write(chunk.data(), chunk.size()); },
+                        &cancel);
+                    {
+                        std::lock_guard lock(streamsMutex_);
+                        std::erase(streams_, &cancel);
+                    }
+                    sink.done();
+                    return true;
+                });
+        };
+        // HEAD requests are routed to the GET handler
+        server->Get(".*", handler);
+        server->Post(".*", handler);
+        server->Put(".*", handler);
+        server->Patch(".*", handler);
+        server->Delete(".*", handler);
+        server->Options(".*", handler);
+
+        port_ = port > 0 && server->bind_to_port(kLoopback, port) ? port : -1;
+        if (port_ < 0) {
+            if (port > 0) {
+                LOG_WARN(Http, "Asset proxy port {} is taken, using a free one", port);
+            }
+            port_ = server->bind_to_any_port(kLoopback);
+        }
+        if (port_ <= 0) {
+            LOG_ERROR(Http, "Asset proxy could not listen on {}", kLoopback);
+            port_ = 0;
+            return false;
+        }
+
+        {
+            std::lock_guard lock(streamsMutex_);
+            stopping_ = false;
+        }
+        server_ = std::move(server);
+        thread_ = std::thread([server = server_.get()]() { server->listen_after_bind(); });
+        LOG_INFO(Http, "Asset proxy for {} listening on {}", proxy_.GetSettings().upstream, Url());
+        return true;
+    }
+
+    void ProxyServer::Stop() {
+        if (!server_) {
+            return;
+        }
+        {
+            std::lock_guard lock(streamsMutex_);
+            stopping_ = true;
+            for (auto* stream : streams_) {
+                stream->Cancel();
+            }
+        }
+        server_->stop();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        server_.reset();
+
+        const auto stats = proxy_.GetStats();
+        LOG_INFO(Http, "Asset proxy stopped: {} requests, {} from cache ({} not modified), {} KiB in, {} KiB out",
+                 stats.requests, stats.hits, stats.notModified, stats.upstreamBytes / 1024, stats.servedBytes / 1024);
+        port_ = 0;
+    }
+
+    std::string ProxyServer::Url() const {
+        return server_ ? std::string("http://") + kLoopback + ":" + std::to_string(port_) : std::string();
+    }
+
+}  // namespace SkyrimNetUI::Http
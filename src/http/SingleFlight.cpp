@@ -0,0 +1,138 @@
+#include "http/SingleFlight.h"
+
+#include "metrics/Metrics.h"
+#include "pch.h"
+
+namespace SkyrimNetUI::Http {
+
+    namespace {
+        constexpr auto kCancelCheckInterval = std::chrono::milliseconds(10);
+
+        // Only a handful of status endpoints are read with a max age
+        constexpr size_t kMaxCachedResponses = 32;
+    }
+
+    std::string SingleFlightTransport::Key(const std::string& url, const Headers& headers) {
+        std::string key = url;
+        for (const auto& [name, value] : headers) {
+            key.append("\n").append(name).append(":").append(value);
+        }
+        return key;
+    }
+
+    Response SingleFlightTransport::Get(const std::string& url, const RequestOptions& options) {
+        const bool tolerant = options.maxAge > std::chrono::milliseconds::zero();
+        auto key = Key(url, options.headers);
+        std::shared_ptr<Flight> flight;
+        bool joined = false;
+        {
+            std::lock_guard lock(mutex_);
+            if (tolerant) {
+                auto cached = cache_.find(key);
+                if (cached != cache_.end() &&
+                    std::chrono::steady_clock::now() - cached->second.fetched <= options.maxAge) {
+                    ++stats_.cacheHits;
+                    Metrics::Increment(Metrics::Counter::HttpCacheHits);
+                    return cached->second.response;
+                }
+
+                auto inFlight = flights_.find(key);
+                if (inFlight != flights_.end() && inFlight->second->writeGeneration == writeGeneration_) {
+                    flight = inFlight->second;
+                    joined = true;
+                    ++stats_.merged;
+                }
+            }
+
+            if (!joined) {
+                // Replaces an older flight for the key, so later callers join the fresher request
+                flight = std::make_shared<Flight>();
+                flight->writeGeneration = writeGeneration_;
+                flights_.insert_or_assign(key, flight);
+                ++stats_.issued;
+            }
+        }
+
+        if (joined) {
+            Metrics::Increment(Metrics::Counter::HttpMerged);
+            return Wait(flight, url, options);
+        }
+
+        Result result;
+        result.response = inner_.Get(url, options);
+        result.cancelled = options.cancel && options.cancel->IsCancelled();
+        {
+            std::lock_guard lock(mutex_);
+            auto it = flights_.find(key);
+            if (it != flights_.end() && it->second == flight) {
+                flights_.erase(it);
+            }
+            if (result.response.ok() && flight->writeGeneration == writeGeneration_) {
+                if (cache_.size() >= kMaxCachedResponses) {
+                    cache_.clear();
+                }
+                cache_.insert_or_assign(std::move(key),
+                                        CachedResponse{result.response, std::chrono::steady_clock::now()});
+            }
+        }
+        flight->promise.set_value(result);
+        return std::move(result.response);
+    }
+
+    Response SingleFlightTransport::Wait(const std::shared_ptr<Flight>& flight, const std::string& url,
+                                         const RequestOptions& options) {
+        while (flight->future.wait_for(kCancelCheckInterval) != std::future_status::ready) {
+            if (options.cancel && options.cancel->IsCancelled()) {
+                return {};
+            }
+        }
+
+        const auto& result = flight->future.get();
+        if (result.cancelled && !(options.cancel && options.cancel->IsCancelled())) {
+            // The issuer gave up, not the server; ask again for this caller
+            return inner_.Get(url, options);
+        }
+        return result.response;
+    }
+
+    Response SingleFlightTransport::Head(const std::string& url, const RequestOptions& options) {
+        return inner_.Head(url, options);
+    }
+
+    Response SingleFlightTransport::Post(const std::string& url, const std::string& jsonData,
+                                         const RequestOptions& options) {
+        auto response = inner_.Post(url, jsonData, options);
+        std::lock_guard lock(mutex_);
+        // Bumped after the write completes: GETs issued while it ran may have seen either state
+        ++writeGeneration_;
+        cache_.clear();
+        return response;
+    }
+
+    Response SingleFlightTransport::Send(const std::string& method, const std::string& url, const std::string& body,
+                                         std::string_view contentType, const RequestOptions& options) {
+        auto response = inner_.Send(method, url, body, contentType, options);
+        if (method != "GET" && method != "HEAD" && method != "OPTIONS") {
+            std::lock_guard lock(mutex_);
+            ++writeGeneration_;
+            cache_.clear();
+        }
+        return response;
+    }
+
+    StreamResult SingleFlightTransport::Stream(const std::string& url, std::string_view contentType,
+                                               const ChunkHandler& onChunk, const RequestOptions& options) {
+        return inner_.Stream(url, contentType, onChunk, options);
+    }
+
+    void SingleFlightTransport::Clear() {
+        std::lock_guard lock(mutex_);
+        cache_.clear();
+    }
+
+    SingleFlightTransport::Stats SingleFlightTransport::GetStats() const {
+        std::lock_guard lock(mutex_);
+        return stats_;
+    }
+
+}  // namespace SkyrimNetUI::Http
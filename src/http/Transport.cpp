@@ -0,0 +1,36 @@
+#include "http/Transport.h"
+
+#include "http/SingleFlight.h"
+
+namespace SkyrimNetUI::Http {
+
+    Response HttplibTransport::Get(const std::string& url, const RequestOptions& options) {
+        return Http::Get(url, options);
+    }
+
+    Response HttplibTransport::Head(const std::string& url, const RequestOptions& options) {
+        return Http::Head(url, options);
+    }
+
+    Response HttplibTransport::Post(const std::string& url, const std::string& jsonData,
+                                    const RequestOptions& options) {
+        return Http::Post(url, jsonData, options);
+    }
+
+    Response HttplibTransport::Send(const std::string& method, const std::string& url, const std::string& body,
+                                    std::string_view contentType, const RequestOptions& options) {
+        return Http::Send(method, url, body, contentType, options);
+    }
+
+    StreamResult HttplibTransport::Stream(const std::string& url, std::string_view contentType,
+                                          const ChunkHandler& onChunk, const RequestOptions& options) {
+        return Http::Stream(url, contentType, onChunk, options);
+    }
+
+    Transport& GetDefaultTransport() {
+        static HttplibTransport httplib;
+        static SingleFlightTransport transport(httplib);
+        return transport;
+    }
+
+}  // namespace SkyrimNetUI::Http
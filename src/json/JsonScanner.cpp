@@ -0,0 +1,497 @@
+#include "json/JsonScanner.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+
+#include "pch.h"
+
+namespace SkyrimNetUI::Json {
+
+    namespace {
+
+        // Guards the recursive descent against hostile or corrupt documents
+        constexpr int kMaxDepth = 256;
+
+        bool IsWhitespace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+        bool IsLiteralChar(char c) {
+            return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '-' ||
+                   c == '+' || c == '.';
+        }
+
+        int HexValue(char c) {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+
+        void AppendUtf8(std::string& out, uint32_t cp) {
+            if (cp < 0x80) {
+                out.push_back(static_cast<char>(cp));
+            } else if (cp < 0x800) {
+                out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+                out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+            } else if (cp < 0x10000) {
+                out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+                out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+            } else {
+                out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+                out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+            }
+        }
+
+        bool ReadHex4(std::string_view s, size_t pos, uint32_t& value) {
+            if (pos + 4 > s.size()) {
+                return false;
+            }
+            value = 0;
+            for (size_t i = 0; i < 4; ++i) {
+                const int digit = HexValue(s[pos + i]);
+                if (digit < 0) {
+                    return false;
+                }
+                value = (value << 4) | static_cast<uint32_t>(digit);
+            }
+            return true;
+        }
+
+        // Decodes the content of a JSON string that contains backslash escapes
+        std::string DecodeEscaped(std::string_view raw) {
+            std::string out;
+            out.reserve(raw.size());
+            for (size_t i = 0; i < raw.size(); ++i) {
+                if (raw[i] != '\\' || i + 1 >= raw.size()) {
+                    out.push_back(raw[i]);
+                    continue;
+                }
+                const char e = raw[++i];
+                switch (e) {
+                    case 'b': out.push_back('\b'); break;
+                    case 'f': out.push_back('\f'); break;
+                    case 'n': out.push_back('\n'); break;
+                    case 'r': out.push_back('\r'); break;
+                    case 't': out.push_back('\t'); break;
+                    case 'u': {
+                        uint32_t cp = 0;
+                        if (!ReadHex4(raw, i + 1, cp)) {
+                            out.push_back(e);
+                            break;
+                        }
+                        i += 4;
+                        uint32_t low = 0;
+                        if (cp >= 0xD800 && cp <= 0xDBFF && i + 2 < raw.size() && raw[i + 1] == '\\' &&
+                            raw[i + 2] == 'u' && ReadHex4(raw, i + 3, low) && low >= 0xDC00 && low <= 0xDFFF) {
+                            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                            i += 6;
+                        }
+                        AppendUtf8(out, cp);
+                        break;
+                    }
+                    default: out.push_back(e); break;  // \" \\ \/
+                }
+            }
+            return out;
+        }
+
+        // Number of reference tokens in a pointer ("" = 0, "/a/b" = 2); -1 if invalid
+        int TokenCount(std::string_view pointer) {
+            if (pointer.empty()) {
+                return 0;
+            }
+            if (pointer.front() != '/') {
+                return -1;
+            }
+            return static_cast<int>(std::count(pointer.begin(), pointer.end(), '/'));
+        }
+
+        // Raw (still ~-escaped) reference token at index
+        std::string_view TokenAt(std::string_view pointer, int index) {
+            size_t start = 1;
+            for (int i = 0; i < index; ++i) {
+                start = pointer.find('/', start) + 1;
+            }
+            const size_t end = pointer.find('/', start);
+            return pointer.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+        }
+
+        // Compares a raw pointer token against a decoded member name, unescaping ~0 and ~1
+        bool TokenMatches(std::string_view token, std::string_view key) {
+            size_t k = 0;
+            for (size_t t = 0; t < token.size(); ++t, ++k) {
+                char c = token[t];
+                if (c == '~' && t + 1 < token.size()) {
+                    c = token[t + 1] == '1' ? '/' : '~';
+                    ++t;
+                }
+                if (k >= key.size() || key[k] != c) {
+                    return false;
+                }
+            }
+            return k == key.size();
+        }
+
+        class Scanner {
+        public:
+            explicit Scanner(std::string_view doc) : doc_(doc) {}
+
+            std::string_view doc_;
+            size_t pos_ = 0;
+
+            void SkipWhitespace() {
+                while (pos_ < doc_.size() && IsWhitespace(doc_[pos_])) {
+                    ++pos_;
+                }
+            }
+
+            [[nodiscard]] bool AtEnd() const { return pos_ >= doc_.size(); }
+            [[nodiscard]] char Current() const { return doc_[pos_]; }
+
+            bool Expect(char c) {
+                SkipWhitespace();
+                if (AtEnd() || doc_[pos_] != c) {
+                    return false;
+                }
+                ++pos_;
+                return true;
+            }
+
+            // Scans a string starting at the opening quote; content excludes the quotes
+            bool ScanString(std::string_view& content, bool& escaped) {
+                if (AtEnd() || doc_[pos_] != '"') {
+                    return false;
+                }
+                const size_t start = ++pos_;
+                escaped = false;
+                while (pos_ < doc_.size()) {
+                    const char c = doc_[pos_];
+                    if (c == '"') {
+                        content = doc_.substr(start, pos_ - start);
+                        ++pos_;
+                        return true;
+                    }
+                    if (c == '\\') {
+                        escaped = true;
+                        ++pos_;
+                    }
+                    ++pos_;
+                }
+                return false;
+            }
+
+            // Reads an object member name and the following colon, leaving pos_ at the value
+            bool ScanKey(std::string_view& key, std::string& decoded) {
+                SkipWhitespace();
+                bool escaped = false;
+                if (!ScanString(key, escaped)) {
+                    return false;
+                }
+                if (escaped) {
+                    decoded = DecodeEscaped(key);
+                    key = decoded;
+                }
+                if (!Expect(':')) {
+                    return false;
+                }
+                SkipWhitespace();
+                return !AtEnd();
+            }
+
+            // After a member or element: true if another follows, false at the closing bracket
+            bool NextItem(char close, bool& ok) {
+                SkipWhitespace();
+                if (AtEnd()) {
+                    ok = false;
+                    return false;
+                }
+                const char c = doc_[pos_++];
+                if (c == ',') {
+                    return true;
+                }
+                ok = (c == close);
+                return false;
+            }
+
+            // Checks for an empty container right after its opening bracket
+            bool ConsumeIf(char c) {
+                SkipWhitespace();
+                if (!AtEnd() && doc_[pos_] == c) {
+                    ++pos_;
+                    return true;
+                }
+                return false;
+            }
+
+            bool SkipValue(int depth) {
+                SkipWhitespace();
+                if (AtEnd() || depth > kMaxDepth) {
+                    return false;
+                }
+                const char c = doc_[pos_];
+                if (c == '"') {
+                    std::string_view content;
+                    bool escaped = false;
+                    return ScanString(content, escaped);
+                }
+                if (c == '{' || c == '[') {
+                    return SkipContainer(depth);
+                }
+                const size_t start = pos_;
+                while (pos_ < doc_.size() && IsLiteralChar(doc_[pos_])) {
+                    ++pos_;
+                }
+                return pos_ > start;
+            }
+
+        private:
+            // Containers are skipped iteratively by bracket depth; only strings need real scanning
+            bool SkipContainer(int depth) {
+                int nesting = 0;
+                while (pos_ < doc_.size()) {
+                    const char c = doc_[pos_];
+                    if (c == '"') {
+                        std::string_view content;
+                        bool escaped = false;
+                        if (!ScanString(content, escaped)) {
+                            return false;
+                        }
+                        continue;
+                    }
+                    ++pos_;
+                    if (c == '{' || c == '[') {
+                        if (++nesting + depth > kMaxDepth) {
+                            return false;
+                        }
+                    } else if (c == '}' || c == ']') {
+                        if (--nesting == 0) {
+                            return true;
+                        }
+                    }
+                }
+                return false;
+            }
+        };
+
+        struct ResolveContext {
+            std::span<const std::string_view> pointers;
+            std::span<std::optional<std::string_view>> results;
+            std::array<int, kMaxPointers> tokenCounts{};
+            size_t remaining = 0;
+        };
+
+        void Record(ResolveContext& ctx, uint64_t mask, std::string_view value) {
+            for (size_t i = 0; mask != 0; ++i, mask >>= 1) {
+                if ((mask & 1) && !ctx.results[i]) {
+                    ctx.results[i] = value;
+                    --ctx.remaining;
+                }
+            }
+        }
+
+        // Walks the value at the scanner position; active = pointers matched down to this depth
+        bool Walk(Scanner& s, ResolveContext& ctx, int depth, uint64_t active) {
+            s.SkipWhitespace();
+            if (s.AtEnd() || depth > kMaxDepth) {
+                return false;
+            }
+            if (active == 0 || (s.Current() != '{' && s.Current() != '[')) {
+                return s.SkipValue(depth);
+            }
+
+            const bool isObject = s.Current() == '{';
+            const char close = isObject ? '}' : ']';
+            s.pos_++;
+            if (s.ConsumeIf(close)) {
+                return true;
+            }
+
+            std::string decoded;
+            std::array<char, 24> indexBuffer{};
+            size_t index = 0;
+            bool ok = true;
+            do {
+                std::string_view name;
+                if (isObject) {
+                    if (!s.ScanKey(name, decoded)) {
+                        return false;
+                    }
+                } else {
+                    s.SkipWhitespace();
+                    auto [end, ec] = std::to_chars(indexBuffer.data(), indexBuffer.data() + indexBuffer.size(), index++);
+                    name = std::string_view(indexBuffer.data(), static_cast<size_t>(end - indexBuffer.data()));
+                }
+
+                uint64_t ending = 0;
+                uint64_t deeper = 0;
+                for (uint64_t mask = active, i = 0; mask != 0; ++i, mask >>= 1) {
+                    if ((mask & 1) && TokenMatches(TokenAt(ctx.pointers[i], depth), name)) {
+                        (ctx.tokenCounts[i] == depth + 1 ? ending : deeper) |= (1ull << i);
+                    }
+                }
+
+                const size_t valueStart = s.pos_;
+                if (!Walk(s, ctx, depth + 1, deeper)) {
+                    return false;
+                }
+                if (ending != 0) {
+                    Record(ctx, ending, s.doc_.substr(valueStart, s.pos_ - valueStart));
+                }
+                if (ctx.remaining == 0) {
+                    // Everything found; the rest of the document is irrelevant
+                    return true;
+                }
+            } while (s.NextItem(close, ok));
+
+            return ok;
+        }
+
+        bool Search(Scanner& s, std::string_view key, int depth, std::optional<std::string_view>& result) {
+            s.SkipWhitespace();
+            if (s.AtEnd() || depth > kMaxDepth) {
+                return false;
+            }
+            if (s.Current() != '{' && s.Current() != '[') {
+                return s.SkipValue(depth);
+            }
+
+            const bool isObject = s.Current() == '{';
+            const char close = isObject ? '}' : ']';
+            s.pos_++;
+            if (s.ConsumeIf(close)) {
+                return true;
+            }
+
+            std::string decoded;
+            bool ok = true;
+            do {
+                std::string_view name;
+                if (isObject && !s.ScanKey(name, decoded)) {
+                    return false;
+                }
+                s.SkipWhitespace();
+                const size_t valueStart = s.pos_;
+                if (isObject && name == key) {
+                    if (!s.SkipValue(depth + 1)) {
+                        return false;
+                    }
+                    result = s.doc_.substr(valueStart, s.pos_ - valueStart);
+                    return true;
+                }
+                if (!Search(s, key, depth + 1, result)) {
+                    return false;
+                }
+                if (result) {
+                    return true;
+                }
+            } while (s.NextItem(close, ok));
+
+            return ok;
+        }
+
+    }  // namespace
+
+    bool Resolve(std::string_view doc, std::span<const std::string_view> pointers,
+                 std::span<std::optional<std::string_view>> results) {
+        if (pointers.size() > kMaxPointers || results.size() != pointers.size()) {
+            return false;
+        }
+
+        ResolveContext ctx{pointers, results};
+        uint64_t active = 0;
+        for (size_t i = 0; i < pointers.size(); ++i) {
+            results[i].reset();
+            ctx.tokenCounts[i] = TokenCount(pointers[i]);
+            if (ctx.tokenCounts[i] > 0) {
+                active |= (1ull << i);
+                ++ctx.remaining;
+            }
+        }
+
+        Scanner s(doc);
+        s.SkipWhitespace();
+        const size_t rootStart = s.pos_;
+        if (!Walk(s, ctx, 0, active)) {
+            return false;
+        }
+
+        // "" refers to the whole document; Walk may have stopped early, so measure it separately
+        for (size_t i = 0; i < pointers.size(); ++i) {
+            if (ctx.tokenCounts[i] < 0) {
+                return false;
+            }
+            if (ctx.tokenCounts[i] == 0) {
+                Scanner root(doc);
+                root.pos_ = rootStart;
+                if (!root.SkipValue(0)) {
+                    return false;
+                }
+                results[i] = doc.substr(rootStart, root.pos_ - rootStart);
+            }
+        }
+        return true;
+    }
+
+    std::optional<std::string_view> Find(std::string_view doc, std::string_view pointer) {
+        std::optional<std::string_view> result;
+        if (!Resolve(doc, std::span(&pointer, 1), std::span(&result, 1))) {
+            return std::nullopt;
+        }
+        return result;
+    }
+
+    std::optional<std::string_view> FindMember(std::string_view doc, std::string_view key) {
+        Scanner s(doc);
+        std::optional<std::string_view> result;
+        if (!Search(s, key, 0, result)) {
+            return std::nullopt;
+        }
+        return result;
+    }
+
+    std::optional<bool> AsBool(std::string_view value) noexcept {
+        if (value == "true") {
+            return true;
+        }
+        if (value == "false") {
+            return false;
+        }
+        return std::nullopt;
+    }
+
+    std::optional<std::string> ApplyPatches(std::string_view doc, std::span<Patch> patches) {
+        const char* begin = doc.data();
+        const char* end = doc.data() + doc.size();
+
+        size_t outputSize = doc.size();
+        for (const auto& patch : patches) {
+            if (patch.target.data() < begin || patch.target.data() + patch.target.size() > end) {
+                return std::nullopt;
+            }
+            outputSize = outputSize - patch.target.size() + patch.replacement.size();
+        }
+
+        std::sort(patches.begin(), patches.end(),
+                  [](const Patch& a, const Patch& b) { return a.target.data() < b.target.data(); });
+
+        std::string output;
+        output.reserve(outputSize);
+
+        const char* cursor = begin;
+        for (const auto& patch : patches) {
+            if (patch.target.data() < cursor) {
+                return std::nullopt;  // overlapping targets
+            }
+            output.append(cursor, patch.target.data());
+            output.append(patch.replacement);
+            cursor = patch.target.data() + patch.target.size();
+        }
+        output.append(cursor, end);
+        return output;
+    }
+
+}  // namespace SkyrimNetUI::Json
@@ -0,0 +1,176 @@
+#include "keyhandler/KeyBinding.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <utility>
+
+namespace SkyrimNetUI {
+
+    namespace {
+        // DirectInput scan codes by name
+        constexpr std::array<std::pair<std::string_view, uint32_t>, 99> kKeyNames{{
+            {"Escape", 0x01},      {"1", 0x02},          {"2", 0x03},          {"3", 0x04},
+            {"4", 0x05},           {"5", 0x06},          {"6", 0x07},          {"7", 0x08},
+            {"8", 0x09},           {"9", 0x0A},          {"0", 0x0B},          {"Minus", 0x0C},
+            {"Equals", 0x0D},      {"Backspace", 0x0E},  {"Tab", 0x0F},        {"Q", 0x10},
+            {"W", 0x11},           {"E", 0x12},          {"R", 0x13},          {"T", 0x14},
+            {"Y", 0x15},           {"U", 0x16},          {"I", 0x17},          {"O", 0x18},
+            {"P", 0x19},           {"LeftBracket", 0x1A}, {"RightBracket", 0x1B}, {"Enter", 0x1C},
+            {"LeftCtrl", 0x1D},    {"A", 0x1E},          {"S", 0x1F},          {"D", 0x20},
+            {"F", 0x21},           {"G", 0x22},          {"H", 0x23},          {"J", 0x24},
+            {"K", 0x25},           {"L", 0x26},          {"Semicolon", 0x27},  {"Apostrophe", 0x28},
+            {"Grave", 0x29},       {"LeftShift", 0x2A},  {"Backslash", 0x2B},  {"Z", 0x2C},
+            {"X", 0x2D},           {"C", 0x2E},          {"V", 0x2F},          {"B", 0x30},
+            {"N", 0x31},           {"M", 0x32},          {"Comma", 0x33},      {"Period", 0x34},
+            {"Slash", 0x35},       {"RightShift", 0x36}, {"NumpadMultiply", 0x37}, {"LeftAlt", 0x38},
+            {"Space", 0x39},       {"CapsLock", 0x3A},   {"F1", 0x3B},         {"F2", 0x3C},
+            {"F3", 0x3D},          {"F4", 0x3E},         {"F5", 0x3F},         {"F6", 0x40},
+            {"F7", 0x41},          {"F8", 0x42},         {"F9", 0x43},         {"F10", 0x44},
+            {"NumLock", 0x45},     {"ScrollLock", 0x46}, {"Numpad7", 0x47},    {"Numpad8", 0x48},
+            {"Numpad9", 0x49},     {"NumpadMinus", 0x4A}, {"Numpad4", 0x4B},   {"Numpad5", 0x4C},
+            {"Numpad6", 0x4D},     {"NumpadPlus", 0x4E}, {"Numpad1", 0x4F},    {"Numpad2", 0x50},
+            {"Numpad3", 0x51},     {"Numpad0", 0x52},    {"NumpadDecimal", 0x53}, {"F11", 0x57},
+            {"F12", 0x58},         {"NumpadEnter", 0x9C}, {"RightCtrl", 0x9D}, {"NumpadDivide", 0xB5},
+            {"RightAlt", 0xB8},    {"Home", 0xC7},       {"Up", 0xC8},         {"PageUp", 0xC9},
+            {"Left", 0xCB},        {"Right", 0xCD},      {"End", 0xCF},        {"Down", 0xD0},
+            {"PageDown", 0xD1},    {"Insert", 0xD2},     {"Delete", 0xD3},
+        }};
+
+        bool EqualsIgnoreCase(std::string_view lhs, std::string_view rhs) {
+            return std::ranges::equal(lhs, rhs, [](char a, char b) {
+                return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+            });
+        }
+
+        std::string_view Trim(std::string_view text) {
+            const auto first = text.find_first_not_of(" \t");
+            if (first == std::string_view::npos) {
+                return {};
+            }
+            return text.substr(first, text.find_last_not_of(" \t") - first + 1);
+        }
+
+        std::optional<uint32_t> ParseKey(std::string_view name) {
+            if (name.size() > 2 && name[0] == '0' && (name[1] == 'x' || name[1] == 'X')) {
+                uint32_t code = 0;
+                auto [end, ec] = std::from_chars(name.data() + 2, name.data() + name.size(), code, 16);
+                if (ec != std::errc{} || end != name.data() + name.size()) {
+                    return std::nullopt;
+                }
+                return code;
+            }
+            for (const auto& [keyName, code] : kKeyNames) {
+                if (EqualsIgnoreCase(keyName, name)) {
+                    return code;
+                }
+            }
+            return std::nullopt;
+        }
+
+        std::optional<uint8_t> ParseModifier(std::string_view name) {
+            if (EqualsIgnoreCase(name, "Shift")) {
+                return kModifierShift;
+            }
+            if (EqualsIgnoreCase(name, "Ctrl") || EqualsIgnoreCase(name, "Control")) {
+                return kModifierCtrl;
+            }
+            if (EqualsIgnoreCase(name, "Alt")) {
+                return kModifierAlt;
+            }
+            return std::nullopt;
+        }
+
+        // Parses the part after ':' into binding.type / binding.holdSeconds
+        bool ParseTrigger(std::string_view text, KeyBinding& binding) {
+            const auto equals = text.find('=');
+            const auto name = Trim(text.substr(0, equals));
+            const auto argument = equals == std::string_view::npos ? std::string_view{} : Trim(text.substr(equals + 1));
+
+            if (EqualsIgnoreCase(name, "Hold")) {
+                binding.type = KeyEventType::KEY_HOLD;
+                if (!argument.empty()) {
+                    auto [end, ec] = std::from_chars(argument.data(), argument.data() + argument.size(),
+                                                     binding.holdSeconds);
+                    if (ec != std::errc{} || end != argument.data() + argument.size() || binding.holdSeconds <= 0.0f) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            if (!argument.empty()) {
+                return false;
+            }
+            if (EqualsIgnoreCase(name, "Down") || EqualsIgnoreCase(name, "Press")) {
+                binding.type = KeyEventType::KEY_DOWN;
+            } else if (EqualsIgnoreCase(name, "Up") || EqualsIgnoreCase(name, "Release")) {
+                binding.type = KeyEventType::KEY_UP;
+            } else if (EqualsIgnoreCase(name, "DoubleTap") || EqualsIgnoreCase(name, "Double")) {
+                binding.type = KeyEventType::KEY_DOUBLE_TAP;
+            } else {
+                return false;
+            }
+            return true;
+        }
+    }
+
+    std::optional<KeyBinding> ParseKeyBinding(std::string_view text) {
+        KeyBinding binding;
+        binding.modifiers = kModifierNone;
+
+        const auto colon = text.find(':');
+        if (colon != std::string_view::npos && !ParseTrigger(text.substr(colon + 1), binding)) {
+            return std::nullopt;
+        }
+
+        std::string_view chord = text.substr(0, colon);
+        bool haveKey = false;
+        while (!chord.empty()) {
+            const auto plus = chord.find('+');
+            const auto part = Trim(chord.substr(0, plus));
+            chord = plus == std::string_view::npos ? std::string_view{} : chord.substr(plus + 1);
+
+            // The key comes last; everything before it must be a modifier
+            if (haveKey || part.empty()) {
+                return std::nullopt;
+            }
+            if (auto modifier = ParseModifier(part); modifier && !chord.empty()) {
+                binding.modifiers |= *modifier;
+                continue;
+            }
+            auto key = ParseKey(part);
+            if (!key || *key > 0xFF) {
+                return std::nullopt;
+            }
+            binding.key = *key;
+            haveKey = true;
+        }
+
+        if (!haveKey) {
+            return std::nullopt;
+        }
+        // A bare key fires whatever is held, so Alt or a stuck Shift doesn't swallow it
+        if (binding.modifiers == kModifierNone) {
+            binding.modifiers = kModifierAny;
+        }
+        return binding;
+    }
+
+    uint8_t ModifierForScanCode(uint32_t dxScanCode) noexcept {
+        switch (dxScanCode) {
+            case 0x2A:  // Left Shift
+            case 0x36:  // Right Shift
+                return kModifierShift;
+            case 0x1D:  // Left Ctrl
+            case 0x9D:  // Right Ctrl
+                return kModifierCtrl;
+            case 0x38:  // Left Alt
+            case 0xB8:  // Right Alt
+                return kModifierAlt;
+            default:
+                return kModifierNone;
+        }
+    }
+
+}  // namespace SkyrimNetUI
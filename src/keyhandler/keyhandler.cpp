@@ -1,7 +1,32 @@
 #include "keyhandler/keyhandler.h"
 
+#include "logging/Log.h"
+#include "metrics/Metrics.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#endif
+
 namespace SkyrimNetUI {
 
+    namespace {
+        const char* EventTypeName(KeyEventType type) {
+            switch (type) {
+                case KeyEventType::KEY_DOWN:
+                    return "DOWN";
+                case KeyEventType::KEY_UP:
+                    return "UP";
+                case KeyEventType::KEY_HOLD:
+                    return "HOLD";
+                case KeyEventType::KEY_DOUBLE_TAP:
+                    return "DOUBLE TAP";
+            }
+            return "UNKNOWN";
+        }
+    }
+
     KeyHandler* KeyHandler::GetSingleton() {
         static KeyHandler singleton;
         return &singleton;
@@ -11,16 +36,58 @@ namespace SkyrimNetUI {
         auto inputMgr = RE::BSInputDeviceManager::GetSingleton();
         if (inputMgr) {
             inputMgr->AddEventSink(GetSingleton());
-            logger::info("KeyHandler sink registered successfully.");
+            LOG_INFO(Input, "KeyHandler sink registered successfully.");
         } else {
             logger::critical("Failed to get InputDeviceManager. KeyHandler sink NOT registered!");
         }
     }
 
+    KeyHandler::KeyHandler() {
+        auto empty = std::make_unique<Snapshot>();
+        _snapshot.store(empty.get(), std::memory_order_release);
+        _snapshots.push_back(std::move(empty));
+    }
+
+    void KeyHandler::PublishLocked(std::unique_ptr<Snapshot> next) {
+        _snapshot.store(next.get(), std::memory_order_release);
+        _snapshots.push_back(std::move(next));
+    }
+
+    std::vector<KeyHandler::Binding>& KeyHandler::Triggers::For(KeyEventType type) {
+        switch (type) {
+            case KeyEventType::KEY_UP:
+                return up;
+            case KeyEventType::KEY_HOLD:
+                return hold;
+            case KeyEventType::KEY_DOUBLE_TAP:
+                return doubleTap;
+            case KeyEventType::KEY_DOWN:
+            default:
+                return down;
+        }
+    }
+
     [[nodiscard]] KeyHandlerEvent KeyHandler::Register(uint32_t dxScanCode, KeyEventType eventType,
                                                        KeyCallback callback) {
+        KeyBinding binding;
+        binding.key = dxScanCode;
+        binding.type = eventType;
+        return Register(binding, std::move(callback));
+    }
+
+    [[nodiscard]] KeyHandlerEvent KeyHandler::Register(const KeyBinding& binding, KeyCallback callback) {
         if (!callback) {
-            logger::warn("Attempted to register a null callback for key 0x{:X}", dxScanCode);
+            LOG_WARN(Input, "Attempted to register a null callback for key 0x{:X}", binding.key);
+            return INVALID_REGISTRATION_HANDLE;
+        }
+
+        if (binding.key >= kMaxScanCodes) {
+            LOG_WARN(Input, "Attempted to register a callback for out-of-range key 0x{:X}", binding.key);
+            return INVALID_REGISTRATION_HANDLE;
+        }
+
+        if (binding.modifiers != kModifierAny && binding.modifiers >= kModifierCombinations) {
+            LOG_WARN(Input, "Attempted to register a callback with invalid modifiers 0x{:X}", binding.modifiers);
             return INVALID_REGISTRATION_HANDLE;
         }
 
@@ -31,70 +98,102 @@ namespace SkyrimNetUI {
             return INVALID_REGISTRATION_HANDLE;
         }
 
-        std::unique_lock lock(_mutex);
+        std::lock_guard lock(_mutex);
 
-        logger::info("Registering callback with handle {} for key 0x{:X}, event type {}", handle, dxScanCode,
-                     (eventType == KeyEventType::KEY_DOWN ? "DOWN" : "UP"));
+        LOG_INFO(Input, "Registering callback with handle {} for key 0x{:X}, modifiers 0x{:X}, event type {}", handle,
+                 binding.key, binding.modifiers, EventTypeName(binding.type));
 
-        auto& keyCallbacks = _registeredCallbacks[dxScanCode];
-        auto& targetMap = (eventType == KeyEventType::KEY_DOWN) ? keyCallbacks.down : keyCallbacks.up;
-        targetMap[handle] = std::move(callback);
+        auto next = std::make_unique<Snapshot>(*_snapshot.load(std::memory_order_relaxed));
+        auto& slot = next->keys[binding.key];
+        auto entry = slot ? std::make_shared<KeyEntry>(*slot) : std::make_shared<KeyEntry>();
+        entry->For(binding.modifiers)
+            .For(binding.type)
+            .push_back({handle, std::make_shared<const KeyCallback>(std::move(callback)), binding.holdSeconds});
+        slot = std::move(entry);
+        PublishLocked(std::move(next));
 
-        _handleMap[handle] = {dxScanCode, eventType};
+        _handleMap[handle] = {binding};
 
         return handle;
     }
 
     void KeyHandler::Unregister(KeyHandlerEvent handle) {
         if (handle == INVALID_REGISTRATION_HANDLE) {
-            logger::warn("Attempted to unregister with an invalid handle.");
+            LOG_WARN(Input, "Attempted to unregister with an invalid handle.");
             return;
         }
 
-        CallbackInfo info;
-        bool foundHandle = false;
-
-        std::unique_lock lock(_mutex);
+        std::lock_guard lock(_mutex);
 
         auto handleIt = _handleMap.find(handle);
-        if (handleIt != _handleMap.end()) {
-            info = handleIt->second;
-            foundHandle = true;
-            _handleMap.erase(handleIt);
-        } else {
-            logger::warn(
+        if (handleIt == _handleMap.end()) {
+            LOG_WARN(Input,
                 "Attempted to unregister handle {}, but it was not found. It might have been already unregistered.",
                 handle);
             return;
         }
+        const KeyBinding binding = handleIt->second.binding;
+        _handleMap.erase(handleIt);
 
-        auto keyCallbacksIt = _registeredCallbacks.find(info.key);
-        if (keyCallbacksIt != _registeredCallbacks.end()) {
-            auto& keyCallbacks = keyCallbacksIt->second;
-            auto& targetMap = (info.type == KeyEventType::KEY_DOWN) ? keyCallbacks.down : keyCallbacks.up;
+        auto next = std::make_unique<Snapshot>(*_snapshot.load(std::memory_order_relaxed));
+        auto& slot = next->keys[binding.key];
+        if (!slot) {
+            LOG_ERROR(Input, "Inconsistency detected: Handle {} found in handle map but key 0x{:X} has no bindings.",
+                      handle, binding.key);
+            return;
+        }
 
-            size_t removedCount = targetMap.erase(handle);
+        auto entry = std::make_shared<KeyEntry>(*slot);
+        const size_t removedCount = std::erase_if(entry->For(binding.modifiers).For(binding.type),
+                                                  [handle](const Binding& b) { return b.handle == handle; });
 
-            if (removedCount > 0) {
-                logger::info("Unregistered callback with handle {} for key 0x{:X}, event type {}", handle, info.key,
-                             (info.type == KeyEventType::KEY_DOWN ? "DOWN" : "UP"));
-            } else {
-                logger::error(
-                    "Inconsistency detected: Handle {} found in handle map but corresponding callback not found for "
-                    "key "
-                    "0x{:X}.",
-                    handle, info.key);
-            }
+        if (removedCount == 0) {
+            LOG_ERROR(Input,
+                "Inconsistency detected: Handle {} found in handle map but corresponding callback not found for key "
+                "0x{:X}.",
+                handle, binding.key);
+            return;
+        }
+
+        slot = std::move(entry);
+        PublishLocked(std::move(next));
+        LOG_INFO(Input, "Unregistered callback with handle {} for key 0x{:X}, event type {}", handle, binding.key,
+                 EventTypeName(binding.type));
+    }
 
-            if (keyCallbacks.down.empty() && keyCallbacks.up.empty()) {
-                logger::debug("Removing empty key entry 0x{:X} from callback map.", info.key);
-                _registeredCallbacks.erase(keyCallbacksIt);
+    uint8_t KeyHandler::HeldModifiers() noexcept {
+        constexpr std::array<uint32_t, 6> kModifierKeys{0x2A, 0x36, 0x1D, 0x9D, 0x38, 0xB8};
+#ifdef _WIN32
+        // Alt-Tab hands the key-up to another window; ask the OS before trusting a modifier
+        constexpr std::array<int, 6> kVirtualKeys{VK_LSHIFT, VK_RSHIFT, VK_LCONTROL, VK_RCONTROL, VK_LMENU, VK_RMENU};
+#endif
+        uint8_t modifiers = kModifierNone;
+        for (size_t i = 0; i < kModifierKeys.size(); ++i) {
+            auto& state = _keyStates[kModifierKeys[i]];
+#ifdef _WIN32
+            if (state.pressed && (::GetAsyncKeyState(kVirtualKeys[i]) & 0x8000) == 0) {
+                state = {};
             }
+#endif
+            if (state.pressed) {
+                modifiers |= ModifierForScanCode(kModifierKeys[i]);
+            }
+        }
+        return modifiers;
+    }
 
-        } else {
-            logger::error(
-                "Inconsistency detected: Handle {} found in handle map but key 0x{:X} not found in callback map.",
-                handle, info.key);
+    void KeyHandler::Run(const std::vector<Binding>& bindings) {
+        for (const auto& binding : bindings) {
+            (*binding.callback)();
+        }
+    }
+
+    void KeyHandler::RunHolds(const std::vector<Binding>& bindings, float previous, float current) {
+        // Each hold fires once, on the first event that crosses its threshold
+        for (const auto& binding : bindings) {
+            if (previous < binding.holdSeconds && binding.holdSeconds <= current) {
+                (*binding.callback)();
+            }
         }
     }
 
@@ -103,8 +202,15 @@ namespace SkyrimNetUI {
         if (!a_eventList) {
             return RE::BSEventNotifyControl::kContinue;
         }
+        Metrics::ScopedTimer timer(Metrics::Metric::KeyEvent);
 
-        std::vector<KeyCallback> callbacksToRun;
+        // Snapshots are immutable and never freed while the handler lives, so callbacks can run
+        // straight from it even if they register or unregister bindings themselves
+        const Snapshot* snapshot = _snapshot.load(std::memory_order_acquire);
+
+        if (_resetPending.exchange(false, std::memory_order_acq_rel)) {
+            _keyStates.fill({});
+        }
 
         for (auto event = *a_eventList; event; event = event->next) {
             if (event->eventType != RE::INPUT_EVENT_TYPE::kButton) {
@@ -117,36 +223,43 @@ namespace SkyrimNetUI {
             }
 
             const uint32_t dxScanCode = buttonEvent->GetIDCode();
-            KeyEventType eventType;
-
-            if (buttonEvent->IsDown()) {
-                eventType = KeyEventType::KEY_DOWN;
-            } else if (buttonEvent->IsUp()) {
-                eventType = KeyEventType::KEY_UP;
-            } else {
+            if (dxScanCode >= kMaxScanCodes) {
                 continue;
             }
 
-            std::shared_lock lock(_mutex);
-
-            auto keyCallbacksIt = _registeredCallbacks.find(dxScanCode);
-            if (keyCallbacksIt != _registeredCallbacks.end()) {
-                const auto& keyCallbacks = keyCallbacksIt->second;
-                const auto& targetMap = (eventType == KeyEventType::KEY_DOWN) ? keyCallbacks.down : keyCallbacks.up;
+            // Modifier state is tracked for every key so chords see presses made before the key
+            auto& state = _keyStates[dxScanCode];
+            const float previousHeld = state.heldSeconds;
+            state.pressed = buttonEvent->IsPressed();
+            state.heldSeconds = state.pressed ? buttonEvent->HeldDuration() : 0.0f;
 
-                if (!targetMap.empty()) {
-                    callbacksToRun.reserve(callbacksToRun.size() + targetMap.size());
-                    for (const auto& pair : targetMap) {
-                        callbacksToRun.push_back(pair.second);
-                    }
-                }
+            const KeyEntry* entry = snapshot->keys[dxScanCode].get();
+            if (!entry) {
+                continue;
             }
-        }
+            const uint8_t modifiers = HeldModifiers() & ~ModifierForScanCode(dxScanCode);
+            const Triggers& exact = entry->exact[modifiers];
+            const Triggers& any = entry->any;
+
+            if (buttonEvent->IsDown()) {
+                Run(exact.down);
+                Run(any.down);
 
-        if (!callbacksToRun.empty()) {
-            logger::debug("Executing {} collected callbacks...", callbacksToRun.size());
-            for (const auto& callback : callbacksToRun) {
-                callback();
+                const auto now = std::chrono::steady_clock::now();
+                if (state.tapArmed && now - state.lastTap <= kDoubleTapWindow) {
+                    state.tapArmed = false;
+                    Run(exact.doubleTap);
+                    Run(any.doubleTap);
+                } else {
+                    state.tapArmed = true;
+                    state.lastTap = now;
+                }
+            } else if (buttonEvent->IsHeld()) {
+                RunHolds(exact.hold, previousHeld, state.heldSeconds);
+                RunHolds(any.hold, previousHeld, state.heldSeconds);
+            } else if (buttonEvent->IsUp()) {
+                Run(exact.up);
+                Run(any.up);
             }
         }
 
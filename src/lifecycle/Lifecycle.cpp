@@ -0,0 +1,121 @@
+#include "lifecycle/Lifecycle.h"
+
+#include <algorithm>
+#include <ranges>
+
+#include "logging/Log.h"
+#include "pch.h"
+
+namespace SkyrimNetUI::Lifecycle {
+
+    namespace {
+        constexpr std::string_view ReasonName(Reason reason) {
+            switch (reason) {
+                case Reason::Loading:
+                    return "loading";
+                case Reason::LoadingScreen:
+                    return "loading screen";
+                case Reason::Paused:
+                    return "paused";
+                case Reason::ViewHidden:
+                    return "view hidden";
+            }
+            return "unknown";
+        }
+    }
+
+    Manager& GetManager() {
+        static Manager instance;
+        return instance;
+    }
+
+    void Manager::Register(std::string name, ReasonMask suspendOn, std::function<void()> resume,
+                           std::function<void()> suspend) {
+        std::lock_guard lock(mutex_);
+        auto it = std::ranges::find(services_, name, &Service::name);
+        if (it != services_.end()) {
+            if (it->running) {
+                it->suspend();
+                ++stats_.suspends;
+            }
+            services_.erase(it);
+        }
+
+        auto& service =
+            services_.emplace_back(Service{std::move(name), suspendOn, std::move(resume), std::move(suspend)});
+        UpdateLocked(service);
+    }
+
+    void Manager::UnregisterAll() {
+        std::lock_guard lock(mutex_);
+        for (auto& service : std::views::reverse(services_)) {
+            if (service.running) {
+                service.suspend();
+                ++stats_.suspends;
+            }
+        }
+        services_.clear();
+    }
+
+    void Manager::Set(Reason reason, bool active) {
+        std::lock_guard lock(mutex_);
+        const ReasonMask previous = active_;
+        active_ = active ? (active_ | Mask(reason)) : (active_ & ~Mask(reason));
+        if (active_ == previous) {
+            return;
+        }
+        LOG_DEBUG(Core, "Background work {} ({})", active ? "suspend requested" : "resume requested",
+                  ReasonName(reason));
+
+        // Stop dependants before what they depend on, start in the opposite order
+        if (active) {
+            for (auto& service : std::views::reverse(services_)) {
+                UpdateLocked(service);
+            }
+        } else {
+            for (auto& service : services_) {
+                UpdateLocked(service);
+            }
+        }
+    }
+
+    void Manager::UpdateLocked(Service& service) {
+        const bool shouldRun = (service.suspendOn & active_) == 0;
+        if (shouldRun == service.running) {
+            return;
+        }
+
+        service.running = shouldRun;
+        if (shouldRun) {
+            ++stats_.resumes;
+            LOG_DEBUG(Core, "Resuming {}", service.name);
+            service.resume();
+        } else {
+            ++stats_.suspends;
+            LOG_DEBUG(Core, "Suspending {}", service.name);
+            service.suspend();
+        }
+    }
+
+    bool Manager::IsActive(Reason reason) const {
+        std::lock_guard lock(mutex_);
+        return (active_ & Mask(reason)) != 0;
+    }
+
+    bool Manager::IsAnyActive(ReasonMask reasons) const {
+        std::lock_guard lock(mutex_);
+        return (active_ & reasons) != 0;
+    }
+
+    bool Manager::IsRunning(std::string_view name) const {
+        std::lock_guard lock(mutex_);
+        auto it = std::ranges::find(services_, name, &Service::name);
+        return it != services_.end() && it->running;
+    }
+
+    Manager::Stats Manager::GetStats() const {
+        std::lock_guard lock(mutex_);
+        return stats_;
+    }
+
+}  // namespace SkyrimNetUI::Lifecycle
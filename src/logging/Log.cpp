@@ -0,0 +1,157 @@
+#include "logging/Log.h"
+
+#include <spdlog/async.h>
+#include <spdlog/async_logger.h>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+
+#include "config/IniFile.h"
+#include "pch.h"
+#include "scheduler/TaskScheduler.h"
+
+namespace SkyrimNetUI::Log {
+
+    namespace detail {
+        std::array<std::atomic<uint8_t>, kSubsystemCount> g_levels{
+            {{SPDLOG_LEVEL_INFO}, {SPDLOG_LEVEL_INFO}, {SPDLOG_LEVEL_INFO}, {SPDLOG_LEVEL_INFO}, {SPDLOG_LEVEL_INFO}}};
+    }
+
+    namespace {
+        constexpr std::array<std::string_view, kSubsystemCount> kSubsystemNames{"Core", "Http", "GameMaster", "UI",
+                                                                                 "Input"};
+        constexpr size_t kDefaultQueueSize = 8192;
+        constexpr auto kReloadInterval = std::chrono::seconds(5);
+
+        std::mutex g_mutex;
+        std::shared_ptr<spdlog::details::thread_pool> g_threadPool;
+        size_t g_queueCapacity = 0;
+        std::filesystem::file_time_type g_settingsWriteTime;
+        Scheduler::TaskHandle g_reloadTask;
+
+        bool EqualsIgnoreCase(std::string_view lhs, std::string_view rhs) {
+            return std::ranges::equal(lhs, rhs, [](char a, char b) {
+                return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+            });
+        }
+
+        std::optional<spdlog::level::level_enum> ParseLevel(std::optional<std::string_view> text) {
+            if (!text) {
+                return std::nullopt;
+            }
+            // spdlog::level::from_str maps unknown names to "off", so match explicitly
+            for (int level = spdlog::level::trace; level < spdlog::level::n_levels; ++level) {
+                const auto name = spdlog::level::to_string_view(static_cast<spdlog::level::level_enum>(level));
+                if (EqualsIgnoreCase(std::string_view(name.data(), name.size()), *text)) {
+                    return static_cast<spdlog::level::level_enum>(level);
+                }
+            }
+            if (EqualsIgnoreCase(*text, "warn")) {
+                return spdlog::level::warn;
+            }
+            return std::nullopt;
+        }
+
+        void ApplyLevels(const Config::IniFile& settings) {
+            const auto defaultLevel = ParseLevel(settings.Get("Logging", "Level")).value_or(spdlog::level::info);
+
+            auto minimum = spdlog::level::off;
+            for (size_t i = 0; i < kSubsystemCount; ++i) {
+                const auto level = ParseLevel(settings.Get("Logging", kSubsystemNames[i])).value_or(defaultLevel);
+                detail::g_levels[i].store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+                minimum = std::min(minimum, level);
+            }
+
+            // The gated macros have already filtered by subsystem; the logger only needs to pass them through
+            spdlog::default_logger()->set_level(std::min(minimum, defaultLevel));
+        }
+
+        std::optional<std::filesystem::file_time_type> SettingsWriteTime() {
+            std::error_code error;
+            auto time = std::filesystem::last_write_time(Config::kSettingsPath, error);
+            return error ? std::nullopt : std::optional(time);
+        }
+
+        void ReloadIfChanged() {
+            auto writeTime = SettingsWriteTime();
+            {
+                std::lock_guard lock(g_mutex);
+                if (!writeTime || *writeTime == g_settingsWriteTime) {
+                    return;
+                }
+                g_settingsWriteTime = *writeTime;
+            }
+
+            if (auto settings = Config::IniFile::Load(Config::kSettingsPath)) {
+                ApplyLevels(*settings);
+                logger::info("Reloaded log levels from {}", Config::kSettingsPath);
+            }
+        }
+    }
+
+    void Initialize() {
+        std::lock_guard lock(g_mutex);
+        if (g_threadPool) {
+            return;
+        }
+
+        const auto& settings = Config::GetSettings();
+        g_queueCapacity = static_cast<size_t>(
+            std::clamp<int64_t>(settings.GetInt("Logging", "QueueSize", kDefaultQueueSize), 128, 1 << 20));
+
+        // Blocking keeps every message but can stall the game thread when the disk is slow
+        const bool block = EqualsIgnoreCase(settings.Get("Logging", "Overflow").value_or("drop"), "block");
+        const auto policy =
+            block ? spdlog::async_overflow_policy::block : spdlog::async_overflow_policy::overrun_oldest;
+
+        auto current = spdlog::default_logger();
+        g_threadPool = std::make_shared<spdlog::details::thread_pool>(g_queueCapacity, 1);
+        auto async = std::make_shared<spdlog::async_logger>(current->name(), current->sinks().begin(),
+                                                            current->sinks().end(), g_threadPool, policy);
+        async->flush_on(spdlog::level::warn);
+        spdlog::set_default_logger(std::move(async));
+
+        ApplyLevels(settings);
+        g_settingsWriteTime = SettingsWriteTime().value_or(std::filesystem::file_time_type{});
+        g_reloadTask = Scheduler::GetScheduler().PostPeriodic(Scheduler::Lane::Background, kReloadInterval,
+                                                              ReloadIfChanged, kReloadInterval);
+
+        logger::info("Asynchronous logging enabled (queue {} messages, {} on overflow)", g_queueCapacity,
+                     block ? "block" : "drop oldest");
+    }
+
+    void Shutdown() {
+        std::shared_ptr<spdlog::details::thread_pool> pool;
+        {
+            std::lock_guard lock(g_mutex);
+            g_reloadTask.Cancel();
+            pool = std::move(g_threadPool);
+        }
+        if (!pool) {
+            return;
+        }
+
+        // Write everything queued, then log synchronously so messages during unload still land
+        auto async = spdlog::default_logger();
+        async->flush();
+        auto sync = std::make_shared<spdlog::logger>(async->name(), async->sinks().begin(), async->sinks().end());
+        sync->set_level(async->level());
+        sync->flush_on(spdlog::level::warn);
+        spdlog::set_default_logger(std::move(sync));
+    }
+
+    Stats GetStats() {
+        std::lock_guard lock(g_mutex);
+        Stats stats;
+        stats.queueCapacity = g_queueCapacity;
+        if (g_threadPool) {
+            stats.queued = g_threadPool->queue_size();
+            stats.overruns = g_threadPool->overrun_counter();
+        }
+        return stats;
+    }
+
+}  // namespace SkyrimNetUI::Log
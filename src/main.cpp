@@ -1,5 +1,8 @@
 // Ensure pch.h is included first for logger and SKSE types
 #include "pch.h"
+#include "lifecycle/Lifecycle.h"
+#include "logging/Log.h"
+#include "metrics/Metrics.h"
 #include "ui/UIBridge.h"
 
 // SKSE message handler for plugin initialization
@@ -8,6 +11,15 @@ static void SKSEMessageHandler(SKSE::MessagingInterface::Message* message) {
         case SKSE::MessagingInterface::kDataLoaded:
             SkyrimNetUI::UI::Initialize();
             break;
+        // Nothing is polled while a save loads. The loading screen menu is tracked separately in
+        // UIBridge, since it can stay open after the save has loaded.
+        case SKSE::MessagingInterface::kPreLoadGame:
+            SkyrimNetUI::Lifecycle::GetManager().Suspend(SkyrimNetUI::Lifecycle::Reason::Loading);
+            break;
+        case SKSE::MessagingInterface::kPostLoadGame:
+        case SKSE::MessagingInterface::kNewGame:
+            SkyrimNetUI::Lifecycle::GetManager().Resume(SkyrimNetUI::Lifecycle::Reason::Loading);
+            break;
     }
 }
 
@@ -17,6 +29,18 @@ extern "C" DLLEXPORT bool SKSEAPI SKSEPlugin_Load(const SKSE::LoadInterface* a_s
     logger::init();
     // pattern: [2024-01-01 12:00:00.000] [info] [1234] [sourcefile.cpp:123] Log message
     spdlog::set_pattern("[%Y-%m-%d %T.%e] [%l] [%t] [%s:%#] %v");
+    // Move file I/O off the game threads; levels come from the [Logging] section of the settings file
+    SkyrimNetUI::Log::Initialize();
+    // Latency histograms are written next to the log; [Metrics] DumpIntervalSeconds sets the period
+    if (auto directory = logger::log_directory()) {
+        SkyrimNetUI::Metrics::StartPeriodicDump(*directory);
+        SkyrimNetUI::Lifecycle::GetManager().Register(
+            "Metrics dump",
+            SkyrimNetUI::Lifecycle::kLoadingReasons |
+                SkyrimNetUI::Lifecycle::Mask(SkyrimNetUI::Lifecycle::Reason::Paused),
+            []() { SkyrimNetUI::Metrics::SetPeriodicDumpSuspended(false); },
+            []() { SkyrimNetUI::Metrics::SetPeriodicDumpSuspended(true); });
+    }
 
     logger::info("{} v{} by {}", SKSE::GetPluginName(), SKSE::GetPluginVersion(), SKSE::GetPluginAuthor());
     logger::info("  built using CommonLibSSE-NG v{}", COMMONLIBSSE_VERSION);
@@ -38,4 +62,8 @@ extern "C" DLLEXPORT bool SKSEAPI SKSEPlugin_Load(const SKSE::LoadInterface* a_s
 }
 
 // Clean up on plugin unload
-extern "C" DLLEXPORT void SKSEAPI SKSEPlugin_Unload() { SkyrimNetUI::UI::Shutdown(); }
+extern "C" DLLEXPORT void SKSEAPI SKSEPlugin_Unload() {
+    SkyrimNetUI::Metrics::StopPeriodicDump();
+    SkyrimNetUI::UI::Shutdown();
+    SkyrimNetUI::Log::Shutdown();
+}
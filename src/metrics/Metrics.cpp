@@ -0,0 +1,294 @@
+#include "metrics/Metrics.h"
+
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "config/IniFile.h"
+#include "pch.h"
+#include "scheduler/TaskScheduler.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#include <Psapi.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace SkyrimNetUI::Metrics {
+
+    namespace {
+        constexpr std::array<std::string_view, kMetricCount> kMetricNames{"HttpGet", "HttpPost", "Toggle", "KeyEvent",
+                                                                          "InteropFlush"};
+        constexpr std::array<std::string_view, kCounterCount> kCounterNames{
+            "HttpFailures", "HttpMerged", "HttpCacheHits", "ProxyHits", "ToggleFailures", "InteropCalls", "FeedEvents"};
+        constexpr const char* kDumpFileName = "PrismaUI-SkyrimNet-UI-metrics.json";
+
+        // Log-linear buckets: values below 16 ns are exact, above that each power of two is split in 16
+        constexpr unsigned kSubBucketBits = 4;
+        constexpr uint64_t kSubBuckets = 1u << kSubBucketBits;
+        constexpr unsigned kMaxExponent = 43;  // ~2.4 hours; larger samples land in the last bucket
+        constexpr size_t kBucketCount = (kMaxExponent - kSubBucketBits + 2) * kSubBuckets;
+
+        size_t BucketIndex(uint64_t value) noexcept {
+            if (value < kSubBuckets) {
+                return static_cast<size_t>(value);
+            }
+            const auto exponent = static_cast<unsigned>(std::bit_width(value)) - 1;
+            if (exponent > kMaxExponent) {
+                return kBucketCount - 1;
+            }
+            const uint64_t mantissa = (value >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+            return (exponent - kSubBucketBits + 1) * kSubBuckets + static_cast<size_t>(mantissa);
+        }
+
+        uint64_t BucketLowerBound(size_t index) noexcept {
+            if (index < kSubBuckets) {
+                return index;
+            }
+            const unsigned exponent = static_cast<unsigned>(index / kSubBuckets) + kSubBucketBits - 1;
+            return (kSubBuckets + index % kSubBuckets) << (exponent - kSubBucketBits);
+        }
+
+        // Each shard is written only by its owning thread, so plain load/store pairs are enough;
+        // readers merging shards concurrently may see a sample late but never a torn value.
+        void Add(std::atomic<uint64_t>& target, uint64_t amount) noexcept {
+            target.store(target.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        struct Histogram {
+            std::atomic<uint64_t> count{0};
+            std::atomic<uint64_t> totalNanos{0};
+            std::atomic<uint64_t> maxNanos{0};
+            std::array<std::atomic<uint64_t>, kBucketCount> buckets{};
+        };
+
+        struct Shard {
+            std::array<Histogram, kMetricCount> histograms;
+            std::array<std::atomic<uint64_t>, kCounterCount> counters{};
+        };
+
+        // Shards outlive their threads so samples from finished threads stay in the totals
+        std::mutex g_shardMutex;
+        std::vector<std::unique_ptr<Shard>> g_shards;
+
+        std::mutex g_dumpMutex;
+        Scheduler::TaskHandle g_dumpTask;
+        std::filesystem::path g_dumpPath;
+        std::chrono::seconds g_dumpInterval{0};  ///< 0 until StartPeriodicDump
+        bool g_dumpSuspended = false;
+
+        Shard& LocalShard() {
+            thread_local Shard* shard = []() {
+                auto owned = std::make_unique<Shard>();
+                Shard* raw = owned.get();
+                std::lock_guard lock(g_shardMutex);
+                g_shards.push_back(std::move(owned));
+                return raw;
+            }();
+            return *shard;
+        }
+
+        uint64_t Percentile(const std::array<uint64_t, kBucketCount>& buckets, uint64_t count, double quantile,
+                            uint64_t maxNanos) {
+            if (count == 0) {
+                return 0;
+            }
+            const auto rank = static_cast<uint64_t>(quantile * static_cast<double>(count - 1)) + 1;
+            uint64_t seen = 0;
+            for (size_t i = 0; i < kBucketCount; ++i) {
+                seen += buckets[i];
+                if (seen >= rank) {
+                    // Report the bucket's upper bound, but never more than the largest sample
+                    const uint64_t upper = i + 1 < kBucketCount ? BucketLowerBound(i + 1) - 1 : maxNanos;
+                    return std::min(upper, maxNanos);
+                }
+            }
+            return maxNanos;
+        }
+
+        void AppendMicros(std::string& out, std::string_view name, uint64_t nanos) {
+            const uint64_t micros = nanos / 1000;
+            const uint64_t fraction = (nanos % 1000) / 10;
+            out.append("\"").append(name).append("\":").append(std::to_string(micros)).append(".");
+            if (fraction < 10) {
+                out.push_back('0');
+            }
+            out.append(std::to_string(fraction));
+        }
+
+        void WriteDump(const std::filesystem::path& path) {
+            const std::string json = ToJson(TakeSnapshot());
+
+            // Write beside the target and rename so readers never see a partial file
+            auto temporary = path;
+            temporary += ".tmp";
+            {
+                std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+                if (!file || !file.write(json.data(), static_cast<std::streamsize>(json.size()))) {
+                    logger::warn("Failed to write metrics to {}", temporary.string());
+                    return;
+                }
+            }
+            std::error_code error;
+            std::filesystem::rename(temporary, path, error);
+            if (error) {
+                logger::warn("Failed to replace {}: {}", path.string(), error.message());
+            }
+        }
+
+        // Caller holds g_dumpMutex
+        void PostDumpLocked() {
+            g_dumpTask.Cancel();
+            if (g_dumpSuspended || g_dumpInterval <= std::chrono::seconds::zero()) {
+                return;
+            }
+            g_dumpTask = Scheduler::GetScheduler().PostPeriodic(
+                Scheduler::Lane::Background, g_dumpInterval, [path = g_dumpPath]() { WriteDump(path); },
+                g_dumpInterval);
+        }
+    }
+
+    void Record(Metric metric, std::chrono::nanoseconds elapsed) noexcept {
+        const auto nanos = static_cast<uint64_t>(std::max<int64_t>(elapsed.count(), 0));
+        auto& histogram = LocalShard().histograms[static_cast<size_t>(metric)];
+        Add(histogram.count, 1);
+        Add(histogram.totalNanos, nanos);
+        Add(histogram.buckets[BucketIndex(nanos)], 1);
+        if (nanos > histogram.maxNanos.load(std::memory_order_relaxed)) {
+            histogram.maxNanos.store(nanos, std::memory_order_relaxed);
+        }
+    }
+
+    void Increment(Counter counter, uint64_t amount) noexcept {
+        Add(LocalShard().counters[static_cast<size_t>(counter)], amount);
+    }
+
+    Snapshot TakeSnapshot() {
+        Snapshot snapshot;
+        std::array<std::array<uint64_t, kBucketCount>, kMetricCount> buckets{};
+
+        {
+            std::lock_guard lock(g_shardMutex);
+            for (const auto& shard : g_shards) {
+                for (size_t m = 0; m < kMetricCount; ++m) {
+                    const auto& histogram = shard->histograms[m];
+                    auto& merged = snapshot.histograms[m];
+                    merged.count += histogram.count.load(std::memory_order_relaxed);
+                    merged.totalNanos += histogram.totalNanos.load(std::memory_order_relaxed);
+                    merged.maxNanos = std::max(merged.maxNanos, histogram.maxNanos.load(std::memory_order_relaxed));
+                    for (size_t b = 0; b < kBucketCount; ++b) {
+                        buckets[m][b] += histogram.buckets[b].load(std::memory_order_relaxed);
+                    }
+                }
+                for (size_t c = 0; c < kCounterCount; ++c) {
+                    snapshot.counters[c] += shard->counters[c].load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        for (size_t m = 0; m < kMetricCount; ++m) {
+            auto& merged = snapshot.histograms[m];
+            // Bucket totals are the authoritative count when a sample lands mid-merge
+            uint64_t count = 0;
+            for (uint64_t value : buckets[m]) {
+                count += value;
+            }
+            merged.count = count;
+            merged.p50Nanos = Percentile(buckets[m], count, 0.50, merged.maxNanos);
+            merged.p90Nanos = Percentile(buckets[m], count, 0.90, merged.maxNanos);
+            merged.p99Nanos = Percentile(buckets[m], count, 0.99, merged.maxNanos);
+        }
+        return snapshot;
+    }
+
+    std::string_view Name(Metric metric) noexcept { return kMetricNames[static_cast<size_t>(metric)]; }
+
+    std::string_view Name(Counter counter) noexcept { return kCounterNames[static_cast<size_t>(counter)]; }
+
+    std::string ToJson(const Snapshot& snapshot) {
+        std::string json = "{\"histograms\":{";
+        for (size_t m = 0; m < kMetricCount; ++m) {
+            const auto& histogram = snapshot.histograms[m];
+            json.append(m == 0 ? "\"" : ",\"").append(kMetricNames[m]).append("\":{\"count\":");
+            json.append(std::to_string(histogram.count)).push_back(',');
+            AppendMicros(json, "meanUs", histogram.count ? histogram.totalNanos / histogram.count : 0);
+            json.push_back(',');
+            AppendMicros(json, "p50Us", histogram.p50Nanos);
+            json.push_back(',');
+            AppendMicros(json, "p90Us", histogram.p90Nanos);
+            json.push_back(',');
+            AppendMicros(json, "p99Us", histogram.p99Nanos);
+            json.push_back(',');
+            AppendMicros(json, "maxUs", histogram.maxNanos);
+            json.push_back('}');
+        }
+        json.append("},\"counters\":{");
+        for (size_t c = 0; c < kCounterCount; ++c) {
+            json.append(c == 0 ? "\"" : ",\"").append(kCounterNames[c]).append("\":");
+            json.append(std::to_string(snapshot.counters[c]));
+        }
+        json.append("}}");
+        return json;
+    }
+
+    uint64_t ProcessPrivateBytes() noexcept {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS_EX counters{};
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&counters),
+                                  sizeof(counters))) {
+            return 0;
+        }
+        return counters.PrivateUsage;
+#else
+        // Headless builds: resident pages not shared with other processes
+        std::ifstream statm("/proc/self/statm");
+        uint64_t size = 0;
+        uint64_t resident = 0;
+        uint64_t shared = 0;
+        if (!(statm >> size >> resident >> shared) || shared > resident) {
+            return 0;
+        }
+        return (resident - shared) * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }
+
+    void StartPeriodicDump(const std::filesystem::path& directory) {
+        const auto seconds = Config::GetSettings().GetInt("Metrics", "DumpIntervalSeconds", 60);
+        if (seconds <= 0) {
+            logger::info("Metrics dump disabled");
+            return;
+        }
+
+        std::lock_guard lock(g_dumpMutex);
+        g_dumpPath = directory / kDumpFileName;
+        g_dumpInterval = std::chrono::seconds(seconds);
+        PostDumpLocked();
+        logger::info("Writing metrics to {} every {} s", g_dumpPath.string(), seconds);
+    }
+
+    void StopPeriodicDump() {
+        std::lock_guard lock(g_dumpMutex);
+        g_dumpTask.Cancel();
+        g_dumpInterval = std::chrono::seconds::zero();
+    }
+
+    void SetPeriodicDumpSuspended(bool suspended) {
+        std::lock_guard lock(g_dumpMutex);
+        if (g_dumpSuspended == suspended) {
+            return;
+        }
+        g_dumpSuspended = suspended;
+        if (suspended) {
+            g_dumpTask.Cancel();
+        } else {
+            PostDumpLocked();
+        }
+    }
+
+}  // namespace SkyrimNetUI::Metrics
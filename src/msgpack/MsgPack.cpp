@@ -0,0 +1,327 @@
+#include "msgpack/MsgPack.h"
+
+#include <bit>
+#include <limits>
+
+#include "pch.h"
+
+namespace SkyrimNetUI::MsgPack {
+
+    namespace {
+        // Guards Skip against hostile or corrupt input
+        constexpr int kMaxDepth = 64;
+
+        uint8_t Marker(std::string_view data, size_t position) { return static_cast<uint8_t>(data[position]); }
+    }
+
+    void Writer::Header(uint8_t marker, uint64_t value, size_t bytes) {
+        data_.push_back(static_cast<char>(marker));
+        for (size_t i = bytes; i-- > 0;) {
+            data_.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+        }
+    }
+
+    void Writer::Nil() { data_.push_back(static_cast<char>(0xC0)); }
+
+    void Writer::Bool(bool value) { data_.push_back(static_cast<char>(value ? 0xC3 : 0xC2)); }
+
+    void Writer::Int(int64_t value) {
+        if (value >= 0) {
+            UInt(static_cast<uint64_t>(value));
+        } else if (value >= -32) {
+            data_.push_back(static_cast<char>(value));
+        } else if (value >= std::numeric_limits<int8_t>::min()) {
+            Header(0xD0, static_cast<uint64_t>(value), 1);
+        } else if (value >= std::numeric_limits<int16_t>::min()) {
+            Header(0xD1, static_cast<uint64_t>(value), 2);
+        } else if (value >= std::numeric_limits<int32_t>::min()) {
+            Header(0xD2, static_cast<uint64_t>(value), 4);
+        } else {
+            Header(0xD3, static_cast<uint64_t>(value), 8);
+        }
+    }
+
+    void Writer::UInt(uint64_t value) {
+        if (value <= 0x7F) {
+            data_.push_back(static_cast<char>(value));
+        } else if (value <= 0xFF) {
+            Header(0xCC, value, 1);
+        } else if (value <= 0xFFFF) {
+            Header(0xCD, value, 2);
+        } else if (value <= 0xFFFFFFFF) {
+            Header(0xCE, value, 4);
+        } else {
+            Header(0xCF, value, 8);
+        }
+    }
+
+    void Writer::Double(double value) { Header(0xCB, std::bit_cast<uint64_t>(value), 8); }
+
+    void Writer::String(std::string_view value) {
+        if (value.size() < 32) {
+            data_.push_back(static_cast<char>(0xA0 | value.size()));
+        } else if (value.size() <= 0xFF) {
+            Header(0xD9, value.size(), 1);
+        } else if (value.size() <= 0xFFFF) {
+            Header(0xDA, value.size(), 2);
+        } else {
+            Header(0xDB, value.size(), 4);
+        }
+        data_.append(value);
+    }
+
+    void Writer::Binary(std::string_view bytes) {
+        if (bytes.size() <= 0xFF) {
+            Header(0xC4, bytes.size(), 1);
+        } else if (bytes.size() <= 0xFFFF) {
+            Header(0xC5, bytes.size(), 2);
+        } else {
+            Header(0xC6, bytes.size(), 4);
+        }
+        data_.append(bytes);
+    }
+
+    void Writer::Array(uint32_t size) {
+        if (size < 16) {
+            data_.push_back(static_cast<char>(0x90 | size));
+        } else if (size <= 0xFFFF) {
+            Header(0xDC, size, 2);
+        } else {
+            Header(0xDD, size, 4);
+        }
+    }
+
+    void Writer::Map(uint32_t size) {
+        if (size < 16) {
+            data_.push_back(static_cast<char>(0x80 | size));
+        } else if (size <= 0xFFFF) {
+            Header(0xDE, size, 2);
+        } else {
+            Header(0xDF, size, 4);
+        }
+    }
+
+    Reader::Type Reader::Peek() const noexcept {
+        if (failed_) {
+            return Type::Invalid;
+        }
+        if (position_ >= data_.size()) {
+            return Type::End;
+        }
+
+        const uint8_t marker = Marker(data_, position_);
+        if (marker <= 0x7F || marker >= 0xE0 || (marker >= 0xCC && marker <= 0xD3)) {
+            return Type::Int;
+        }
+        if (marker <= 0x8F || marker == 0xDE || marker == 0xDF) {
+            return Type::Map;
+        }
+        if (marker <= 0x9F || marker == 0xDC || marker == 0xDD) {
+            return Type::Array;
+        }
+        if (marker <= 0xBF || (marker >= 0xD9 && marker <= 0xDB)) {
+            return Type::String;
+        }
+        switch (marker) {
+            case 0xC0:
+                return Type::Nil;
+            case 0xC2:
+            case 0xC3:
+                return Type::Bool;
+            case 0xC4:
+            case 0xC5:
+            case 0xC6:
+                return Type::Binary;
+            case 0xCA:
+            case 0xCB:
+                return Type::Double;
+            default:
+                // Extension types and the reserved 0xC1
+                return Type::Invalid;
+        }
+    }
+
+    std::nullopt_t Reader::Fail() noexcept {
+        failed_ = true;
+        return std::nullopt;
+    }
+
+    std::optional<uint64_t> Reader::Take(size_t bytes) noexcept {
+        if (failed_ || data_.size() - position_ < bytes) {
+            return Fail();
+        }
+        uint64_t value = 0;
+        for (size_t i = 0; i < bytes; ++i) {
+            value = (value << 8) | Marker(data_, position_++);
+        }
+        return value;
+    }
+
+    std::optional<std::string_view> Reader::TakeBytes(size_t length) noexcept {
+        if (failed_ || data_.size() - position_ < length) {
+            return Fail();
+        }
+        const auto bytes = data_.substr(position_, length);
+        position_ += length;
+        return bytes;
+    }
+
+    bool Reader::ReadNil() noexcept {
+        if (Peek() != Type::Nil) {
+            Fail();
+            return false;
+        }
+        ++position_;
+        return true;
+    }
+
+    std::optional<bool> Reader::ReadBool() noexcept {
+        if (Peek() != Type::Bool) {
+            return Fail();
+        }
+        return Marker(data_, position_++) == 0xC3;
+    }
+
+    std::optional<int64_t> Reader::ReadInt() noexcept {
+        if (Peek() != Type::Int) {
+            return Fail();
+        }
+        const uint8_t marker = Marker(data_, position_++);
+        if (marker <= 0x7F) {
+            return marker;
+        }
+        if (marker >= 0xE0) {
+            return static_cast<int8_t>(marker);
+        }
+
+        if (marker <= 0xCF) {
+            // uint8 to uint64
+            const auto value = Take(size_t{1} << (marker - 0xCC));
+            if (!value || *value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                return Fail();
+            }
+            return static_cast<int64_t>(*value);
+        }
+
+        // int8 to int64, sign-extended from their width
+        const size_t bytes = size_t{1} << (marker - 0xD0);
+        const auto value = Take(bytes);
+        if (!value) {
+            return std::nullopt;
+        }
+        const int shift = static_cast<int>(64 - bytes * 8);
+        return static_cast<int64_t>(*value << shift) >> shift;
+    }
+
+    std::optional<double> Reader::ReadDouble() noexcept {
+        const auto type = Peek();
+        if (type == Type::Int) {
+            const auto value = ReadInt();
+            return value ? std::optional<double>(static_cast<double>(*value)) : std::nullopt;
+        }
+        if (type != Type::Double) {
+            return Fail();
+        }
+        if (Marker(data_, position_++) == 0xCA) {
+            const auto bits = Take(4);
+            return bits ? std::optional<double>(std::bit_cast<float>(static_cast<uint32_t>(*bits))) : std::nullopt;
+        }
+        const auto bits = Take(8);
+        return bits ? std::optional<double>(std::bit_cast<double>(*bits)) : std::nullopt;
+    }
+
+    std::optional<std::string_view> Reader::ReadString() noexcept {
+        if (Peek() != Type::String) {
+            return Fail();
+        }
+        const uint8_t marker = Marker(data_, position_++);
+        if (marker <= 0xBF) {
+            return TakeBytes(marker & 0x1F);
+        }
+        const auto length = Take(size_t{1} << (marker - 0xD9));
+        return length ? TakeBytes(static_cast<size_t>(*length)) : std::nullopt;
+    }
+
+    std::optional<std::string_view> Reader::ReadBinary() noexcept {
+        if (Peek() != Type::Binary) {
+            return Fail();
+        }
+        const uint8_t marker = Marker(data_, position_++);
+        const auto length = Take(size_t{1} << (marker - 0xC4));
+        return length ? TakeBytes(static_cast<size_t>(*length)) : std::nullopt;
+    }
+
+    std::optional<uint32_t> Reader::ReadArray() noexcept {
+        if (Peek() != Type::Array) {
+            return Fail();
+        }
+        const uint8_t marker = Marker(data_, position_++);
+        if (marker <= 0x9F) {
+            return marker & 0x0F;
+        }
+        const auto size = Take(marker == 0xDC ? 2 : 4);
+        return size ? std::optional<uint32_t>(static_cast<uint32_t>(*size)) : std::nullopt;
+    }
+
+    std::optional<uint32_t> Reader::ReadMap() noexcept {
+        if (Peek() != Type::Map) {
+            return Fail();
+        }
+        const uint8_t marker = Marker(data_, position_++);
+        if (marker <= 0x8F) {
+            return marker & 0x0F;
+        }
+        const auto size = Take(marker == 0xDE ? 2 : 4);
+        return size ? std::optional<uint32_t>(static_cast<uint32_t>(*size)) : std::nullopt;
+    }
+
+    bool Reader::Skip() noexcept { return SkipDepth(0); }
+
+    bool Reader::SkipDepth(int depth) noexcept {
+        if (depth > kMaxDepth) {
+            Fail();
+            return false;
+        }
+        switch (Peek()) {
+            case Type::Nil:
+                return ReadNil();
+            case Type::Bool:
+                return ReadBool().has_value();
+            case Type::Int:
+                // Unsigned values too large for ReadInt are still valid here
+                if (Marker(data_, position_) == 0xCF) {
+                    ++position_;
+                    return Take(8).has_value();
+                }
+                return ReadInt().has_value();
+            case Type::Double:
+                return ReadDouble().has_value();
+            case Type::String:
+                return ReadString().has_value();
+            case Type::Binary:
+                return ReadBinary().has_value();
+            case Type::Array: {
+                const auto size = ReadArray();
+                for (uint32_t i = 0; size && i < *size; ++i) {
+                    if (!SkipDepth(depth + 1)) {
+                        return false;
+                    }
+                }
+                return size.has_value();
+            }
+            case Type::Map: {
+                const auto size = ReadMap();
+                for (uint32_t i = 0; size && i < *size; ++i) {
+                    if (!SkipDepth(depth + 1) || !SkipDepth(depth + 1)) {
+                        return false;
+                    }
+                }
+                return size.has_value();
+            }
+            default:
+                Fail();
+                return false;
+        }
+    }
+
+}  // namespace SkyrimNetUI::MsgPack
@@ -0,0 +1,248 @@
+#include "scheduler/TaskScheduler.h"
+
+#include <algorithm>
+
+#include "pch.h"
+
+namespace SkyrimNetUI::Scheduler {
+
+    namespace detail {
+        struct TaskState {
+            Task fn;
+            Lane lane = Lane::Background;
+            std::chrono::milliseconds period{0};  ///< Zero for one-shot tasks
+            Clock::time_point readyAt;            ///< When the task became runnable (for dispatch latency)
+            std::atomic<bool> cancelled{false};
+            std::atomic<bool> finished{false};    ///< One-shot task has run
+            std::atomic<bool> running{false};
+            std::atomic<std::thread::id> runner{};
+        };
+    }
+
+    void TaskHandle::Cancel() noexcept {
+        if (state_) {
+            state_->cancelled.store(true);
+        }
+    }
+
+    void TaskHandle::CancelAndWait() noexcept {
+        if (!state_) {
+            return;
+        }
+        state_->cancelled.store(true);
+        if (state_->runner.load() == std::this_thread::get_id()) {
+            return;  // Called from inside the task; waiting would deadlock
+        }
+        state_->running.wait(true);
+    }
+
+    bool TaskHandle::IsActive() const noexcept {
+        return state_ && !state_->cancelled.load() && !state_->finished.load();
+    }
+
+    TaskScheduler& GetScheduler() {
+        static TaskScheduler instance;
+        return instance;
+    }
+
+    TaskScheduler::TaskScheduler(size_t workerCount, size_t streamWorkerCount) {
+        workerCount = std::max<size_t>(workerCount, 2);
+        streamWorkerCount = std::max<size_t>(streamWorkerCount, 1);
+        workers_.reserve(workerCount + streamWorkerCount);
+        for (size_t i = 0; i < workerCount + streamWorkerCount; ++i) {
+            // Worker 0 is reserved for the UI lane, the last ones for the stream lane
+            const Role role = i == 0 ? Role::UIOnly : i < workerCount ? Role::Shared : Role::Stream;
+            workers_.emplace_back([this, role]() { WorkerLoop(role); });
+            threadsCreated_.fetch_add(1, std::memory_order_relaxed);
+        }
+        logger::info("Task scheduler started with {} workers and {} stream workers", workerCount, streamWorkerCount);
+    }
+
+    TaskScheduler::~TaskScheduler() { Shutdown(); }
+
+    void TaskScheduler::Shutdown() {
+        {
+            std::lock_guard lock(mutex_);
+            if (stopping_) {
+                return;
+            }
+            stopping_ = true;
+            uiQueue_.clear();
+            backgroundQueue_.clear();
+            streamQueue_.clear();
+            timers_ = {};
+        }
+        cv_.notify_all();
+
+        for (auto& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+        workers_.clear();
+    }
+
+    TaskHandle TaskScheduler::Post(Lane lane, Task task) {
+        return Schedule(lane, Clock::now(), std::chrono::milliseconds::zero(), std::move(task));
+    }
+
+    TaskHandle TaskScheduler::PostDelayed(Lane lane, std::chrono::milliseconds delay, Task task) {
+        return Schedule(lane, Clock::now() + delay, std::chrono::milliseconds::zero(), std::move(task));
+    }
+
+    TaskHandle TaskScheduler::PostPeriodic(Lane lane, std::chrono::milliseconds period, Task task,
+                                           std::chrono::milliseconds initialDelay) {
+        // A zero period would spin a worker; clamp to 1 ms
+        period = std::max(period, std::chrono::milliseconds(1));
+        return Schedule(lane, Clock::now() + initialDelay, period, std::move(task));
+    }
+
+    TaskHandle TaskScheduler::Schedule(Lane lane, Clock::time_point due, std::chrono::milliseconds period,
+                                       Task task) {
+        auto state = std::make_shared<detail::TaskState>();
+        state->fn = std::move(task);
+        state->lane = lane;
+        state->period = period;
+
+        {
+            std::lock_guard lock(mutex_);
+            if (stopping_) {
+                state->cancelled.store(true);
+                return TaskHandle(std::move(state));
+            }
+            EnqueueLocked(state, due);
+        }
+        cv_.notify_all();
+        return TaskHandle(std::move(state));
+    }
+
+    void TaskScheduler::EnqueueLocked(std::shared_ptr<detail::TaskState> task, Clock::time_point due) {
+        const auto now = Clock::now();
+        if (due <= now) {
+            task->readyAt = now;
+            PushReadyLocked(std::move(task));
+        } else {
+            timers_.push({due, nextSequence_++, std::move(task)});
+        }
+    }
+
+    void TaskScheduler::PushReadyLocked(std::shared_ptr<detail::TaskState> task) {
+        switch (task->lane) {
+            case Lane::UI:
+                uiQueue_.push_back(std::move(task));
+                break;
+            case Lane::Background:
+                backgroundQueue_.push_back(std::move(task));
+                break;
+            case Lane::Stream:
+                streamQueue_.push_back(std::move(task));
+                break;
+        }
+    }
+
+    bool TaskScheduler::PromoteDueTimersLocked(Clock::time_point now) {
+        bool promoted = false;
+        while (!timers_.empty() && timers_.top().due <= now) {
+            auto task = timers_.top().task;
+            timers_.pop();
+            if (task->cancelled.load()) {
+                continue;
+            }
+            task->readyAt = now;
+            PushReadyLocked(std::move(task));
+            promoted = true;
+        }
+        return promoted;
+    }
+
+    std::shared_ptr<detail::TaskState> TaskScheduler::NextReadyLocked(Role role) {
+        auto pop = [](auto& queue) -> std::shared_ptr<detail::TaskState> {
+            while (!queue.empty()) {
+                auto task = std::move(queue.front());
+                queue.pop_front();
+                if (!task->cancelled.load()) {
+                    return task;
+                }
+            }
+            return nullptr;
+        };
+
+        if (role == Role::Stream) {
+            return pop(streamQueue_);
+        }
+        if (auto task = pop(uiQueue_)) {
+            return task;
+        }
+        return role == Role::UIOnly ? nullptr : pop(backgroundQueue_);
+    }
+
+    void TaskScheduler::WorkerLoop(Role role) {
+        std::unique_lock lock(mutex_);
+        while (!stopping_) {
+            if (PromoteDueTimersLocked(Clock::now())) {
+                // Some of the promoted work may be for a lane this worker doesn't run
+                cv_.notify_all();
+            }
+
+            auto task = NextReadyLocked(role);
+            if (!task) {
+                if (timers_.empty()) {
+                    cv_.wait(lock);
+                } else {
+                    cv_.wait_until(lock, timers_.top().due);
+                }
+                continue;
+            }
+
+            // Claim the run under the lock so CancelAndWait can't miss it
+            task->runner.store(std::this_thread::get_id());
+            task->running.store(true);
+            lock.unlock();
+
+            const auto started = Clock::now();
+            const auto latency = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(started - task->readyAt).count());
+            totalDispatchMicros_.fetch_add(latency, std::memory_order_relaxed);
+            uint64_t previousMax = maxDispatchMicros_.load(std::memory_order_relaxed);
+            while (latency > previousMax &&
+                   !maxDispatchMicros_.compare_exchange_weak(previousMax, latency, std::memory_order_relaxed)) {
+            }
+            (task->lane == Lane::UI           ? uiTasksRun_
+             : task->lane == Lane::Background ? backgroundTasksRun_
+                                              : streamTasksRun_)
+                .fetch_add(1, std::memory_order_relaxed);
+
+            if (!task->cancelled.load()) {
+                try {
+                    task->fn();
+                } catch (const std::exception& e) {
+                    logger::error("Scheduled task threw: {}", e.what());
+                } catch (...) {
+                    logger::error("Scheduled task threw an unknown exception");
+                }
+            }
+
+            lock.lock();
+            if (task->period.count() > 0 && !task->cancelled.load() && !stopping_) {
+                EnqueueLocked(task, Clock::now() + task->period);
+            } else {
+                task->finished.store(true);
+            }
+            task->runner.store(std::thread::id{});
+            task->running.store(false);
+            task->running.notify_all();
+        }
+    }
+
+    TaskScheduler::Stats TaskScheduler::GetStats() const {
+        Stats stats;
+        stats.threadsCreated = threadsCreated_.load(std::memory_order_relaxed);
+        stats.uiTasksRun = uiTasksRun_.load(std::memory_order_relaxed);
+        stats.backgroundTasksRun = backgroundTasksRun_.load(std::memory_order_relaxed);
+        stats.streamTasksRun = streamTasksRun_.load(std::memory_order_relaxed);
+        stats.totalDispatchMicros = totalDispatchMicros_.load(std::memory_order_relaxed);
+        stats.maxDispatchMicros = maxDispatchMicros_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+}  // namespace SkyrimNetUI::Scheduler
@@ -0,0 +1,215 @@
+#include "skyrimnet/CommandJournal.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "logging/Log.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace SkyrimNetUI::SkyrimNet {
+
+    namespace {
+        bool IsFlag(int value) { return value == 0 || value == 1; }
+
+        FILE* OpenFile(const std::filesystem::path& path, bool append) {
+#ifdef _WIN32
+            return _wfopen(path.c_str(), append ? L"ab" : L"wb");
+#else
+            return std::fopen(path.c_str(), append ? "ab" : "wb");
+#endif
+        }
+
+        // Write and flush through to the disk, so the line survives a crash of the game
+        bool WriteDurably(const std::filesystem::path& path, const std::string& text, bool append) {
+            FILE* file = OpenFile(path, append);
+            if (!file) {
+                return false;
+            }
+            bool written = std::fwrite(text.data(), 1, text.size(), file) == text.size() && std::fflush(file) == 0;
+#ifdef _WIN32
+            written = written && _commit(_fileno(file)) == 0;
+#else
+            written = written && fsync(fileno(file)) == 0;
+#endif
+            return std::fclose(file) == 0 && written;
+        }
+
+        std::string FormatQueued(const JournalCommand& command) {
+            return "Q " + command.key + " " + command.name + " " + (command.value ? "1" : "0") + " " +
+                   (command.baseline ? "1" : "0") + "\n";
+        }
+    }
+
+    CommandJournal::CommandJournal(std::filesystem::path path) : path_(std::move(path)) {
+        std::error_code error;
+        std::filesystem::create_directories(path_.parent_path(), error);
+        Load();
+    }
+
+    void CommandJournal::Load() {
+        std::ifstream file(path_, std::ios::binary);
+        if (!file) {
+            return;
+        }
+        std::stringstream contents;
+        contents << file.rdbuf();
+        file.close();
+
+        size_t records = 0;
+        bool torn = false;
+        const std::string text = contents.str();
+        for (size_t start = 0; start < text.size();) {
+            const size_t end = text.find('\n', start);
+            if (end == std::string::npos) {
+                // Torn by a crash in the middle of an append; the call never returned
+                LOG_WARN(GameMaster, "Ignoring incomplete last line of command journal {}", path_.string());
+                torn = true;
+                break;
+            }
+            std::istringstream line(text.substr(start, end - start));
+            start = end + 1;
+            ++records;
+
+            std::string type;
+            JournalCommand command;
+            int value = -1;
+            int baseline = -1;
+            if (!(line >> type >> command.key)) {
+                continue;
+            }
+            if (type == "Q" && line >> command.name >> value >> baseline && IsFlag(value) && IsFlag(baseline)) {
+                command.value = value == 1;
+                command.baseline = baseline == 1;
+                // A crash between writing a replacement and completing what it replaced leaves both pending
+                if (!pending_.empty() && pending_.back().name == command.name) {
+                    pending_.pop_back();
+                }
+                pending_.push_back(std::move(command));
+            } else if (type == "D") {
+                std::erase_if(pending_, [&](const JournalCommand& queued) { return queued.key == command.key; });
+            }
+        }
+
+        // Start the next appends on a fresh file holding only what is still to do
+        if (torn || records > pending_.size()) {
+            std::string compacted;
+            for (const auto& command : pending_) {
+                compacted.append(FormatQueued(command));
+            }
+            auto temporary = path_;
+            temporary += ".tmp";
+            std::error_code error;
+            if (!WriteDurably(temporary, compacted, false)) {
+                error = std::make_error_code(std::errc::io_error);
+            } else {
+                std::filesystem::rename(temporary, path_, error);
+            }
+            if (error) {
+                LOG_WARN(GameMaster, "Failed to compact command journal {}: {}", path_.string(), error.message());
+            }
+        }
+
+        if (!pending_.empty()) {
+            LOG_INFO(GameMaster, "{} command(s) from a previous session wait for the SkyrimNet server",
+                     pending_.size());
+        }
+    }
+
+    std::string CommandJournal::NextKey() {
+        // Milliseconds since the epoch keep keys unique across sessions
+        const auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                             std::chrono::system_clock::now().time_since_epoch())
+                             .count();
+        return std::to_string(now) + "-" + std::to_string(nextKey_++);
+    }
+
+    bool CommandJournal::Append(const std::string& line) {
+        if (WriteDurably(path_, line, true)) {
+            return true;
+        }
+        stats_.writeFailures++;
+        LOG_ERROR(GameMaster, "Failed to write command journal {}", path_.string());
+        return false;
+    }
+
+    CommandJournal::QueueResult CommandJournal::Queue(std::string_view name, bool value, bool baseline) {
+        std::lock_guard lock(mutex_);
+
+        const JournalCommand* replaced =
+            !pending_.empty() && pending_.back().name == name ? &pending_.back() : nullptr;
+        if (replaced) {
+            baseline = replaced->baseline;
+        }
+
+        // The replacement is written before the completion of what it replaces, so a crash in
+        // between leaves both, which Load collapses again. Until the first line is on disk
+        // nothing has changed, so a failed write leaves the pending commands as they were.
+        if (value != baseline) {
+            JournalCommand queued{NextKey(), std::string(name), value, baseline};
+            if (!Append(FormatQueued(queued))) {
+                return QueueResult::WriteFailed;
+            }
+            if (replaced) {
+                Append("D " + replaced->key + "\n");
+                pending_.pop_back();
+                stats_.collapsed++;
+            }
+            pending_.push_back(std::move(queued));
+            stats_.queued++;
+            return QueueResult::Queued;
+        }
+
+        if (!replaced) {
+            return QueueResult::Cancelled;
+        }
+        if (!Append("D " + replaced->key + "\n")) {
+            return QueueResult::WriteFailed;
+        }
+        pending_.pop_back();
+        stats_.collapsed++;
+        return QueueResult::Cancelled;
+    }
+
+    void CommandJournal::MarkDone(std::string_view key) {
+        std::lock_guard lock(mutex_);
+        if (std::erase_if(pending_, [&](const JournalCommand& command) { return command.key == key; }) == 0) {
+            return;
+        }
+        Append("D " + std::string(key) + "\n");
+        stats_.completed++;
+    }
+
+    std::vector<JournalCommand> CommandJournal::GetPending() const {
+        std::lock_guard lock(mutex_);
+        return pending_;
+    }
+
+    std::optional<bool> CommandJournal::GetPendingValue(std::string_view name) const {
+        std::lock_guard lock(mutex_);
+        for (auto it = pending_.rbegin(); it != pending_.rend(); ++it) {
+            if (it->name == name) {
+                return it->value;
+            }
+        }
+        return std::nullopt;
+    }
+
+    bool CommandJournal::HasPending() const {
+        std::lock_guard lock(mutex_);
+        return !pending_.empty();
+    }
+
+    CommandJournal::Stats CommandJournal::GetStats() const {
+        std::lock_guard lock(mutex_);
+        return stats_;
+    }
+
+}  // namespace SkyrimNetUI::SkyrimNet
@@ -0,0 +1,248 @@
+#include "skyrimnet/EventFeed.h"
+
+#include <algorithm>
+#include <bit>
+#include <thread>
+
+#include "config/IniFile.h"
+#include "http/EventStream.h"
+#include "logging/Log.h"
+#include "metrics/Metrics.h"
+#include "pch.h"
+#include "skyrimnet/GameMasterController.h"
+
+namespace SkyrimNetUI::SkyrimNet {
+
+    EventRing::EventRing(size_t capacity)
+        : mask_(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1), slots_(std::make_unique<Slot[]>(mask_ + 1)) {
+        for (size_t i = 0; i <= mask_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // A slot is writable at position pos once its sequence is pos, and readable once it is
+    // pos + 1; reading it hands it on to the writer one lap later (pos + capacity)
+    bool EventRing::TryPush(FeedEvent& event) {
+        uint64_t position = head_.load(std::memory_order_relaxed);
+        while (true) {
+            auto& slot = slots_[position & mask_];
+            const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto lag = static_cast<int64_t>(sequence - position);
+            if (lag == 0) {
+                if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot.event = std::move(event);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;
+            } else {
+                position = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void EventRing::Push(FeedEvent event) {
+        FeedEvent dropped;
+        while (!TryPush(event)) {
+            if (Pop(dropped)) {
+                overwritten_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                // A reader is still moving the oldest event out of its slot
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    bool EventRing::Pop(FeedEvent& event) {
+        uint64_t position = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            auto& slot = slots_[position & mask_];
+            const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto lag = static_cast<int64_t>(sequence - (position + 1));
+            if (lag == 0) {
+                if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    event = std::move(slot.event);
+                    slot.sequence.store(position + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;
+            } else {
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t EventRing::Drain(std::vector<FeedEvent>& out, size_t max) {
+        size_t count = 0;
+        FeedEvent event;
+        while (count < max && Pop(event)) {
+            out.push_back(std::move(event));
+            ++count;
+        }
+        return count;
+    }
+
+    EventFeed& GetEventFeed() {
+        static EventFeed instance(
+            Http::GetDefaultTransport(), GetController().GetServerSettings(),
+            static_cast<size_t>(std::clamp<int64_t>(
+                Config::GetSettings().GetInt("Events", "BufferSize", EventFeed::kDefaultCapacity), 16, 1 << 16)));
+        return instance;
+    }
+
+    // Touching the scheduler first makes it outlive the feed singleton
+    EventFeed::EventFeed(Http::Transport& transport, ServerSettings settings, size_t capacity)
+        : transport_(transport),
+          settings_(std::move(settings)),
+          eventsUrl_(settings_.baseUrl + settings_.eventsPath),
+          ring_(capacity),
+          breaker_(settings_.backoff) {
+        Scheduler::GetScheduler();
+    }
+
+    EventFeed::~EventFeed() { Stop(); }
+
+    void EventFeed::Start() {
+        std::lock_guard lock(taskMutex_);
+        if (active_) {
+            return;
+        }
+
+        cancel_.Reset();
+        active_ = true;
+        const uint64_t session = ++session_;
+        task_ = Scheduler::GetScheduler().Post(Scheduler::Lane::Stream, [this, session]() { Run(session); });
+        LOG_DEBUG(GameMaster, "Subscribing to SkyrimNet events at {} ({} buffered)", eventsUrl_, ring_.Capacity());
+    }
+
+    void EventFeed::Stop() {
+        std::lock_guard lock(taskMutex_);
+        if (!active_) {
+            return;
+        }
+        active_ = false;
+        task_.Cancel();
+        // Closes the stream; the task then sees the stale session and exits
+        cancel_.Cancel();
+        LOG_DEBUG(GameMaster, "Unsubscribed from SkyrimNet events");
+    }
+
+    void EventFeed::Shutdown() {
+        Stop();
+
+        Scheduler::TaskHandle task;
+        {
+            std::lock_guard lock(taskMutex_);
+            task = task_;
+        }
+        task.CancelAndWait();
+    }
+
+    std::vector<FeedEvent> EventFeed::TakeBatch(size_t max) {
+        std::vector<FeedEvent> batch;
+        batch.reserve(std::min(max, ring_.Capacity()));
+        taken_.fetch_add(ring_.Drain(batch, max), std::memory_order_relaxed);
+        return batch;
+    }
+
+    EventFeed::Stats EventFeed::GetStats() const noexcept {
+        return {connects_.load(std::memory_order_relaxed), received_.load(std::memory_order_relaxed),
+                ring_.Overwritten(), taken_.load(std::memory_order_relaxed)};
+    }
+
+    bool EventFeed::IsCurrentSession(uint64_t session) const noexcept {
+        return active_.load() && session_.load() == session;
+    }
+
+    void EventFeed::Reconnect() {
+        std::lock_guard lock(taskMutex_);
+        if (!active_ || breaker_.GetStats().consecutiveFailures == 0) {
+            return;
+        }
+        // A new session, so a connection attempt still in progress gives up instead of doubling up
+        task_.Cancel();
+        breaker_.RecordProbeSuccess();
+        ScheduleLocked(++session_, std::chrono::milliseconds::zero());
+        LOG_DEBUG(GameMaster, "SkyrimNet server is back, reconnecting to {}", eventsUrl_);
+    }
+
+    void EventFeed::Schedule(uint64_t session, std::chrono::milliseconds delay) {
+        std::lock_guard lock(taskMutex_);
+        ScheduleLocked(session, delay);
+    }
+
+    void EventFeed::ScheduleLocked(uint64_t session, std::chrono::milliseconds delay) {
+        if (!IsCurrentSession(session)) {
+            return;
+        }
+        task_ = Scheduler::GetScheduler().PostDelayed(Scheduler::Lane::Stream, delay,
+                                                      [this, session]() { Run(session); });
+    }
+
+    void EventFeed::Run(uint64_t session) {
+        if (!IsCurrentSession(session)) {
+            return;
+        }
+
+        Http::RequestOptions options{.cancel = &cancel_, .timeouts = settings_.eventsTimeouts};
+        std::string lastEventId;
+        {
+            std::lock_guard lock(taskMutex_);
+            lastEventId = lastEventId_;
+        }
+        if (!lastEventId.empty()) {
+            options.headers.emplace("Last-Event-ID", lastEventId);
+        }
+
+        Http::SseParser parser([this, &lastEventId](const Http::ServerSentEvent& event) {
+            if (!event.id.empty()) {
+                lastEventId = event.id;
+            }
+            ring_.Push({nextSequence_.fetch_add(1, std::memory_order_relaxed), event.event, event.data});
+            received_.fetch_add(1, std::memory_order_relaxed);
+            Metrics::Increment(Metrics::Counter::FeedEvents);
+        });
+
+        // Occupies a stream worker for the lifetime of the connection. A stream left over
+        // from before a quick Stop/Start ends at its next chunk.
+        connects_.fetch_add(1, std::memory_order_relaxed);
+        const auto result = transport_.Stream(
+            eventsUrl_, "text/event-stream",
+            [this, session, &parser](std::string_view chunk) {
+                if (!IsCurrentSession(session)) {
+                    return false;
+                }
+                parser.Feed(chunk);
+                return true;
+            },
+            options);
+
+        {
+            std::lock_guard lock(taskMutex_);
+            lastEventId_ = std::move(lastEventId);
+        }
+        if (!IsCurrentSession(session)) {
+            return;
+        }
+
+        if (result.status != 0 && !result.accepted) {
+            LOG_INFO(GameMaster, "Server does not offer an event stream (status {}), live events are off",
+                     result.status);
+            return;
+        }
+
+        // Reconnect quickly after a clean close, with growing delays while the server is down
+        if (result.accepted) {
+            breaker_.RecordSuccess();
+            LOG_DEBUG(GameMaster, "SkyrimNet event stream closed, reconnecting");
+            Schedule(session, std::chrono::seconds(1));
+            return;
+        }
+        const auto delay = breaker_.RecordFailure();
+        LOG_DEBUG(GameMaster, "SkyrimNet event stream unavailable, retrying in {} ms", delay.count());
+        Schedule(session, delay);
+    }
+
+}  // namespace SkyrimNetUI::SkyrimNet
@@ -0,0 +1,290 @@
+#include "skyrimnet/GameConfig.h"
+
+#include <array>
+#include <span>
+
+#include "json/JsonScanner.h"
+#include "logging/Log.h"
+#include "pch.h"
+
+namespace SkyrimNetUI::SkyrimNet {
+
+    namespace {
+        constexpr std::string_view kConfigGetPath = "/config?api=get&name=game";
+        constexpr std::string_view kConfigUpdatePath = "/config?api=update";
+
+        // The top-level gamemaster object, then its fields indexed like the dirty bits
+        constexpr std::string_view kGameMasterSection = "/gamemaster";
+        constexpr std::array<std::string_view, 3> kGameMasterPointers{kGameMasterSection, "/gamemaster/enabled",
+                                                                      "/gamemaster/agentEnabled"};
+        using GameMasterValues = std::array<std::optional<std::string_view>, kGameMasterPointers.size()>;
+
+        std::string_view BoolText(bool value) { return value ? "true" : "false"; }
+
+        /// Resolve the gamemaster object and its fields in one pass; nested objects of the same name don't count
+        bool ResolveGameMaster(std::string_view document, GameMasterValues& values) {
+            return Json::Resolve(document, kGameMasterPointers, values) && values[0] && values[0]->starts_with('{');
+        }
+
+        std::optional<GameMasterSettings> ReadGameMaster(std::string_view document) {
+            GameMasterValues values;
+            if (!ResolveGameMaster(document, values)) {
+                return std::nullopt;
+            }
+            GameMasterSettings settings;
+            settings.enabled = values[1] ? Json::AsBool(*values[1]).value_or(false) : false;
+            settings.agentEnabled = values[2] ? Json::AsBool(*values[2]).value_or(false) : false;
+            return settings;
+        }
+    }
+
+    GameConfig::GameConfig(Http::Transport& transport, const ServerSettings& settings)
+        : transport_(transport),
+          timeouts_(settings.configTimeouts),
+          getUrl_(settings.baseUrl + std::string(kConfigGetPath)),
+          updateUrl_(settings.baseUrl + std::string(kConfigUpdatePath)),
+          patchUrl_(settings.patchPath.empty() ? std::string() : settings.baseUrl + settings.patchPath),
+          partialSupport_(patchUrl_.empty() ? PartialSupport::Unsupported : PartialSupport::Unknown) {}
+
+    bool GameConfig::Refresh(Http::CancelToken* cancel) {
+        Http::RequestOptions options{.cancel = cancel, .timeouts = timeouts_};
+        cache_.AddValidators(options.headers);
+        auto response = transport_.Get(getUrl_, options);
+
+        switch (cache_.Update(response)) {
+            case Http::ConditionalCache::Outcome::Error:
+                LOG_ERROR(GameMaster, "Failed to retrieve game config (status: {})", response.status);
+                return false;
+
+            case Http::ConditionalCache::Outcome::NotModified:
+            case Http::ConditionalCache::Outcome::Unchanged: {
+                std::lock_guard lock(mutex_);
+                LOG_DEBUG(GameMaster, "Game config unchanged ({} bytes cached)", document_.size());
+                return gamemaster_.has_value();
+            }
+
+            case Http::ConditionalCache::Outcome::Changed:
+                break;
+        }
+
+        LOG_INFO(GameMaster, "Retrieved game config ({} bytes)", response.body.size());
+
+        std::lock_guard lock(mutex_);
+        document_ = std::move(response.body);
+        if (!ParseGameMaster(document_)) {
+            // Make sure the next refresh downloads and parses the document again
+            cache_.Invalidate();
+            return false;
+        }
+        return true;
+    }
+
+    bool GameConfig::ParseGameMaster(std::string_view document) {
+        auto parsed = ReadGameMaster(document);
+        if (!parsed) {
+            LOG_ERROR(GameMaster, "Could not find gamemaster section in config response");
+            gamemaster_.reset();
+            return false;
+        }
+
+        GameMasterSettings settings = *parsed;
+
+        // Uncommitted changes stay on top of whatever the server reports
+        if (gamemaster_ && (dirty_ & kDirtyEnabled)) {
+            settings.enabled = gamemaster_->enabled;
+        }
+        if (gamemaster_ && (dirty_ & kDirtyAgentEnabled)) {
+            settings.agentEnabled = gamemaster_->agentEnabled;
+        }
+        gamemaster_ = settings;
+        return true;
+    }
+
+    std::optional<GameMasterSettings> GameConfig::GetGameMaster() const {
+        std::lock_guard lock(mutex_);
+        return gamemaster_;
+    }
+
+    void GameConfig::SetGameMasterEnabled(bool enabled) {
+        std::lock_guard lock(mutex_);
+        if (!gamemaster_) {
+            gamemaster_ = GameMasterSettings{};
+        }
+        gamemaster_->enabled = enabled;
+        gamemaster_->agentEnabled = enabled;
+        dirty_ |= kDirtyEnabled | kDirtyAgentEnabled;
+    }
+
+    bool GameConfig::IsDirty() const {
+        std::lock_guard lock(mutex_);
+        return dirty_ != 0;
+    }
+
+    void GameConfig::DiscardChanges() {
+        std::lock_guard lock(mutex_);
+        dirty_ = 0;
+        if (!document_.empty()) {
+            ParseGameMaster(document_);
+        }
+    }
+
+    std::string GameConfig::BuildPartialUpdate() const {
+        std::string body = "{\"gamemaster\":{";
+        bool first = true;
+        auto append = [&](std::string_view name, bool value) {
+            body.append(first ? "\"" : ",\"").append(name).append("\":").append(BoolText(value));
+            first = false;
+        };
+        if (dirty_ & kDirtyEnabled) {
+            append("enabled", gamemaster_->enabled);
+        }
+        if (dirty_ & kDirtyAgentEnabled) {
+            append("agentEnabled", gamemaster_->agentEnabled);
+        }
+        body.append("}}");
+        return body;
+    }
+
+    std::optional<std::string> GameConfig::BuildFullDocument() const {
+        GameMasterValues values;
+        if (!ResolveGameMaster(document_, values)) {
+            return std::nullopt;
+        }
+
+        const std::array<std::pair<uint8_t, bool>, kGameMasterPointers.size() - 1> fields{
+            {{kDirtyEnabled, gamemaster_->enabled}, {kDirtyAgentEnabled, gamemaster_->agentEnabled}}};
+
+        std::array<Json::Patch, fields.size()> patches;
+        size_t patchCount = 0;
+        for (size_t i = 0; i < fields.size(); ++i) {
+            if (!(dirty_ & fields[i].first)) {
+                continue;
+            }
+            const auto& value = values[i + 1];
+            if (!value) {
+                LOG_WARN(GameMaster, "gamemaster section has no {} field",
+                         kGameMasterPointers[i + 1].substr(kGameMasterSection.size() + 1));
+                continue;
+            }
+            patches[patchCount++] = {*value, BoolText(fields[i].second)};
+        }
+
+        if (patchCount == 0) {
+            return std::nullopt;
+        }
+        return Json::ApplyPatches(document_, std::span(patches.data(), patchCount));
+    }
+
+    std::optional<bool> GameConfig::ConfirmPartialUpdate(const GameMasterSettings& sent, uint8_t fields,
+                                                         Http::CancelToken* cancel) {
+        // Bypass the conditional cache: the answer must be the server's current document
+        auto response = transport_.Get(getUrl_, {.cancel = cancel, .timeouts = timeouts_});
+        if (!response.ok()) {
+            return std::nullopt;
+        }
+        const auto held = ReadGameMaster(response.body);
+        return held && (!(fields & kDirtyEnabled) || held->enabled == sent.enabled) &&
+               (!(fields & kDirtyAgentEnabled) || held->agentEnabled == sent.agentEnabled);
+    }
+
+    bool GameConfig::Commit(Http::CancelToken* cancel, std::string_view idempotencyKey) {
+        std::string partialBody;
+        std::optional<std::string> fullDocument;
+        GameMasterSettings sent;
+        uint8_t sending = 0;
+        {
+            std::lock_guard lock(mutex_);
+            if (dirty_ == 0) {
+                return true;
+            }
+            if (!gamemaster_ || document_.empty()) {
+                LOG_ERROR(GameMaster, "Cannot commit game config before it has been fetched");
+                return false;
+            }
+            sending = dirty_;
+            sent = *gamemaster_;
+            partialBody = BuildPartialUpdate();
+            fullDocument = BuildFullDocument();
+        }
+
+        const size_t fullSize = fullDocument ? fullDocument->size() : 0;
+        Http::RequestOptions options{.cancel = cancel, .timeouts = timeouts_};
+        if (!idempotencyKey.empty()) {
+            options.headers.emplace("Idempotency-Key", idempotencyKey);
+        }
+
+        if (partialSupport_.load() != PartialSupport::Unsupported) {
+            auto response = transport_.Post(patchUrl_, partialBody, options);
+            if (!response) {
+                LOG_ERROR(GameMaster, "Partial game config update failed (no response)");
+                return false;
+            }
+
+            // A 2xx alone doesn't prove the endpoint exists, so check the first one took effect
+            std::optional<bool> applied = response.ok();
+            if (response.ok() && partialSupport_.load() == PartialSupport::Unknown) {
+                applied = ConfirmPartialUpdate(sent, sending, cancel);
+                if (!applied) {
+                    LOG_ERROR(GameMaster, "Could not re-read game config to confirm the partial update");
+                    return false;
+                }
+            }
+
+            if (*applied) {
+                partialSupport_.store(PartialSupport::Supported);
+
+                std::lock_guard lock(mutex_);
+                // Keep the cached document in step with what the server now holds
+                if (fullDocument) {
+                    document_ = std::move(*fullDocument);
+                }
+                dirty_ &= static_cast<uint8_t>(~sending);
+                cache_.Invalidate();
+                stats_.fullBytes += fullSize;
+                RecordCommit(partialBody.size(), true);
+                return true;
+            }
+
+            LOG_WARN(GameMaster, "Server did not take the partial config update (status {}), sending full documents",
+                     response.status);
+            partialSupport_.store(PartialSupport::Unsupported);
+        }
+
+        if (!fullDocument) {
+            LOG_ERROR(GameMaster, "Failed to update gamemaster fields in cached config");
+            return false;
+        }
+
+        LOG_INFO(GameMaster, "Sending full game config ({} bytes)", fullSize);
+        auto response = transport_.Post(updateUrl_, *fullDocument, options);
+        if (!response.ok()) {
+            LOG_ERROR(GameMaster, "Full game config update failed (status: {})", response.status);
+            return false;
+        }
+
+        std::lock_guard lock(mutex_);
+        document_ = std::move(*fullDocument);
+        dirty_ &= static_cast<uint8_t>(~sending);
+        cache_.Invalidate();
+        stats_.fullBytes += fullSize;
+        RecordCommit(fullSize, false);
+        return true;
+    }
+
+    void GameConfig::RecordCommit(size_t sentBytes, bool partial) {
+        stats_.commits++;
+        if (partial) {
+            stats_.partialCommits++;
+        }
+        stats_.bytesSent += sentBytes;
+        stats_.lastCommitBytes = sentBytes;
+        LOG_INFO(GameMaster, "Committed game config: {} bytes sent ({})", sentBytes,
+                 partial ? "partial" : "full document");
+    }
+
+    GameConfig::Stats GameConfig::GetStats() const {
+        std::lock_guard lock(mutex_);
+        return stats_;
+    }
+
+}  // namespace SkyrimNetUI::SkyrimNet
@@ -2,239 +2,596 @@
 
 #include <chrono>
 
+#include "config/IniFile.h"
+#include "http/EventStream.h"
 #include "http/HttpClient.h"
+#include "json/JsonScanner.h"
+#include "logging/Log.h"
+#include "metrics/Metrics.h"
 #include "pch.h"
-#include "ui/UIBridge.h"
+#include "scheduler/TaskScheduler.h"
 
 namespace SkyrimNetUI::SkyrimNet {
 
+    namespace {
+        // Journal name of the setting a toggle changes
+        constexpr std::string_view kGameMasterEnabled = "gamemaster.enabled";
+    }
+
     Controller& GetController() {
-        static Controller instance;
+        static Controller instance(Http::GetDefaultTransport(), ServerSettings::Load(Config::GetSettings()));
         return instance;
     }
 
-    Controller::Controller() = default;
+    // Touching the scheduler first makes it outlive the controller singleton
+    Controller::Controller(Http::Transport& transport, ServerSettings settings)
+        : transport_(transport),
+          settings_(std::move(settings)),
+          statusUrl_(settings_.baseUrl + settings_.statusPath),
+          eventsUrl_(settings_.baseUrl + settings_.statusEventsPath),
+          healthUrl_(settings_.baseUrl + settings_.healthPath),
+          breaker_(settings_.backoff),
+          config_(transport, settings_),
+          replayBackoff_(settings_.backoff) {
+        Scheduler::GetScheduler();
+    }
 
-    Controller::~Controller() { StopPolling(); }
+    Controller::~Controller() {
+        StopPolling();
+        toggleCancel_.Cancel();
+        std::lock_guard lock(pollMutex_);
+        toggleTask_.Cancel();
+        replayTask_.Cancel();
+    }
+
+    void Controller::Shutdown() {
+        StopPolling();
+        toggleCancel_.Cancel();
+
+        // Wait outside the lock; a running poll task takes it to reschedule itself
+        Scheduler::TaskHandle pollTask;
+        Scheduler::TaskHandle toggleTask;
+        Scheduler::TaskHandle replayTask;
+        {
+            std::lock_guard lock(pollMutex_);
+            pollTask = pollTask_;
+            toggleTask = toggleTask_;
+            replayTask = replayTask_;
+        }
+        replayTask.CancelAndWait();
+        pollTask.CancelAndWait();
+        toggleTask.CancelAndWait();
+    }
 
     void Controller::StartPolling() {
+        std::lock_guard lock(pollMutex_);
         if (pollingActive_) {
             return;
         }
 
+        pollCancel_.Reset();
         pollingActive_ = true;
-        pollingThread_ = std::thread([this]() { PollStatus(); });
-        logger::info("Started GameMaster status polling");
+        const uint64_t session = ++pollSession_;
+
+        // A server that was down when polling last stopped is probed before regular requests resume
+        if (breaker_.IsOpen()) {
+            ScheduleLocked(session, std::chrono::milliseconds::zero(), [this, session]() { ProbeHealth(session); });
+        } else {
+            ScheduleStatusLocked(session, std::chrono::milliseconds::zero());
+        }
+        LOG_INFO(GameMaster, "Started GameMaster status polling");
     }
 
     void Controller::StopPolling() {
-        if (!pollingActive_) {
+        {
+            std::lock_guard lock(pollMutex_);
+            if (!pollingActive_) {
+                return;
+            }
+            pollingActive_ = false;
+            pollTask_.Cancel();
+            // Abort a request blocked on its read timeout; the task then sees the stale session and exits.
+            // Done under the lock so a quick StartPolling can't reset the token first.
+            pollCancel_.Cancel();
+        }
+
+        LOG_INFO(GameMaster, "Stopped GameMaster status polling");
+    }
+
+    bool Controller::IsCurrentSession(uint64_t session) const noexcept {
+        return pollingActive_.load() && pollSession_.load() == session;
+    }
+
+    void Controller::Schedule(uint64_t session, std::chrono::milliseconds delay, Scheduler::Task task,
+                              Scheduler::Lane lane) {
+        std::lock_guard lock(pollMutex_);
+        ScheduleLocked(session, delay, std::move(task), lane);
+    }
+
+    void Controller::ScheduleLocked(uint64_t session, std::chrono::milliseconds delay, Scheduler::Task task,
+                                    Scheduler::Lane lane) {
+        if (!IsCurrentSession(session)) {
             return;
         }
+        pollTask_ = Scheduler::GetScheduler().PostDelayed(lane, delay, std::move(task));
+    }
 
-        pollingActive_ = false;
-        if (pollingThread_.joinable()) {
-            pollingThread_.join();
+    void Controller::ScheduleStatus(uint64_t session, std::chrono::milliseconds delay) {
+        std::lock_guard lock(pollMutex_);
+        ScheduleStatusLocked(session, delay);
+    }
+
+    // The push stream holds its connection open, so it goes on the stream lane
+    void Controller::ScheduleStatusLocked(uint64_t session, std::chrono::milliseconds delay) {
+        if (pushEnabled_.load() && !pushUnsupported_.load()) {
+            ScheduleLocked(session, delay, [this, session]() { RunPushStream(session); }, Scheduler::Lane::Stream);
+        } else {
+            ScheduleLocked(session, delay, [this, session]() { PollStatus(session); });
         }
-        logger::info("Stopped GameMaster status polling");
     }
 
-    void Controller::PollStatus() {
-        while (pollingActive_) {
-            try {
-                auto response = Http::Get("http://localhost:8080/?api=gamemaster-status");
+    void Controller::RetryAfterFailure(uint64_t session) {
+        const auto previous = breaker_.GetState();
+        const auto delay = breaker_.RecordFailure();
 
-                if (response.ok()) {
-                    logger::trace("Poll: Received GameMaster status response: {}", response.body);
-                    bool newState = ParseStatus(response.body);
-                    bool previousState = enabled_.load();
+        if (breaker_.IsOpen()) {
+            if (previous == Http::CircuitBreaker::State::Closed) {
+                LOG_WARN(GameMaster, "SkyrimNet server unreachable after {} attempts, switching to health probes",
+                         breaker_.GetStats().consecutiveFailures);
+            } else {
+                LOG_DEBUG(GameMaster, "Status request after a successful probe failed, next probe in {} ms",
+                          delay.count());
+            }
+            Schedule(session, delay, [this, session]() { ProbeHealth(session); });
+            return;
+        }
 
-                    logger::trace("Poll: ParseStatus={}, previousState={}, enabled_.load()={}", newState, previousState,
-                                  enabled_.load());
+        LOG_DEBUG(GameMaster, "Status request failed, retrying in {} ms", delay.count());
+        ScheduleStatus(session, delay);
+    }
+
+    void Controller::RecordStatusSuccess() {
+        const bool recovered = breaker_.GetState() != Http::CircuitBreaker::State::Closed;
+        if (recovered) {
+            LOG_INFO(GameMaster, "SkyrimNet server is reachable again, resuming status updates");
+        }
+        breaker_.RecordSuccess();
+        if (recovered) {
+            ReplayJournal();
+        }
+    }
 
-                    enabled_.store(newState);
+    void Controller::ProbeHealth(uint64_t session) {
+        if (!IsCurrentSession(session)) {
+            return;
+        }
 
-                    if (previousState != newState) {
-                        logger::info("Poll: State changed from {} to {}, calling UpdateUI({})", previousState, newState,
-                                     newState);
-                        UpdateUI(newState);
-                    } else {
-                        logger::trace("Poll: State unchanged ({}), skipping UpdateUI", newState);
-                    }
-                }
-            } catch (const std::exception& e) {
-                logger::warn("Error polling GameMaster status: {}", e.what());
+        // Any HTTP answer means the server is up again, whatever the status code
+        auto response = transport_.Get(
+            healthUrl_,
+            {.cancel = &pollCancel_, .timeouts = settings_.healthTimeouts, .maxAge = settings_.statusMaxAge});
+        if (!IsCurrentSession(session)) {
+            return;
+        }
+
+        if (response) {
+            breaker_.RecordProbeSuccess();
+            LOG_DEBUG(GameMaster, "Health probe answered (status {}), retrying status updates", response.status);
+            ScheduleStatus(session, std::chrono::milliseconds::zero());
+            return;
+        }
+
+        const auto delay = breaker_.RecordFailure();
+        LOG_TRACE(GameMaster, "Health probe failed, next probe in {} ms", delay.count());
+        Schedule(session, delay, [this, session]() { ProbeHealth(session); });
+    }
+
+    void Controller::PollStatus(uint64_t session) {
+        if (!IsCurrentSession(session)) {
+            return;
+        }
+
+        bool reached = false;
+        try {
+            reached = FetchStatus();
+        } catch (const std::exception& e) {
+            LOG_WARN(GameMaster, "Error polling GameMaster status: {}", e.what());
+        }
+
+        if (!IsCurrentSession(session)) {
+            return;
+        }
+        if (!reached) {
+            RetryAfterFailure(session);
+            return;
+        }
+
+        RecordStatusSuccess();
+        Schedule(session, settings_.pollInterval, [this, session]() { PollStatus(session); });
+    }
+
+    void Controller::RunPushStream(uint64_t session) {
+        if (!IsCurrentSession(session)) {
+            return;
+        }
+
+        // The stream only carries changes, so fetch the current state on every (re)connect.
+        // If that fails the server is down, so don't tie up a worker on the stream as well.
+        if (!FetchStatus()) {
+            if (IsCurrentSession(session)) {
+                RetryAfterFailure(session);
             }
+            return;
+        }
+        RecordStatusSuccess();
 
-            // Sleep for 5 seconds
-            for (int i = 0; i < 50 && pollingActive_; ++i) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        Http::SseParser parser([this](const Http::ServerSentEvent& event) {
+            if (event.event != "status" && event.event != "message") {
+                return;
             }
+            pushEvents_.fetch_add(1, std::memory_order_relaxed);
+            // The cached body no longer matches what is shown, so the fetch after a reconnect
+            // must parse the server's state even if it is back to that body
+            statusCache_.Invalidate();
+            ApplyStatus(event.data, toggleGeneration_.load());
+        });
+
+        // Occupies a stream worker for the lifetime of the connection
+        statusRequests_.fetch_add(1, std::memory_order_relaxed);
+        auto result = transport_.Stream(
+            eventsUrl_, "text/event-stream",
+            [&parser](std::string_view chunk) {
+                parser.Feed(chunk);
+                return true;
+            },
+            {.cancel = &pollCancel_, .timeouts = settings_.eventsTimeouts});
+
+        if (!IsCurrentSession(session)) {
+            return;
+        }
+
+        if (result.status != 0 && !result.accepted) {
+            LOG_INFO(GameMaster, "Server does not support GameMaster status push (status {}), using interval polling",
+                     result.status);
+            pushUnsupported_.store(true);
+            Schedule(session, settings_.pollInterval, [this, session]() { PollStatus(session); });
+            return;
+        }
+
+        if (!result.accepted) {
+            RetryAfterFailure(session);
+            return;
         }
+
+        // Reconnect quickly after a clean close
+        LOG_DEBUG(GameMaster, "GameMaster status stream closed, reconnecting");
+        Schedule(session, std::chrono::seconds(1), [this, session]() { RunPushStream(session); },
+                 Scheduler::Lane::Stream);
     }
 
-    bool Controller::ParseStatus(const std::string& jsonResponse) {
-        try {
-            // Simple JSON parsing for agent_enabled
-            size_t pos = jsonResponse.find("\"agent_enabled\"");
-            if (pos == std::string::npos) {
+    bool Controller::FetchStatus() {
+        const uint64_t generation = toggleGeneration_.load();
+
+        // Polls can share a toggle's confirmation read or another poll's; toggles always read fresh
+        Http::RequestOptions options{
+            .cancel = &pollCancel_, .timeouts = settings_.statusTimeouts, .maxAge = settings_.statusMaxAge};
+        statusCache_.AddValidators(options.headers);
+        statusRequests_.fetch_add(1, std::memory_order_relaxed);
+        auto response = transport_.Get(statusUrl_, options);
+
+        switch (statusCache_.Update(response)) {
+            case Http::ConditionalCache::Outcome::Changed:
+                if (!ApplyStatus(response.body, generation)) {
+                    // Not applied, so make sure the same body is parsed again next time
+                    statusCache_.Invalidate();
+                }
+                break;
+            case Http::ConditionalCache::Outcome::NotModified:
+            case Http::ConditionalCache::Outcome::Unchanged:
+                LOG_TRACE(GameMaster, "Poll: Status unchanged, skipping parse");
+                break;
+            case Http::ConditionalCache::Outcome::Error:
                 return false;
-            }
+        }
+        return true;
+    }
 
-            pos = jsonResponse.find(":", pos);
-            if (pos == std::string::npos) {
+    bool Controller::ApplyStatus(const std::string& body, uint64_t generation) {
+        if (toggleInFlight_.load() || generation != toggleGeneration_.load()) {
+            LOG_TRACE(GameMaster, "Poll: Toggle in progress, discarding status response");
+            return false;
+        }
+        // The view shows the saved toggle until it has reached the server, or Pending once the
+        // server has turned it down; the server's own state is still tracked meanwhile
+        if (journal_ && journal_->HasPending()) {
+            if (!replayFailed_.load()) {
+                LOG_TRACE(GameMaster, "Poll: Saved toggles pending, discarding status response");
                 return false;
             }
+            enabled_.store(ParseStatus(body));
+            LOG_TRACE(GameMaster, "Poll: Saved toggles not taken yet, server reports {}", enabled_.load());
+            return true;
+        }
 
-            // Skip whitespace
-            pos++;
-            while (pos < jsonResponse.length() && (jsonResponse[pos] == ' ' || jsonResponse[pos] == '\t')) {
-                pos++;
-            }
+        LOG_TRACE(GameMaster, "Poll: Received GameMaster status response: {}", body);
+        bool newState = ParseStatus(body);
+        bool previousState = enabled_.exchange(newState);
 
-            if (pos + 4 <= jsonResponse.length() && jsonResponse.substr(pos, 4) == "true") {
-                return true;
-            }
+        if (previousState != newState) {
+            LOG_INFO(GameMaster, "Poll: State changed from {} to {}", previousState, newState);
+            Notify(newState ? GameMasterStatus::Enabled : GameMasterStatus::Disabled);
+        } else {
+            LOG_TRACE(GameMaster, "Poll: State unchanged ({}), skipping notification", newState);
+        }
+        return true;
+    }
 
-            return false;
-        } catch (...) {
-            logger::error("Failed to parse GameMaster status JSON");
+    bool Controller::ParseStatus(std::string_view jsonResponse) {
+        // The status envelope isn't fixed, so accept agent_enabled at any depth
+        auto value = Json::FindMember(jsonResponse, "agent_enabled");
+        if (!value) {
+            LOG_WARN(GameMaster, "GameMaster status response has no agent_enabled field");
             return false;
         }
+        return Json::AsBool(*value).value_or(false);
     }
 
-    void Controller::UpdateUI(bool enabled) {
-        logger::info("UpdateUI called with enabled={}", enabled);
-        UI::UpdateGameMasterStatus(enabled);
-        logger::info("UpdateUI: UI::UpdateGameMasterStatus({}) completed", enabled);
+    void Controller::SetStatusListener(StatusListener listener) {
+        std::lock_guard lock(listenerMutex_);
+        listener_ = std::move(listener);
     }
 
-    static std::string ReplaceBooleanValue(const std::string& json, size_t searchStart, const std::string& fieldName,
-                                           bool newValue) {
-        size_t fieldPos = json.find("\"" + fieldName + "\"", searchStart);
-        if (fieldPos == std::string::npos) {
-            return json;
+    void Controller::Notify(GameMasterStatus status) {
+        StatusListener listener;
+        {
+            std::lock_guard lock(listenerMutex_);
+            listener = listener_;
         }
-
-        size_t colonPos = json.find(":", fieldPos);
-        if (colonPos == std::string::npos) {
-            return json;
+        if (listener) {
+            listener(status);
         }
+    }
 
-        // Skip whitespace after colon
-        size_t valueStart = colonPos + 1;
-        while (valueStart < json.length() && (json[valueStart] == ' ' || json[valueStart] == '\t' ||
-                                              json[valueStart] == '\n' || json[valueStart] == '\r')) {
-            valueStart++;
+    bool Controller::Toggle() {
+        bool expected = false;
+        if (!toggleInFlight_.compare_exchange_strong(expected, true)) {
+            LOG_INFO(GameMaster, "GameMaster toggle already in progress, ignoring request");
+            return false;
         }
 
-        // Find end of value (comma, closing brace, or closing bracket)
-        size_t valueEnd = json.find_first_of(",}]", valueStart);
-        if (valueEnd == std::string::npos) {
-            return json;
-        }
+        const bool posted = RunToggle();
+        toggleInFlight_.store(false);
+        return posted;
+    }
 
-        // Skip trailing whitespace before delimiter
-        size_t actualEnd = valueEnd;
-        while (actualEnd > valueStart && (json[actualEnd - 1] == ' ' || json[actualEnd - 1] == '\t' ||
-                                          json[actualEnd - 1] == '\n' || json[actualEnd - 1] == '\r')) {
-            actualEnd--;
+    bool Controller::ToggleAsync() {
+        bool expected = false;
+        if (!toggleInFlight_.compare_exchange_strong(expected, true)) {
+            LOG_INFO(GameMaster, "GameMaster toggle already in progress, ignoring request");
+            return false;
         }
 
-        // Replace the value
-        std::string result = json.substr(0, valueStart) + (newValue ? "true" : "false") + json.substr(actualEnd);
-        return result;
+        Notify(GameMasterStatus::Pending);
+
+        std::lock_guard lock(pollMutex_);
+        toggleTask_ = Scheduler::GetScheduler().Post(Scheduler::Lane::UI, [this]() {
+            if (!RunToggle()) {
+                // Replace the pending indicator with the last known state, a saved toggle's if there is one
+                const auto saved = journal_ ? journal_->GetPendingValue(kGameMasterEnabled) : std::nullopt;
+                Notify(saved.value_or(enabled_.load()) ? GameMasterStatus::Enabled : GameMasterStatus::Disabled);
+            }
+            toggleInFlight_.store(false);
+        });
+        return true;
     }
 
-    void Controller::Toggle() {
-        bool currentState = enabled_.load();
+    bool Controller::RunToggle() {
+        Metrics::ScopedTimer timer(Metrics::Metric::Toggle);
+        // A saved toggle the server hasn't seen yet is the state the player was last shown
+        const auto savedState = journal_ ? journal_->GetPendingValue(kGameMasterEnabled) : std::nullopt;
+        bool currentState = savedState.value_or(enabled_.load());
         bool newState = !currentState;
 
-        logger::info("Toggling GameMaster agent from {} to {}", currentState, newState);
+        LOG_INFO(GameMaster, "Toggling GameMaster agent from {} to {}", currentState, newState);
+
+        // Polling keeps running but discards its results while toggleInFlight_ is set, and any
+        // poll that started before this toggle finishes is discarded via the generation bump below
+        // The status cache is dropped too, so the next poll re-parses whatever the server now reports
+        struct GenerationBump {
+            Controller& self;
+            ~GenerationBump() {
+                self.statusCache_.Invalidate();
+                self.toggleGeneration_.fetch_add(1);
+            }
+        } bump{*this};
 
-        // Stop polling during toggle to prevent race condition
-        bool wasPolling = pollingActive_.load();
-        if (wasPolling) {
-            logger::info("Stopping polling during toggle operation");
-            StopPolling();
+        // Keep toggles in order behind saved ones, and don't wait on a server known to be down
+        if (journal_ && (savedState || breaker_.IsOpen())) {
+            if (!SaveToggle(newState)) {
+                Metrics::Increment(Metrics::Counter::ToggleFailures);
+                return false;
+            }
+            if (!breaker_.IsOpen() && !RunReplay()) {
+                ScheduleReplay();
+            }
+            return true;
         }
 
-        // Step 1: Get the current config values
-        auto configResponse = Http::Get("http://localhost:8080/config?api=get&name=game");
+        // Step 1: Revalidate the cached config (an unchanged config costs a 304)
+        if (!config_.Refresh(&toggleCancel_)) {
+            LOG_ERROR(GameMaster, "Failed to retrieve game config");
+            Metrics::Increment(Metrics::Counter::ToggleFailures);
+            if (journal_ && SaveToggle(newState)) {
+                ScheduleReplay();
+                return true;
+            }
+            return false;
+        }
 
-        if (!configResponse.ok()) {
-            logger::error("Failed to retrieve game config (status: {})", configResponse.status);
-            // Restart polling if it was active
-            if (wasPolling) {
-                StartPolling();
+        // Step 2: Mark gamemaster.enabled and gamemaster.agentEnabled dirty
+        config_.SetGameMasterEnabled(newState);
+
+        // Step 3: Send only the changed fields (or the full document if the server needs it)
+        if (!config_.Commit(&toggleCancel_)) {
+            LOG_ERROR(GameMaster, "Failed to toggle GameMaster state");
+            Metrics::Increment(Metrics::Counter::ToggleFailures);
+            if (journal_) {
+                config_.DiscardChanges();
+                if (SaveToggle(newState)) {
+                    ScheduleReplay();
+                    return true;
+                }
             }
-            return;
+            return false;
         }
 
-        logger::info("Retrieved current config (length: {} bytes)", configResponse.body.length());
+        LOG_INFO(GameMaster, "Successfully toggled GameMaster to {} ({} bytes sent)", newState,
+                 config_.GetStats().lastCommitBytes);
 
-        // Step 2: Find the gamemaster section and update both fields
-        size_t gamemasterPos = configResponse.body.find("\"gamemaster\"");
-        if (gamemasterPos == std::string::npos) {
-            logger::error("Could not find gamemaster section in config response");
-            // Restart polling if it was active
-            if (wasPolling) {
-                StartPolling();
-            }
-            return;
+        ReportServerState(newState);
+        return true;
+    }
+
+    void Controller::ReportServerState(bool expected) {
+        // Fetch actual server state before updating UI
+        auto statusResponse =
+            transport_.Get(statusUrl_, {.cancel = &toggleCancel_, .timeouts = settings_.statusTimeouts});
+        LOG_DEBUG(GameMaster, "Toggle: Status response = '{}'", statusResponse.body);
+
+        if (statusResponse.ok()) {
+            bool actualState = ParseStatus(statusResponse.body);
+            LOG_DEBUG(GameMaster, "Toggle: ParseStatus returned {} (expected {})", actualState, expected);
+
+            enabled_.store(actualState);
+            Notify(actualState ? GameMasterStatus::Enabled : GameMasterStatus::Disabled);
+            LOG_INFO(GameMaster, "Toggle: Reported server-confirmed state: {}", actualState);
+        } else {
+            // Fallback to expected state if status check fails
+            enabled_.store(expected);
+            Notify(expected ? GameMasterStatus::Enabled : GameMasterStatus::Disabled);
+            LOG_WARN(GameMaster, "Could not verify server state, using expected value: {}", expected);
         }
+    }
 
-        // Update agentEnabled field
-        std::string updatedConfig = ReplaceBooleanValue(configResponse.body, gamemasterPos, "agentEnabled", newState);
+    void Controller::OpenJournal(const std::filesystem::path& file) {
+        if (journal_) {
+            return;
+        }
+        journal_ = std::make_unique<CommandJournal>(file);
+        LOG_INFO(GameMaster, "Toggles the SkyrimNet server can't take are saved to {}", file.string());
+    }
 
-        // Update enabled field (search from gamemaster position again since string changed)
-        gamemasterPos = updatedConfig.find("\"gamemaster\"");
-        updatedConfig = ReplaceBooleanValue(updatedConfig, gamemasterPos, "enabled", newState);
+    bool Controller::SaveToggle(bool enabled) {
+        switch (journal_->Queue(kGameMasterEnabled, enabled, enabled_.load())) {
+            case CommandJournal::QueueResult::Queued:
+                LOG_INFO(GameMaster, "Saved GameMaster toggle to {} until the SkyrimNet server takes it", enabled);
+                break;
+            case CommandJournal::QueueResult::Cancelled:
+                LOG_INFO(GameMaster, "GameMaster toggle cancels the saved one, nothing left to send");
+                break;
+            case CommandJournal::QueueResult::WriteFailed:
+                // Not saved, so it would be lost on a restart; the caller reports the toggle as failed
+                LOG_ERROR(GameMaster, "Could not save GameMaster toggle to {}", enabled);
+                return false;
+        }
+        if (!journal_->HasPending()) {
+            replayFailed_.store(false);
+        }
+        // Once the server has turned saved toggles down, don't promise this one either
+        Notify(replayFailed_.load() ? GameMasterStatus::Pending
+                                    : (enabled ? GameMasterStatus::Enabled : GameMasterStatus::Disabled));
+        return true;
+    }
 
-        if (updatedConfig == configResponse.body) {
-            logger::error("Failed to update gamemaster fields - no changes detected");
-            // Restart polling if it was active
-            if (wasPolling) {
-                StartPolling();
-            }
+    void Controller::ScheduleReplay() {
+        if (!journal_ || !journal_->HasPending()) {
             return;
         }
+        // An open breaker already triggers the replay once its probes find the server back
+        if (breaker_.IsOpen()) {
+            return;
+        }
+        const auto delay = replayBackoff_.RecordFailure();
+        LOG_DEBUG(GameMaster, "Retrying saved toggles in {} ms", delay.count());
+        std::lock_guard lock(pollMutex_);
+        replayTask_.Cancel();
+        replayTask_ = Scheduler::GetScheduler().PostDelayed(Scheduler::Lane::Background, delay,
+                                                            [this]() { ReplayJournal(); });
+    }
 
-        logger::info("Updated config (length: {} bytes), sending to server", updatedConfig.length());
+    bool Controller::ReplayJournal() {
+        if (!journal_ || !journal_->HasPending()) {
+            return false;
+        }
+        bool expected = false;
+        if (!toggleInFlight_.compare_exchange_strong(expected, true)) {
+            LOG_DEBUG(GameMaster, "Toggle in progress, saved toggles are sent with it");
+            return false;
+        }
 
-        // Step 3: Send the complete updated config back
-        auto postResult = Http::Post("http://localhost:8080/config?api=update", updatedConfig);
+        std::lock_guard lock(pollMutex_);
+        toggleTask_ = Scheduler::GetScheduler().Post(Scheduler::Lane::UI, [this]() {
+            if (!RunReplay()) {
+                ScheduleReplay();
+            }
+            // Polls that overlapped the replay are discarded, as after a toggle
+            statusCache_.Invalidate();
+            toggleGeneration_.fetch_add(1);
+            toggleInFlight_.store(false);
+        });
+        return true;
+    }
 
-        if (postResult.ok()) {
-            logger::info("Successfully toggled GameMaster to {}", newState);
+    // Caller holds toggleInFlight_ and bumps the toggle generation afterwards
+    bool Controller::RunReplay() {
+        const auto saved = journal_->GetPending();
+        if (saved.empty()) {
+            replayFailed_.store(false);
+            return true;
+        }
+        LOG_INFO(GameMaster, "Sending {} saved toggle(s) to the SkyrimNet server", saved.size());
 
-            // Fetch actual server state before updating UI
-            auto statusResponse = Http::Get("http://localhost:8080/?api=gamemaster-status");
-            logger::info("Toggle: Status response = '{}'", statusResponse.body);
+        for (const auto& command : saved) {
+            if (command.name != kGameMasterEnabled) {
+                LOG_WARN(GameMaster, "Dropping saved command {} for unknown setting {}", command.key, command.name);
+                journal_->MarkDone(command.key);
+                continue;
+            }
 
-            if (statusResponse.ok()) {
-                bool actualState = ParseStatus(statusResponse.body);
-                logger::info("Toggle: ParseStatus returned {} (expected {})", actualState, newState);
+            // Compare with what the server holds, not with changes left by a failed commit
+            config_.DiscardChanges();
+            if (!config_.Refresh(&toggleCancel_)) {
+                LOG_INFO(GameMaster, "SkyrimNet server can't take saved toggles yet");
+                ReportReplayFailed();
+                return false;
+            }
 
-                enabled_.store(actualState);
-                logger::info("Toggle: Calling UpdateUI({})", actualState);
-                UpdateUI(actualState);
-                logger::info("Toggle: Updated UI with server-confirmed state: {}", actualState);
+            // Sent before a crash that came before it could be marked done
+            if (const auto current = config_.GetGameMaster();
+                current && current->enabled == command.value && current->agentEnabled == command.value) {
+                LOG_INFO(GameMaster, "Saved GameMaster toggle {} is already applied", command.key);
             } else {
-                // Fallback to expected state if status check fails
-                enabled_.store(newState);
-                logger::info("Toggle: Calling UpdateUI({}) with expected value", newState);
-                UpdateUI(newState);
-                logger::warn("Could not verify server state, using expected value: {}", newState);
+                config_.SetGameMasterEnabled(command.value);
+                if (!config_.Commit(&toggleCancel_, command.key)) {
+                    LOG_WARN(GameMaster, "Sending saved GameMaster toggle {} failed, keeping it", command.key);
+                    config_.DiscardChanges();
+                    ReportReplayFailed();
+                    return false;
+                }
+                LOG_INFO(GameMaster, "Sent saved GameMaster toggle {} to {}", command.key, command.value);
             }
-        } else {
-            logger::error("Failed to toggle GameMaster state (status: {})", postResult.status);
+            journal_->MarkDone(command.key);
         }
 
-        // Restart polling if it was active before toggle
-        if (wasPolling) {
-            logger::info("Restarting polling after toggle operation");
-            StartPolling();
+        replayFailed_.store(false);
+        replayBackoff_.RecordSuccess();
+        ReportServerState(saved.back().value);
+        return true;
+    }
+
+    void Controller::ReportReplayFailed() {
+        if (!replayFailed_.exchange(true)) {
+            Notify(GameMasterStatus::Pending);
         }
     }
 
@@ -0,0 +1,123 @@
+#include "skyrimnet/HealthMonitor.h"
+
+#include "logging/Log.h"
+#include "pch.h"
+#include "skyrimnet/GameMasterController.h"
+
+namespace SkyrimNetUI::SkyrimNet {
+
+    HealthMonitor& GetHealthMonitor() {
+        static HealthMonitor instance(Http::GetDefaultTransport(), GetController().GetServerSettings());
+        return instance;
+    }
+
+    // Touching the scheduler first makes it outlive the monitor singleton
+    HealthMonitor::HealthMonitor(Http::Transport& transport, ServerSettings settings)
+        : transport_(transport),
+          settings_(std::move(settings)),
+          monitorUrl_(settings_.baseUrl + settings_.monitorPath) {
+        Scheduler::GetScheduler();
+    }
+
+    HealthMonitor::~HealthMonitor() { Stop(); }
+
+    void HealthMonitor::Start() {
+        std::lock_guard lock(taskMutex_);
+        if (active_) {
+            return;
+        }
+
+        cancel_.Reset();
+        active_ = true;
+        const uint64_t session = ++session_;
+        ScheduleLocked(session, std::chrono::milliseconds::zero());
+        LOG_DEBUG(GameMaster, "Started health monitor for {}", monitorUrl_);
+    }
+
+    void HealthMonitor::Stop() {
+        std::lock_guard lock(taskMutex_);
+        if (!active_) {
+            return;
+        }
+        active_ = false;
+        task_.Cancel();
+        cancel_.Cancel();
+        LOG_DEBUG(GameMaster, "Stopped health monitor");
+    }
+
+    void HealthMonitor::Shutdown() {
+        Stop();
+
+        Scheduler::TaskHandle task;
+        {
+            std::lock_guard lock(taskMutex_);
+            task = task_;
+        }
+        task.CancelAndWait();
+    }
+
+    void HealthMonitor::SetListener(HealthListener listener) {
+        std::lock_guard lock(listenerMutex_);
+        listener_ = std::move(listener);
+    }
+
+    bool HealthMonitor::IsCurrentSession(uint64_t session) const noexcept {
+        return active_.load() && session_.load() == session;
+    }
+
+    void HealthMonitor::ScheduleLocked(uint64_t session, std::chrono::milliseconds delay) {
+        if (!IsCurrentSession(session)) {
+            return;
+        }
+        task_ = Scheduler::GetScheduler().PostDelayed(Scheduler::Lane::Background, delay,
+                                                      [this, session]() { Probe(session); });
+    }
+
+    void HealthMonitor::Probe(uint64_t session) {
+        if (!IsCurrentSession(session)) {
+            return;
+        }
+
+        probes_.fetch_add(1, std::memory_order_relaxed);
+        const auto response = transport_.Head(monitorUrl_, {.cancel = &cancel_, .timeouts = settings_.healthTimeouts});
+        if (!IsCurrentSession(session)) {
+            return;
+        }
+
+        if (response) {
+            consecutiveFailures_ = 0;
+            Report(true);
+        } else if (++consecutiveFailures_ >= kFailuresBeforeDown || health_.load() != ServerHealth::Up) {
+            Report(false);
+        }
+
+        // A first failure while up is re-checked at the short interval before it is reported
+        const bool up = health_.load() == ServerHealth::Up && consecutiveFailures_ == 0;
+        std::lock_guard lock(taskMutex_);
+        ScheduleLocked(session, up ? settings_.monitorUpInterval : settings_.monitorDownInterval);
+    }
+
+    void HealthMonitor::Report(bool reachable) {
+        const auto health = reachable ? ServerHealth::Up : ServerHealth::Down;
+        if (health_.exchange(health) == health) {
+            return;
+        }
+
+        transitions_.fetch_add(1, std::memory_order_relaxed);
+        if (reachable) {
+            LOG_INFO(GameMaster, "SkyrimNet server at {} is reachable", settings_.baseUrl);
+        } else {
+            LOG_INFO(GameMaster, "Waiting for SkyrimNet server at {}", settings_.baseUrl);
+        }
+
+        HealthListener listener;
+        {
+            std::lock_guard lock(listenerMutex_);
+            listener = listener_;
+        }
+        if (listener) {
+            listener(reachable);
+        }
+    }
+
+}  // namespace SkyrimNetUI::SkyrimNet
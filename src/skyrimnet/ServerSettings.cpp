@@ -0,0 +1,81 @@
+#include "skyrimnet/ServerSettings.h"
+
+#include <algorithm>
+
+#include "logging/Log.h"
+#include "pch.h"
+
+namespace SkyrimNetUI::SkyrimNet {
+
+    namespace {
+        constexpr int64_t kMinTimeoutMs = 100;
+        constexpr int64_t kMaxTimeoutMs = 10 * 60 * 1000;
+
+        std::chrono::milliseconds GetMillis(const Config::IniFile& settings, std::string_view section,
+                                            std::string_view key, std::chrono::milliseconds fallback) {
+            return std::chrono::milliseconds(
+                std::clamp(settings.GetInt(section, key, fallback.count()), kMinTimeoutMs, kMaxTimeoutMs));
+        }
+    }
+
+    ServerSettings ServerSettings::Load(const Config::IniFile& settings) {
+        ServerSettings result;
+
+        if (auto baseUrl = settings.Get("Server", "BaseUrl"); baseUrl && baseUrl->find("://") != std::string::npos) {
+            result.baseUrl = *baseUrl;
+            while (result.baseUrl.ends_with('/')) {
+                result.baseUrl.pop_back();
+            }
+        }
+
+        const auto connect = GetMillis(settings, "Server", "ConnectTimeoutMs", result.statusTimeouts.connect);
+        result.statusTimeouts = {connect, GetMillis(settings, "Server", "StatusTimeoutMs", result.statusTimeouts.read)};
+        result.configTimeouts = {connect, GetMillis(settings, "Server", "ConfigTimeoutMs", result.configTimeouts.read)};
+        result.eventsTimeouts = {connect, GetMillis(settings, "Server", "EventsTimeoutMs", result.eventsTimeouts.read)};
+        result.healthTimeouts = {std::min(connect, result.healthTimeouts.connect),
+                                 GetMillis(settings, "Server", "HealthTimeoutMs", result.healthTimeouts.read)};
+
+        result.statusMaxAge = std::chrono::milliseconds(std::clamp<int64_t>(
+            settings.GetInt("Server", "StatusCacheMs", result.statusMaxAge.count()), 0, kMaxTimeoutMs));
+
+        if (auto path = settings.Get("Server", "HealthPath"); path && path->starts_with('/')) {
+            result.healthPath = *path;
+        }
+        if (auto path = settings.Get("Server", "MonitorPath"); path && path->starts_with('/')) {
+            result.monitorPath = *path;
+        }
+        if (auto path = settings.Get("Server", "EventsPath"); path && path->starts_with('/')) {
+            result.eventsPath = *path;
+        }
+        if (auto path = settings.Get("Server", "StatusPath"); path && path->starts_with('/')) {
+            result.statusPath = *path;
+        }
+        if (auto path = settings.Get("Server", "StatusEventsPath"); path && path->starts_with('/')) {
+            result.statusEventsPath = *path;
+        }
+        if (auto path = settings.Get("Server", "PatchPath"); path && path->starts_with('/')) {
+            result.patchPath = *path;
+        }
+
+        result.pollInterval = GetMillis(settings, "Polling", "IntervalMs", result.pollInterval);
+        result.backoff.initial = result.pollInterval;
+        result.backoff.max =
+            std::max(result.pollInterval, GetMillis(settings, "Polling", "BackoffMaxMs", result.backoff.max));
+        result.backoff.multiplier =
+            std::clamp(settings.GetFloat("Polling", "BackoffMultiplier", result.backoff.multiplier), 1.0, 10.0);
+        result.backoff.jitter =
+            std::clamp(settings.GetFloat("Polling", "BackoffJitter", result.backoff.jitter), 0.0, 1.0);
+        result.backoff.openAfter = static_cast<uint32_t>(
+            std::clamp<int64_t>(settings.GetInt("Polling", "BreakerThreshold", result.backoff.openAfter), 0, 100));
+
+        result.monitorDownInterval =
+            GetMillis(settings, "Polling", "HealthCheckDownMs", result.monitorDownInterval);
+        result.monitorUpInterval = GetMillis(settings, "Polling", "HealthCheckUpMs", result.monitorUpInterval);
+
+        LOG_INFO(GameMaster, "SkyrimNet server {} (status timeout {} ms, poll every {} ms, breaker after {} failures)",
+                 result.baseUrl, result.statusTimeouts.read.count(), result.pollInterval.count(),
+                 result.backoff.openAfter);
+        return result;
+    }
+
+}  // namespace SkyrimNetUI::SkyrimNet
@@ -0,0 +1,325 @@
+#include "ui/InteropChannel.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+
+#include "logging/Log.h"
+#include "metrics/Metrics.h"
+#include "pch.h"
+
+namespace SkyrimNetUI::UI {
+
+    namespace {
+        constexpr char kBase64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        constexpr auto kBase64Values = []() {
+            std::array<int8_t, 256> values{};
+            values.fill(-1);
+            for (int i = 0; i < 64; ++i) {
+                values[static_cast<uint8_t>(kBase64Alphabet[i])] = static_cast<int8_t>(i);
+            }
+            return values;
+        }();
+
+        // Room for the separators and the numbers in front of a frame's chunk
+        constexpr size_t kMaxHeaderDigits = 5 + 10 + 10 + 10 + 5;
+
+        // Frames are embedded in a script unescaped, so names are restricted to safe characters
+        bool IsValidName(std::string_view name) {
+            return !name.empty() && std::ranges::all_of(name, [](char c) {
+                return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '.' || c == '_' || c == '-';
+            });
+        }
+
+        template <typename T>
+        std::optional<T> ParseNumber(std::string_view text) {
+            T value{};
+            auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (error != std::errc{} || end != text.data() + text.size()) {
+                return std::nullopt;
+            }
+            return value;
+        }
+
+        void PostToGameThread(std::function<void()> task) {
+            if (auto* tasks = SKSE::GetTaskInterface()) {
+                tasks->AddTask(std::move(task));
+            } else {
+                task();
+            }
+        }
+    }
+
+    std::string Base64Encode(std::string_view bytes) {
+        std::string out;
+        out.reserve((bytes.size() + 2) / 3 * 4);
+        size_t i = 0;
+        for (; i + 3 <= bytes.size(); i += 3) {
+            const uint32_t triple = static_cast<uint32_t>(static_cast<uint8_t>(bytes[i])) << 16 |
+                                    static_cast<uint32_t>(static_cast<uint8_t>(bytes[i + 1])) << 8 |
+                                    static_cast<uint8_t>(bytes[i + 2]);
+            out.push_back(kBase64Alphabet[(triple >> 18) & 0x3F]);
+            out.push_back(kBase64Alphabet[(triple >> 12) & 0x3F]);
+            out.push_back(kBase64Alphabet[(triple >> 6) & 0x3F]);
+            out.push_back(kBase64Alphabet[triple & 0x3F]);
+        }
+        if (const size_t rest = bytes.size() - i; rest > 0) {
+            uint32_t triple = static_cast<uint32_t>(static_cast<uint8_t>(bytes[i])) << 16;
+            if (rest == 2) {
+                triple |= static_cast<uint32_t>(static_cast<uint8_t>(bytes[i + 1])) << 8;
+            }
+            out.push_back(kBase64Alphabet[(triple >> 18) & 0x3F]);
+            out.push_back(kBase64Alphabet[(triple >> 12) & 0x3F]);
+            out.push_back(rest == 2 ? kBase64Alphabet[(triple >> 6) & 0x3F] : '=');
+            out.push_back('=');
+        }
+        return out;
+    }
+
+    std::optional<std::string> Base64Decode(std::string_view text) {
+        if (text.size() % 4 != 0) {
+            return std::nullopt;
+        }
+        std::string out;
+        out.reserve(text.size() / 4 * 3);
+        for (size_t i = 0; i < text.size(); i += 4) {
+            const bool last = i + 4 == text.size();
+            const size_t padding = last ? (text[i + 3] == '=') + (text[i + 2] == '=') : 0;
+            if (padding == 1 && text[i + 2] == '=') {
+                return std::nullopt;
+            }
+            uint32_t quad = 0;
+            for (size_t j = 0; j < 4 - padding; ++j) {
+                const int8_t value = kBase64Values[static_cast<uint8_t>(text[i + j])];
+                if (value < 0) {
+                    return std::nullopt;
+                }
+                quad |= static_cast<uint32_t>(value) << (18 - 6 * j);
+            }
+            out.push_back(static_cast<char>(quad >> 16));
+            if (padding < 2) {
+                out.push_back(static_cast<char>((quad >> 8) & 0xFF));
+            }
+            if (padding < 1) {
+                out.push_back(static_cast<char>(quad & 0xFF));
+            }
+        }
+        return out;
+    }
+
+    InteropChannel& GetChannel() {
+        static InteropChannel instance;
+        return instance;
+    }
+
+    InteropChannel::InteropChannel(InteropDispatcher::FlushScheduler scheduler, size_t frameSize)
+        : scheduler_(scheduler ? std::move(scheduler) : InteropDispatcher::FlushScheduler(PostToGameThread)),
+          frameSize_(frameSize) {}
+
+    void InteropChannel::Attach(PRISMA_UI_API::IVPrismaUI1* api, PrismaView view) {
+        bool flush = false;
+        {
+            std::lock_guard lock(mutex_);
+            api_ = api;
+            view_ = view;
+            flush = api_ && !pending_.empty();
+        }
+        if (flush) {
+            ScheduleFlush();
+        }
+    }
+
+    std::vector<std::string> InteropChannel::MakeFrames(MessageType type, uint32_t id, std::string_view payload,
+                                                        size_t frameSize) {
+        if (!IsValidName(type.name)) {
+            LOG_ERROR(UI, "Invalid interop message name '{}'", type.name);
+            return {};
+        }
+
+        const auto base64 = Base64Encode(payload);
+        const size_t header = type.name.size() + kMaxHeaderDigits;
+        const size_t chunk = std::max<size_t>(4, (frameSize > header ? frameSize - header : 0) & ~size_t{3});
+        const auto count = static_cast<uint32_t>(std::max<size_t>(1, (base64.size() + chunk - 1) / chunk));
+
+        std::string prefix(type.name);
+        prefix.append("|").append(std::to_string(type.version)).append("|").append(std::to_string(id)).push_back('|');
+        const auto suffix = "|" + std::to_string(count) + "|";
+
+        std::vector<std::string> frames;
+        frames.reserve(count);
+        for (uint32_t index = 0; index < count; ++index) {
+            const auto part = std::string_view(base64).substr(index * chunk, chunk);
+            std::string frame;
+            frame.reserve(prefix.size() + 10 + suffix.size() + part.size());
+            frame.append(prefix).append(std::to_string(index)).append(suffix).append(part);
+            frames.push_back(std::move(frame));
+        }
+        return frames;
+    }
+
+    void InteropChannel::Send(MessageType type, std::string_view payload) {
+        bool schedule = false;
+        {
+            std::lock_guard lock(mutex_);
+            auto frames = MakeFrames(type, nextId_++, payload, frameSize_);
+            if (frames.empty()) {
+                return;
+            }
+            stats_.messagesSent++;
+            for (auto& frame : frames) {
+                pending_.push_back(std::move(frame));
+            }
+            schedule = api_ && !flushScheduled_;
+        }
+        if (schedule) {
+            ScheduleFlush();
+        }
+    }
+
+    void InteropChannel::On(MessageType type, Handler handler) {
+        std::lock_guard lock(mutex_);
+        handlers_.insert_or_assign(std::string(type.name), Registration{type.version, std::move(handler)});
+    }
+
+    void InteropChannel::Receive(std::string_view frame) {
+        // name|version|id|index|count|chunk
+        std::array<std::string_view, 6> fields;
+        for (size_t i = 0; i < fields.size() - 1; ++i) {
+            const auto separator = frame.find('|');
+            if (separator == std::string_view::npos) {
+                std::lock_guard lock(mutex_);
+                stats_.rejected++;
+                LOG_WARN(UI, "Malformed interop frame from the view");
+                return;
+            }
+            fields[i] = frame.substr(0, separator);
+            frame.remove_prefix(separator + 1);
+        }
+        fields.back() = frame;
+
+        const auto version = ParseNumber<uint16_t>(fields[1]);
+        const auto index = ParseNumber<uint32_t>(fields[3]);
+        const auto count = ParseNumber<uint32_t>(fields[4]);
+
+        Handler handler;
+        std::string payload;
+        {
+            std::lock_guard lock(mutex_);
+            stats_.framesReceived++;
+            if (!version || !index || !count || *count == 0 || *index >= *count || !ParseNumber<uint32_t>(fields[2])) {
+                stats_.rejected++;
+                LOG_WARN(UI, "Malformed interop frame header for '{}'", fields[0]);
+                return;
+            }
+
+            std::string key(fields[0]);
+            key.append("|").append(fields[2]);
+            auto it = partials_.find(key);
+            if (*index == 0) {
+                it = partials_.insert_or_assign(std::move(key), Partial{*version, 0, *count, {}}).first;
+            } else if (it == partials_.end() || it->second.next != *index || it->second.count != *count) {
+                stats_.rejected++;
+                LOG_WARN(UI, "Out of order interop frame {}/{} for '{}'", *index, *count, fields[0]);
+                if (it != partials_.end()) {
+                    partials_.erase(it);
+                }
+                return;
+            }
+
+            auto& partial = it->second;
+            partial.base64.append(fields[5]);
+            partial.next++;
+            if (partial.base64.size() > kMaxInboundBytes / 3 * 4) {
+                stats_.rejected++;
+                LOG_WARN(UI, "Interop message '{}' from the view exceeds {} bytes", fields[0], kMaxInboundBytes);
+                partials_.erase(it);
+                return;
+            }
+            if (partial.next < partial.count) {
+                return;
+            }
+
+            auto decoded = Base64Decode(partial.base64);
+            partials_.erase(it);
+            auto registration = handlers_.find(std::string(fields[0]));
+            if (!decoded || registration == handlers_.end() || *version > registration->second.version) {
+                stats_.rejected++;
+                LOG_WARN(UI, "Rejected interop message '{}' v{} from the view", fields[0], *version);
+                return;
+            }
+            stats_.messagesReceived++;
+            handler = registration->second.handler;
+            payload = std::move(*decoded);
+        }
+
+        MsgPack::Reader reader(payload);
+        handler(*version, reader);
+    }
+
+    void InteropChannel::Reset() {
+        std::lock_guard lock(mutex_);
+        pending_.clear();
+        partials_.clear();
+    }
+
+    void InteropChannel::ScheduleFlush() {
+        {
+            std::lock_guard lock(mutex_);
+            if (flushScheduled_ || !api_) {
+                return;
+            }
+            flushScheduled_ = true;
+        }
+        // Outside the lock: without a task queue the scheduler flushes right away
+        scheduler_([this]() { Flush(); });
+    }
+
+    size_t InteropChannel::Flush() {
+        PRISMA_UI_API::IVPrismaUI1* api = nullptr;
+        PrismaView view = 0;
+        std::string script;
+        size_t count = 0;
+        bool more = false;
+        {
+            std::lock_guard lock(mutex_);
+            flushScheduled_ = false;
+            if (pending_.empty() || !api_) {
+                return 0;
+            }
+            if (!api_->IsValid(view_)) {
+                LOG_WARN(UI, "Dropping {} interop frame(s): view [{}] is not valid", pending_.size(), view_);
+                pending_.clear();
+                return 0;
+            }
+
+            script = "interopReceive([";
+            while (!pending_.empty() && (count == 0 || script.size() + pending_.front().size() <= kMaxFlushBytes)) {
+                script.append(count == 0 ? "\"" : ",\"").append(pending_.front()).push_back('"');
+                stats_.bytesSent += pending_.front().size();
+                pending_.pop_front();
+                ++count;
+            }
+            script.append("])");
+            stats_.framesSent += count;
+            stats_.invokes++;
+            more = !pending_.empty();
+            api = api_;
+            view = view_;
+        }
+
+        Metrics::Increment(Metrics::Counter::InteropCalls, count);
+        api->Invoke(view, script.c_str());
+        if (more) {
+            // The rest goes out with the next game frame
+            ScheduleFlush();
+        }
+        return count;
+    }
+
+    InteropChannel::Stats InteropChannel::GetStats() const {
+        std::lock_guard lock(mutex_);
+        return stats_;
+    }
+
+}  // namespace SkyrimNetUI::UI
@@ -0,0 +1,171 @@
+#include "ui/InteropDispatcher.h"
+
+#include <algorithm>
+
+#include "logging/Log.h"
+#include "metrics/Metrics.h"
+#include "pch.h"
+
+namespace SkyrimNetUI::UI {
+
+    namespace {
+        // Append argument as a double-quoted JS string literal
+        void AppendJsString(std::string& out, std::string_view value) {
+            constexpr char kHex[] = "0123456789abcdef";
+            out.push_back('"');
+            for (char c : value) {
+                switch (c) {
+                    case '"':
+                        out.append("\\\"");
+                        break;
+                    case '\\':
+                        out.append("\\\\");
+                        break;
+                    case '\n':
+                        out.append("\\n");
+                        break;
+                    case '\r':
+                        out.append("\\r");
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20) {
+                            out.append("\\x");
+                            out.push_back(kHex[(c >> 4) & 0xF]);
+                            out.push_back(kHex[c & 0xF]);
+                        } else {
+                            out.push_back(c);
+                        }
+                        break;
+                }
+            }
+            out.push_back('"');
+        }
+
+        void PostToGameThread(std::function<void()> task) {
+            if (auto* tasks = SKSE::GetTaskInterface()) {
+                tasks->AddTask(std::move(task));
+            } else {
+                task();
+            }
+        }
+    }
+
+    InteropDispatcher& GetDispatcher() {
+        static InteropDispatcher instance;
+        return instance;
+    }
+
+    InteropDispatcher::InteropDispatcher(FlushScheduler scheduler)
+        : scheduler_(scheduler ? std::move(scheduler) : FlushScheduler(PostToGameThread)) {}
+
+    void InteropDispatcher::Attach(PRISMA_UI_API::IVPrismaUI1* api, PrismaView view) {
+        std::lock_guard lock(mutex_);
+        if (api != api_ || view != view_) {
+            delivered_.clear();
+            domReady_ = false;
+        }
+        api_ = api;
+        view_ = view;
+        if (api_ && !pending_.empty()) {
+            ScheduleFlushLocked();
+        }
+    }
+
+    void InteropDispatcher::MarkDomReady() {
+        std::lock_guard lock(mutex_);
+        domReady_ = true;
+        if (api_ && !pending_.empty()) {
+            ScheduleFlushLocked();
+        }
+    }
+
+    void InteropDispatcher::Queue(std::string_view functionName, std::string_view argument) {
+        std::lock_guard lock(mutex_);
+        stats_.queued++;
+
+        auto it = std::find_if(pending_.begin(), pending_.end(),
+                               [functionName](const auto& call) { return call.first == functionName; });
+        auto shown = delivered_.find(std::string(functionName));
+        const bool alreadyShown = shown != delivered_.end() && shown->second == argument;
+
+        if (it != pending_.end()) {
+            stats_.coalesced++;
+            if (alreadyShown) {
+                // A later call undid the pending one, so nothing needs to be sent
+                pending_.erase(it);
+                stats_.dropped++;
+            } else {
+                it->second.assign(argument);
+            }
+            return;
+        }
+
+        if (alreadyShown) {
+            stats_.dropped++;
+            return;
+        }
+
+        pending_.emplace_back(functionName, argument);
+        ScheduleFlushLocked();
+    }
+
+    void InteropDispatcher::Reset() {
+        std::lock_guard lock(mutex_);
+        delivered_.clear();
+    }
+
+    void InteropDispatcher::ScheduleFlushLocked() {
+        if (flushScheduled_ || !api_ || !domReady_) {
+            return;
+        }
+        flushScheduled_ = true;
+        scheduler_([this]() { Flush(); });
+    }
+
+    size_t InteropDispatcher::Flush() {
+        PRISMA_UI_API::IVPrismaUI1* api = nullptr;
+        PrismaView view = 0;
+        std::string script;
+        size_t count = 0;
+        {
+            std::lock_guard lock(mutex_);
+            flushScheduled_ = false;
+            // Held calls go out with the flush MarkDomReady schedules
+            if (pending_.empty() || !api_ || !domReady_) {
+                return 0;
+            }
+            if (!api_->IsValid(view_)) {
+                LOG_WARN(UI, "Dropping {} interop call(s): view [{}] is not valid", pending_.size(), view_);
+                pending_.clear();
+                return 0;
+            }
+
+            // Each call is isolated so one failing handler doesn't skip the rest
+            for (auto& [function, argument] : pending_) {
+                script.append("try{").append(function).push_back('(');
+                AppendJsString(script, argument);
+                script.append(")}catch(e){console.error(e)}\n");
+                delivered_[function] = std::move(argument);
+            }
+
+            count = pending_.size();
+            pending_.clear();
+            stats_.issued += count;
+            stats_.invokes++;
+            api = api_;
+            view = view_;
+        }
+
+        LOG_TRACE(UI, "Flushing {} interop call(s) to view [{}]", count, view);
+        Metrics::Increment(Metrics::Counter::InteropCalls, count);
+        Metrics::ScopedTimer timer(Metrics::Metric::InteropFlush);
+        api->Invoke(view, script.c_str());
+        return count;
+    }
+
+    InteropDispatcher::Stats InteropDispatcher::GetStats() const {
+        std::lock_guard lock(mutex_);
+        return stats_;
+    }
+
+}  // namespace SkyrimNetUI::UI
@@ -2,13 +2,30 @@
 #include "pch.h"
 #include "ui/UIBridge.h"
 
+#include "config/IniFile.h"
+#include "http/HttpClient.h"
+#include "http/ProxyServer.h"
 #include "keyhandler/keyhandler.h"
+#include "lifecycle/Lifecycle.h"
+#include "logging/Log.h"
+#include "metrics/Metrics.h"
+#include "msgpack/MsgPack.h"
+#include "scheduler/TaskScheduler.h"
+#include "skyrimnet/EventFeed.h"
 #include "skyrimnet/GameMasterController.h"
+#include "skyrimnet/HealthMonitor.h"
+#include "ui/InteropChannel.h"
+#include "ui/InteropDispatcher.h"
+#include "ui/ViewManager.h"
 
 namespace SkyrimNetUI::UI {
 
     static PRISMA_UI_API::IVPrismaUI1 *g_prismaUI = nullptr;
     static PrismaView g_view = 0;
+    static bool g_initialized = false;
+    static Scheduler::TaskHandle g_warmUpTask;
+    static std::unique_ptr<Http::ProxyServer> g_proxy;
+    static Scheduler::TaskHandle g_eventDelivery;
 #ifdef PRISMAUI_ENABLE_INSPECTOR
     static bool g_inspectorInitialized = false;
 #endif
@@ -18,25 +35,377 @@ namespace SkyrimNetUI::UI {
     static KeyHandlerEvent g_inspectorEventHandler = 0;
 #endif
 
-    constexpr uint32_t TOGGLE_FOCUS_KEY = 0x3E;  // F4 key
+    // Focus changes swallow key-ups, which would leave a modifier or the toggle key stuck down
+    static void ResetKeyStates() {
+        if (g_keyHandler) {
+            g_keyHandler->ResetKeyStates();
+        }
+    }
+
+    // Defaults for the [Keybindings] section of the settings file
+    constexpr const char *kDefaultToggleViewBinding = "F4";
 #ifdef PRISMAUI_ENABLE_INSPECTOR
-    constexpr uint32_t TOGGLE_INSPECTOR_KEY = 0x41;  // F7 key
+    constexpr const char *kDefaultToggleInspectorBinding = "F7";
 
     static bool EnsureInspectorSetup();
 #endif
 
+    /**
+     * Suspends background work during loading screens and while a game-pausing menu
+     * other than our own view is open (focusing the view pauses the game as well).
+     */
+    class MenuWatcher final : public RE::BSTEventSink<RE::MenuOpenCloseEvent> {
+    public:
+        static MenuWatcher *GetSingleton() {
+            static MenuWatcher singleton;
+            return &singleton;
+        }
+
+        RE::BSEventNotifyControl ProcessEvent(const RE::MenuOpenCloseEvent *event,
+                                              RE::BSTEventSource<RE::MenuOpenCloseEvent> *) override {
+            if (!event) {
+                return RE::BSEventNotifyControl::kContinue;
+            }
+
+            auto &lifecycle = Lifecycle::GetManager();
+            if (event->menuName == RE::LoadingMenu::MENU_NAME) {
+                lifecycle.Set(Lifecycle::Reason::LoadingScreen, event->opening);
+            }
+            auto *ui = RE::UI::GetSingleton();
+            const bool paused = ui && ui->GameIsPaused() && !HasFocus();
+            if (paused != lifecycle.IsActive(Lifecycle::Reason::Paused)) {
+                // Key-ups made inside a pausing menu never reach the key handler
+                ResetKeyStates();
+            }
+            lifecycle.Set(Lifecycle::Reason::Paused, paused);
+            return RE::BSEventNotifyControl::kContinue;
+        }
+    };
+
+    /**
+     * New live events, oldest first:
+     * {overwritten: events the feed's buffer has dropped so far, events: [[sequence, type, data], ...]}
+     */
+    constexpr MessageType kEventsMessage{"events", 1};
+
+    // Everything buffered since the last batch goes out at once; the ring bounds the size
+    static void DeliverEvents() {
+        auto &feed = SkyrimNet::GetEventFeed();
+        const auto batch = feed.TakeBatch(std::numeric_limits<size_t>::max());
+        if (batch.empty()) {
+            return;
+        }
+
+        MsgPack::Writer payload(batch.size() * 128);
+        payload.Map(2);
+        payload.String("overwritten");
+        payload.UInt(feed.GetStats().overwritten);
+        payload.String("events");
+        payload.Array(static_cast<uint32_t>(batch.size()));
+        for (const auto &event : batch) {
+            payload.Array(3);
+            payload.UInt(event.sequence);
+            payload.String(event.type);
+            payload.String(event.data);
+        }
+        GetChannel().Send(kEventsMessage, payload);
+    }
+
+    // Status polling and health checks only run while the view is open and the game is running.
+    // Live events are collected while the game runs unpaused and handed to the view while it is open.
+    static void RegisterServices() {
+        auto &lifecycle = Lifecycle::GetManager();
+        lifecycle.Register(
+            "GameMaster polling", Lifecycle::kAllReasons, []() { SkyrimNet::GetController().StartPolling(); },
+            []() { SkyrimNet::GetController().StopPolling(); });
+        lifecycle.Register(
+            "Health monitor", Lifecycle::kAllReasons, []() { SkyrimNet::GetHealthMonitor().Start(); },
+            []() { SkyrimNet::GetHealthMonitor().Stop(); });
+
+        const auto &settings = Config::GetSettings();
+        if (!settings.GetBool("Events", "Enabled", true)) {
+            return;
+        }
+        lifecycle.Register(
+            "Event feed", Lifecycle::kLoadingReasons | Lifecycle::Mask(Lifecycle::Reason::Paused),
+            []() { SkyrimNet::GetEventFeed().Start(); }, []() { SkyrimNet::GetEventFeed().Stop(); });
+        const auto interval =
+            std::chrono::milliseconds(std::clamp<int64_t>(settings.GetInt("Events", "BatchIntervalMs", 100), 16, 5000));
+        lifecycle.Register(
+            "Event delivery", Lifecycle::kAllReasons,
+            [interval]() {
+                g_eventDelivery = Scheduler::GetScheduler().PostPeriodic(Scheduler::Lane::UI, interval, DeliverEvents);
+            },
+            []() { g_eventDelivery.Cancel(); });
+    }
+
+    static void OnDomReady(PrismaView v) {
+        LOG_INFO(UI, "View DOM is ready. v={}, g_view={}", v, g_view);
+
+        // A fresh DOM shows none of the previously delivered state. A lazily created view
+        // may already have been toggled open while it was loading. Attaching here covers a
+        // page that loads before EnsureView has attached it.
+        GetDispatcher().Attach(g_prismaUI, v);
+        GetDispatcher().Reset();
+        GetChannel().Reset();
+        GetDispatcher().Queue("setServerUrl",
+                              g_proxy ? g_proxy->Url() : SkyrimNet::GetController().GetServerSettings().baseUrl);
+        GetDispatcher().Queue("toggleSkyrimNetUIDiv", HasFocus() ? "show" : "hide");
+        const auto health = SkyrimNet::GetHealthMonitor().GetHealth();
+        if (health != SkyrimNet::ServerHealth::Unknown) {
+            GetDispatcher().Queue("setServerReachable", health == SkyrimNet::ServerHealth::Up ? "true" : "false");
+        }
+        std::string panels;
+        for (const auto &name : GetViewManager().GetPooledPanels()) {
+            panels.append(panels.empty() ? "" : ",").append(name);
+        }
+        GetDispatcher().Queue("setPanels", panels);
+        // The status may have been delivered to the old page, or reported before this one loaded
+        const auto &controller = SkyrimNet::GetController();
+        GetDispatcher().Queue("updateGameMasterStatus",
+                              controller.IsTogglePending() ? "pending" : controller.IsEnabled() ? "true" : "false");
+        GetDispatcher().MarkDomReady();
+
+        // Note: GameMaster polling and health checks are started when the view
+        // is shown (in ToggleView), not during initialization. This prevents
+        // unnecessary HTTP requests when the view is hidden.
+    }
+
+    /**
+     * Metrics snapshot for the view's Metrics panel, latencies in microseconds:
+     * {histograms: {name: [count, mean, p50, p90, p99, max]}, counters: {name: value}}
+     */
+    constexpr MessageType kMetricsMessage{"metrics", 1};
+
+    static void SendMetrics() {
+        const auto snapshot = Metrics::TakeSnapshot();
+        const auto micros = [](uint64_t nanos) { return static_cast<double>(nanos) / 1000.0; };
+
+        MsgPack::Writer payload(1024);
+        payload.Map(2);
+        payload.String("histograms");
+        payload.Map(static_cast<uint32_t>(Metrics::kMetricCount));
+        for (size_t m = 0; m < Metrics::kMetricCount; ++m) {
+            const auto &histogram = snapshot.histograms[m];
+            payload.String(Metrics::Name(static_cast<Metrics::Metric>(m)));
+            payload.Array(6);
+            payload.UInt(histogram.count);
+            payload.Double(histogram.count ? micros(histogram.totalNanos) / static_cast<double>(histogram.count) : 0);
+            payload.Double(micros(histogram.p50Nanos));
+            payload.Double(micros(histogram.p90Nanos));
+            payload.Double(micros(histogram.p99Nanos));
+            payload.Double(micros(histogram.maxNanos));
+        }
+        payload.String("counters");
+        payload.Map(static_cast<uint32_t>(Metrics::kCounterCount));
+        for (size_t c = 0; c < Metrics::kCounterCount; ++c) {
+            payload.String(Metrics::Name(static_cast<Metrics::Counter>(c)));
+            payload.UInt(snapshot.counters[c]);
+        }
+        GetChannel().Send(kMetricsMessage, payload);
+    }
+
+    // Hide the overlay and any panels opened from it
+    static void HideOverlay() {
+        Lifecycle::GetManager().Suspend(Lifecycle::Reason::ViewHidden);
+        GetViewManager().CloseAll();
+        g_prismaUI->Unfocus(g_view);
+        ResetKeyStates();
+        GetDispatcher().Queue("toggleSkyrimNetUIDiv", "hide");
+#ifdef PRISMAUI_ENABLE_INSPECTOR
+        if (g_prismaUI->IsInspectorVisible(g_view)) {
+            g_prismaUI->SetInspectorVisibility(g_view, false);
+            LOG_INFO(UI, "Inspector overlay hidden while closing SkyrimNet UI view.");
+        }
+#endif
+    }
+
+    // Define the main view and the pooled panels of the [Panels] section; listeners take effect once a view exists
+    static void DefinePanels() {
+        constexpr const char *kViewPath = "PrismaUI-SkyrimNet-UI/index.html";
+        auto &views = GetViewManager();
+        views.Define("main", {.htmlPath = kViewPath});
+        views.SetReadyHandler("main", OnDomReady);
+
+        views.AddListener("main", "closePrismaUIWindow", [](std::string_view) {
+            LOG_DEBUG(UI, "Received close from JS");
+            if (g_prismaUI) {
+                HideOverlay();
+            }
+        });
+
+        views.AddListener("main", "onGameMasterToggle", [](std::string_view) {
+            LOG_DEBUG(UI, "GameMaster toggle requested from JS");
+            SkyrimNet::GetController().ToggleAsync();
+        });
+
+        views.AddListener("main", "requestMetrics", [](std::string_view) {
+            SendMetrics();
+            GetDispatcher().Queue("updateViewStats", GetViewManager().StatsToJson());
+        });
+
+        views.AddListener("main", "interopFrame", [](std::string_view frame) { GetChannel().Receive(frame); });
+
+        // Opening may create a view, which is done from the game thread like the main view
+        views.AddListener("main", "openPanel", [](std::string_view name) {
+            auto *tasks = SKSE::GetTaskInterface();
+            if (!tasks) {
+                return;
+            }
+            tasks->AddTask([panel = std::string(name)]() {
+                if (!GetViewManager().Open(panel)) {
+                    LOG_WARN(UI, "Could not open panel '{}'", panel);
+                }
+            });
+        });
+
+        const auto &baseUrl = SkyrimNet::GetController().GetServerSettings().baseUrl;
+        for (const auto &[name, target] : Config::GetSettings().Section("Panels")) {
+            if (name == "main" || target.empty()) {
+                LOG_WARN(UI, "Ignoring panel '{}'", name);
+                continue;
+            }
+            // Paths are relative to the SkyrimNet server
+            views.Define(name, {.url = target.front() == '/' ? baseUrl + target : target, .order = 1});
+            views.AddListener(name, "closePanel", [panel = name](std::string_view) {
+                GetViewManager().Close(panel);
+                // Back to the overlay the panel was opened from
+                if (g_prismaUI && !Lifecycle::GetManager().IsActive(Lifecycle::Reason::ViewHidden)) {
+                    g_prismaUI->Focus(g_view, true);
+                }
+            });
+            LOG_INFO(UI, "Panel '{}' defined for {}", name, target);
+        }
+    }
+
+    // Serve the web UI to the view through the caching proxy if the [Proxy] section enables it
+    static void StartProxy() {
+        const auto &settings = Config::GetSettings();
+        if (g_proxy || !settings.GetBool("Proxy", "Enabled", false)) {
+            return;
+        }
+
+        const auto &server = SkyrimNet::GetController().GetServerSettings();
+        Http::AssetProxy::Settings proxySettings;
+        proxySettings.upstream = server.baseUrl;
+        proxySettings.timeouts = server.configTimeouts;
+        proxySettings.streamTimeouts = server.eventsTimeouts;
+        proxySettings.maxAge = std::chrono::seconds(std::clamp<int64_t>(
+            settings.GetInt("Proxy", "AssetMaxAgeSeconds", proxySettings.maxAge.count()), 0, 24 * 60 * 60));
+        const auto cacheMiB = std::clamp<int64_t>(settings.GetInt("Proxy", "CacheMiB", 32), 1, 512);
+        proxySettings.maxBytes = static_cast<size_t>(cacheMiB) << 20;
+
+        g_proxy = std::make_unique<Http::ProxyServer>(Http::GetDefaultTransport(), std::move(proxySettings));
+        const auto port = static_cast<int>(std::clamp<int64_t>(settings.GetInt("Proxy", "Port", 18080), 0, 65535));
+        if (!g_proxy->Start(port)) {
+            LOG_WARN(UI, "Loading the web UI directly from {}", server.baseUrl);
+            g_proxy.reset();
+        }
+    }
+
+    // Create the view and the panel pool unless that already happened; game thread only
+    static bool EnsureView() {
+        if (!g_prismaUI) {
+            return false;
+        }
+
+        // Only create view once - check both that g_view is set AND valid
+        if (g_view != 0 && g_prismaUI->IsValid(g_view)) {
+            return true;
+        }
+
+        g_warmUpTask.Cancel();
+        StartProxy();
+        auto &views = GetViewManager();
+        g_view = views.Acquire("main");
+
+        // Note: View is created asynchronously on UI thread, so g_view is valid
+        // immediately even though the actual Ultralight View won't exist until
+        // later.
+        LOG_INFO(UI, "View [{}] creation requested successfully.", g_view);
+
+        GetDispatcher().Attach(g_prismaUI, g_view);
+        GetChannel().Attach(g_prismaUI, g_view);
+        if (g_view != 0 && !views.GetPooledPanels().empty()) {
+            // Hidden host views, so that the first panel opens without a CreateView
+            const auto poolSize = Config::GetSettings().GetInt("View", "PanelPoolSize", 1);
+            views.Prewarm(static_cast<size_t>(std::clamp<int64_t>(poolSize, 0, ViewManager::kMaxViews - 1)));
+        }
+        return g_view != 0 && g_prismaUI->IsValid(g_view);
+    }
+
+    // Create the view ahead of the first toggle once the delay has passed outside loading screens
+    static void ScheduleWarmUp(std::chrono::milliseconds delay) {
+        g_warmUpTask = Scheduler::GetScheduler().PostDelayed(Scheduler::Lane::Background, delay, [delay]() {
+            auto *tasks = SKSE::GetTaskInterface();
+            if (!tasks) {
+                return;
+            }
+            tasks->AddTask([delay]() {
+                if (!g_initialized || (g_view != 0 && g_prismaUI && g_prismaUI->IsValid(g_view))) {
+                    return;
+                }
+                if (Lifecycle::GetManager().IsAnyActive(Lifecycle::kLoadingReasons)) {
+                    ScheduleWarmUp(delay);
+                    return;
+                }
+                LOG_DEBUG(UI, "Warming up the view before first use");
+                EnsureView();
+            });
+        });
+    }
+
+    // Read a binding from the settings file, falling back to the default if it is missing or invalid
+    static KeyBinding LoadKeyBinding(const char *name, const char *fallback) {
+        const auto text = Config::GetSettings().Get("Keybindings", name).value_or(fallback);
+        if (auto binding = ParseKeyBinding(text)) {
+            return *binding;
+        }
+        LOG_WARN(UI, "Invalid key binding '{}' for {}, using {}", text, name, fallback);
+        return *ParseKeyBinding(fallback);
+    }
+
     void Initialize() {
         // Check if already fully initialized
-        if (g_prismaUI && g_view != 0) {
-            logger::warn("UI already initialized with view [{}]", g_view);
+        if (g_initialized) {
+            LOG_WARN(UI, "UI already initialized with view [{}]", g_view);
             return;
         }
+        const auto started = std::chrono::steady_clock::now();
 
         // Initialize key handler FIRST so it's ready for registration
         if (!g_keyHandler) {
             KeyHandler::RegisterSink();
             g_keyHandler = KeyHandler::GetSingleton();
-            logger::info("KeyHandler initialized: {}", (void *)g_keyHandler);
+            LOG_INFO(UI, "KeyHandler initialized: {}", (void *)g_keyHandler);
+        }
+
+        SkyrimNet::GetController().SetStatusListener([](SkyrimNet::GameMasterStatus status) {
+            if (status == SkyrimNet::GameMasterStatus::Pending) {
+                UpdateGameMasterPending();
+            } else {
+                UpdateGameMasterStatus(status == SkyrimNet::GameMasterStatus::Enabled);
+            }
+        });
+
+        SkyrimNet::GetHealthMonitor().SetListener([](bool reachable) {
+            GetDispatcher().Queue("setServerReachable", reachable ? "true" : "false");
+            if (reachable) {
+                SkyrimNet::GetController().ReplayJournal();
+                if (Config::GetSettings().GetBool("Events", "Enabled", true)) {
+                    SkyrimNet::GetEventFeed().Reconnect();
+                }
+            }
+        });
+
+        // Toggles made while the server is down are kept next to the log until it is back
+        if (auto directory = logger::log_directory()) {
+            SkyrimNet::GetController().OpenJournal(*directory / "PrismaUI-SkyrimNet-UI-commands.journal");
+        }
+
+        RegisterServices();
+        if (auto *ui = RE::UI::GetSingleton()) {
+            ui->AddEventSink<RE::MenuOpenCloseEvent>(MenuWatcher::GetSingleton());
         }
 
         // Only request API once
@@ -48,149 +417,114 @@ namespace SkyrimNetUI::UI {
                 logger::critical("PrismaUI API pointer is null. Cannot create view.");
                 return;
             }
+            GetViewManager().Attach(g_prismaUI);
+            DefinePanels();
         }
 
-        constexpr const char *kViewPath = "PrismaUI-SkyrimNet-UI/index.html";
-
-        // Only create view once - check both that g_view is set AND valid
-        if (g_view == 0 || !g_prismaUI->IsValid(g_view)) {
-            logger::info("Creating PrismaUI view with path: '{}'.", kViewPath);
-
-            g_view = g_prismaUI->CreateView(kViewPath, []([[maybe_unused]] PrismaView v) {
-                logger::info("View DOM is ready. v={}, g_view={}", v, g_view);
-
-                g_prismaUI->InteropCall(g_view, "toggleSkyrimNetUIDiv", "hide");
-
-                // Note: GameMaster polling is started when view is shown (in
-                // ToggleView), not during initialization. This prevents unnecessary
-                // HTTP requests when the view is hidden.
-            });
-
-            // Note: View is created asynchronously on UI thread, so g_view is valid
-            // immediately even though the actual Ultralight View won't exist until
-            // later.
-            logger::info("View [{}] creation requested successfully.", g_view);
-        }
-
-        // Register JS listeners (only once, outside the creation block)
-        // These will be active once the DOM is ready
-        if (g_view != 0) {
-            g_prismaUI->RegisterJSListener(g_view, "closePrismaUIWindow", [](const char *) -> void {
-                logger::info("Received close from JS");
-                if (g_prismaUI) {
-                    g_prismaUI->Unfocus(g_view);
-                    g_prismaUI->InteropCall(g_view, "toggleSkyrimNetUIDiv", "hide");
-#ifdef PRISMAUI_ENABLE_INSPECTOR
-                    if (g_prismaUI->IsInspectorVisible(g_view)) {
-                        g_prismaUI->SetInspectorVisibility(g_view, false);
-                    }
-#endif
-                }
-            });
-
-            g_prismaUI->RegisterJSListener(g_view, "onGameMasterToggle", [](const char *) -> void {
-                logger::info("GameMaster toggle requested from JS");
-                SkyrimNet::GetController().Toggle();
-            });
+        // The view costs an Ultralight page plus whatever its iframes load, so by default it is
+        // only created on first use ([View] Lazy), optionally warmed up once the game settles
+        const auto &settings = Config::GetSettings();
+        if (!settings.GetBool("View", "Lazy", true)) {
+            EnsureView();
+        } else if (const auto warmUp = settings.GetInt("View", "WarmUpSeconds", 0); warmUp > 0) {
+            ScheduleWarmUp(std::chrono::seconds(warmUp));
         }
 
         // Register key handlers immediately - don't wait for DOM callback
         // Key handlers work independently of the view's DOM state
         if (g_keyHandler) {
             if (!g_toggleEventHandler) {
-                g_toggleEventHandler = g_keyHandler->Register(TOGGLE_FOCUS_KEY, KeyEventType::KEY_DOWN, ToggleView);
-                logger::info("F4 toggle key handler registered with handle {}", g_toggleEventHandler);
+                g_toggleEventHandler =
+                    g_keyHandler->Register(LoadKeyBinding("ToggleView", kDefaultToggleViewBinding), ToggleView);
+                LOG_INFO(UI, "Toggle key handler registered with handle {}", g_toggleEventHandler);
             }
 #ifdef PRISMAUI_ENABLE_INSPECTOR
             if (!g_inspectorEventHandler) {
-                g_inspectorEventHandler =
-                    g_keyHandler->Register(TOGGLE_INSPECTOR_KEY, KeyEventType::KEY_DOWN, ToggleInspector);
-                logger::info("F7 inspector key handler registered with handle {}", g_inspectorEventHandler);
+                g_inspectorEventHandler = g_keyHandler->Register(
+                    LoadKeyBinding("ToggleInspector", kDefaultToggleInspectorBinding), ToggleInspector);
+                LOG_INFO(UI, "Inspector key handler registered with handle {}", g_inspectorEventHandler);
             }
 #endif
         } else {
-            logger::error("KeyHandler is null - key handlers NOT registered!");
+            LOG_ERROR(UI, "KeyHandler is null - key handlers NOT registered!");
         }
 
-        logger::info("UI initialized successfully");
+        g_initialized = true;
+        const auto elapsed =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started);
+        LOG_INFO(UI, "UI initialized successfully in {} us ({})", elapsed.count(),
+                 g_view != 0 ? "view created" : "view deferred until first use");
     }
 
     void Shutdown() {
-        SkyrimNet::GetController().StopPolling();
+        if (auto *ui = RE::UI::GetSingleton()) {
+            ui->RemoveEventSink<RE::MenuOpenCloseEvent>(MenuWatcher::GetSingleton());
+        }
+        g_warmUpTask.Cancel();
+        Lifecycle::GetManager().UnregisterAll();
+        g_proxy.reset();
+
+        // Wind the services down and join the workers while the game is still running; the
+        // singletons' destructors only cancel, since the workers are gone by static destruction
+        SkyrimNet::GetEventFeed().Shutdown();
+        SkyrimNet::GetHealthMonitor().Shutdown();
+        SkyrimNet::GetController().Shutdown();
+        Scheduler::GetScheduler().Shutdown();
+        Http::ClosePool();
+        GetDispatcher().Attach(nullptr, 0);
+        GetChannel().Attach(nullptr, 0);
+        GetViewManager().Shutdown();
         g_prismaUI = nullptr;
         g_view = 0;
-        logger::info("UI shutdown complete");
+        g_initialized = false;
+        LOG_INFO(UI, "UI shutdown complete");
     }
 
     void ToggleView() {
-        logger::info("ToggleView called with g_view = [{}], g_prismaUI = {}", g_view, (void *)g_prismaUI);
+        LOG_DEBUG(UI, "ToggleView called with g_view = [{}], g_prismaUI = {}", g_view, (void *)g_prismaUI);
 
         if (!g_prismaUI) {
             logger::critical("PrismaUI API pointer is null. Cannot toggle view.");
             return;
         }
 
-        logger::info("About to call IsValid on view [{}]...", g_view);
-        const bool isValid = g_prismaUI->IsValid(g_view);
-        logger::info("IsValid returned: {}", isValid);
-
-        if (!isValid) {
+        if (!EnsureView()) {
             logger::critical("Failed to create PrismaUI view. View handle is invalid.");
             return;
         }
 
-        logger::info("Current view value before toggle: '{}'", g_view);
-
-        const bool hasFocus = g_prismaUI->HasFocus(g_view);
-        if (!hasFocus) {
-            g_prismaUI->InteropCall(g_view, "toggleSkyrimNetUIDiv", "show");
+        // A panel opened from the overlay holds the focus while it is in front
+        if (!HasFocus()) {
+            GetDispatcher().Queue("toggleSkyrimNetUIDiv", "show");
             g_prismaUI->Focus(g_view, true);
+            ResetKeyStates();
 #ifdef PRISMAUI_ENABLE_INSPECTOR
             EnsureInspectorSetup();
 #endif
-            // Start polling when view becomes visible
-            SkyrimNet::GetController().StartPolling();
-            logger::info(
-                "Called InteropCall show to 'skyrimnet-ui' div. GameMaster "
-                "polling started.");
+            // Start polling when view becomes visible, unless the game is loading
+            Lifecycle::GetManager().Resume(Lifecycle::Reason::ViewHidden);
+            LOG_DEBUG(UI, "Queued show for 'skyrimnet-ui' div. GameMaster polling started.");
         } else {
-#ifdef PRISMAUI_ENABLE_INSPECTOR
-            if (g_prismaUI->IsInspectorVisible(g_view)) {
-                g_prismaUI->SetInspectorVisibility(g_view, false);
-                logger::info("Inspector overlay hidden while closing SkyrimNet UI view.");
-            }
-#endif
             // Stop polling when view becomes hidden
-            SkyrimNet::GetController().StopPolling();
-            g_prismaUI->Unfocus(g_view);
-            g_prismaUI->InteropCall(g_view, "toggleSkyrimNetUIDiv", "hide");
-            logger::info(
-                "Called InteropCall hide to 'skyrimnet-ui' div. GameMaster "
-                "polling stopped.");
+            HideOverlay();
+            LOG_DEBUG(UI, "Queued hide for 'skyrimnet-ui' div. GameMaster polling stopped.");
         }
     }
 
     void UpdateGameMasterStatus(bool enabled) {
-        logger::info("UIBridge::UpdateGameMasterStatus called with enabled={}", enabled);
-
-        if (!g_prismaUI || !g_prismaUI->IsValid(g_view)) {
-            logger::warn("UIBridge::UpdateGameMasterStatus: PrismaUI or view is not valid");
-            return;
-        }
-
-        const char *enabledStr = enabled ? "true" : "false";
-        logger::info("UIBridge::UpdateGameMasterStatus: Calling InteropCall with '{}'", enabledStr);
-        g_prismaUI->InteropCall(g_view, "updateGameMasterStatus", enabledStr);
-        logger::info("UIBridge::UpdateGameMasterStatus: InteropCall completed");
+        LOG_DEBUG(UI, "UIBridge::UpdateGameMasterStatus called with enabled={}", enabled);
+        GetDispatcher().Queue("updateGameMasterStatus", enabled ? "true" : "false");
     }
 
+    void UpdateGameMasterPending() { GetDispatcher().Queue("updateGameMasterStatus", "pending"); }
+
     PrismaView GetView() { return g_view; }
 
     bool HasFocus() {
         if (!g_prismaUI || !g_prismaUI->IsValid(g_view)) {
             return false;
         }
-        return g_prismaUI->HasFocus(g_view);
+        return GetViewManager().HasFocus();
     }
 
 #ifdef PRISMAUI_ENABLE_INSPECTOR
@@ -200,7 +534,7 @@ namespace SkyrimNetUI::UI {
         }
 
         if (!g_inspectorInitialized) {
-            logger::info("Requesting inspector view for SkyrimNet UI.");
+            LOG_INFO(UI, "Requesting inspector view for SkyrimNet UI.");
             g_prismaUI->CreateInspectorView(g_view);
 
             constexpr float inspectorPosX = 48.0f;
@@ -212,7 +546,7 @@ namespace SkyrimNetUI::UI {
             g_prismaUI->SetInspectorVisibility(g_view, false);
 
             g_inspectorInitialized = true;
-            logger::info("Inspector view initialized with default placement.");
+            LOG_INFO(UI, "Inspector view initialized with default placement.");
         }
 
         return true;
@@ -220,14 +554,14 @@ namespace SkyrimNetUI::UI {
 
     void ToggleInspector() {
         if (!g_prismaUI || !g_prismaUI->IsValid(g_view)) {
-            logger::warn("Inspector toggle requested but UI view is not ready");
+            LOG_WARN(UI, "Inspector toggle requested but UI view is not ready");
             return;
         }
 
         // Inspector can be toggled even when main UI doesn't have focus
         if (!g_inspectorInitialized) {
-            logger::warn(
-                "Inspector not yet initialized. Open the interface (F4) first "
+            LOG_WARN(UI,
+                "Inspector not yet initialized. Open the interface first "
                 "to initialize it.");
             return;
         }
@@ -236,9 +570,9 @@ namespace SkyrimNetUI::UI {
         g_prismaUI->SetInspectorVisibility(g_view, !currentlyVisible);
 
         if (!currentlyVisible) {
-            logger::info("Inspector overlay opened.");
+            LOG_INFO(UI, "Inspector overlay opened.");
         } else {
-            logger::info("Inspector overlay hidden.");
+            LOG_INFO(UI, "Inspector overlay hidden.");
         }
     }
 #endif  // PRISMAUI_ENABLE_INSPECTOR
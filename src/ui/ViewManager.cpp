@@ -0,0 +1,488 @@
+#include "ui/ViewManager.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "logging/Log.h"
+#include "metrics/Metrics.h"
+#include "pch.h"
+
+namespace SkyrimNetUI::UI {
+
+    namespace {
+        constexpr size_t kNoSlot = ViewManager::kMaxViews;
+
+        // Orders of panels sharing a base order are spread over this range, most recent on top
+        constexpr int kOrderStride = 1024;
+
+        void DomReadyTrampoline(PrismaView view) { GetViewManager().HandleDomReady(view); }
+
+        template <size_t Slot, size_t Index>
+        void ListenerTrampoline(const char* argument) {
+            GetViewManager().HandleListener(Slot, Index, argument);
+        }
+
+        template <size_t Slot, size_t... Index>
+        constexpr auto MakeListenerRow(std::index_sequence<Index...>) {
+            return std::array<PRISMA_UI_API::JSListenerCallback, sizeof...(Index)>{
+                &ListenerTrampoline<Slot, Index>...};
+        }
+
+        template <size_t... Slot>
+        constexpr auto MakeListenerTable(std::index_sequence<Slot...>) {
+            return std::array{MakeListenerRow<Slot>(std::make_index_sequence<ViewManager::kMaxListenersPerView>())...};
+        }
+
+        // One distinct callback per view slot and listener index, as PrismaUI passes no context
+        constexpr auto kListenerTrampolines = MakeListenerTable(std::make_index_sequence<ViewManager::kMaxViews>());
+
+        // U+2028 and U+2029 are valid in JSON but end a line in older JS, so they are escaped too
+        void AppendJsonString(std::string& out, std::string_view value) {
+            constexpr char kHex[] = "0123456789abcdef";
+            out.push_back('"');
+            for (size_t i = 0; i < value.size(); ++i) {
+                const auto c = static_cast<unsigned char>(value[i]);
+                if (c == '"' || c == '\\') {
+                    out.push_back('\\');
+                    out.push_back(static_cast<char>(c));
+                } else if (c < 0x20) {
+                    out.append("\\u00");
+                    out.push_back(kHex[c >> 4]);
+                    out.push_back(kHex[c & 0xF]);
+                } else if (value.substr(i, 2) == "\xE2\x80" && i + 2 < value.size() &&
+                           (value[i + 2] == '\xA8' || value[i + 2] == '\xA9')) {
+                    out.append(value[i + 2] == '\xA8' ? "\\u2028" : "\\u2029");
+                    i += 2;
+                } else {
+                    out.push_back(static_cast<char>(c));
+                }
+            }
+            out.push_back('"');
+        }
+    }
+
+    ViewManager& GetViewManager() {
+        static ViewManager instance;
+        return instance;
+    }
+
+    void ViewManager::Attach(PRISMA_UI_API::IVPrismaUI1* api, InteropDispatcher::FlushScheduler scheduler) {
+        std::lock_guard lock(mutex_);
+        api_ = api;
+        flushScheduler_ = std::move(scheduler);
+    }
+
+    void ViewManager::Define(std::string name, PanelSpec spec) {
+        std::lock_guard lock(mutex_);
+        if (auto* panel = FindPanelLocked(name)) {
+            panel->spec = std::move(spec);
+            return;
+        }
+        Panel panel;
+        panel.spec = std::move(spec);
+        panels_.emplace_back(std::move(name), std::move(panel));
+    }
+
+    void ViewManager::AddListener(std::string_view name, std::string jsFunction, PanelListener listener) {
+        std::lock_guard lock(mutex_);
+        auto* panel = FindPanelLocked(name);
+        if (!panel) {
+            LOG_WARN(UI, "Listener {} added to undefined panel '{}'", jsFunction, name);
+            return;
+        }
+        panel->listeners.emplace_back(std::move(jsFunction), std::move(listener));
+        if (panel->slot != kNoSlot) {
+            RegisterListenersLocked(panel->slot, *panel);
+        }
+    }
+
+    void ViewManager::SetReadyHandler(std::string_view name, PanelReadyHandler handler) {
+        std::lock_guard lock(mutex_);
+        if (auto* panel = FindPanelLocked(name)) {
+            panel->ready = std::move(handler);
+        }
+    }
+
+    void ViewManager::Prewarm(size_t count) {
+        std::lock_guard lock(mutex_);
+        const auto pooled = static_cast<size_t>(std::ranges::count_if(
+            slots_, [](const Slot& slot) { return slot.view != 0 && slot.pooled && slot.panel.empty(); }));
+        for (size_t i = pooled; i < count; ++i) {
+            if (CreateSlotLocked(kPanelHostPath, true) == kNoSlot) {
+                break;
+            }
+        }
+    }
+
+    PrismaView ViewManager::Acquire(std::string_view name) {
+        size_t readySlot = kNoSlot;
+        PrismaView view = 0;
+        {
+            std::lock_guard lock(mutex_);
+            auto* panel = FindPanelLocked(name);
+            if (!panel) {
+                LOG_WARN(UI, "Requested view for undefined panel '{}'", name);
+                return 0;
+            }
+            if (panel->slot != kNoSlot) {
+                return slots_[panel->slot].view;
+            }
+
+            const bool pooled = panel->spec.htmlPath.empty();
+            const size_t slot = pooled ? FindFreeSlotLocked(name) : CreateSlotLocked(panel->spec.htmlPath, false);
+            if (slot == kNoSlot) {
+                stats_.failures++;
+                LOG_WARN(UI, "No view available for panel '{}'", name);
+                return 0;
+            }
+
+            AssignLocked(slot, std::string(name), *panel);
+            view = slots_[slot].view;
+            if (slots_[slot].domReady) {
+                readySlot = slot;
+            }
+        }
+
+        if (readySlot != kNoSlot) {
+            NotifyReady(readySlot);
+        }
+        return view;
+    }
+
+    bool ViewManager::Open(std::string_view name, bool focus) {
+        const PrismaView view = Acquire(name);
+        if (view == 0) {
+            return false;
+        }
+
+        std::lock_guard lock(mutex_);
+        auto* panel = FindPanelLocked(name);
+        if (!api_ || !panel) {
+            return false;
+        }
+        panel->open = true;
+        panel->lastOpened = ++openSequence_;
+        api_->SetOrder(view, panel->spec.order * kOrderStride + static_cast<int>(openSequence_ % kOrderStride));
+        api_->Show(view);
+        if (focus) {
+            api_->Focus(view, true);
+        }
+        return true;
+    }
+
+    void ViewManager::Close(std::string_view name) {
+        std::lock_guard lock(mutex_);
+        auto* panel = FindPanelLocked(name);
+        if (!api_ || !panel || panel->slot == kNoSlot) {
+            return;
+        }
+        panel->open = false;
+        const PrismaView view = slots_[panel->slot].view;
+        if (api_->HasFocus(view)) {
+            api_->Unfocus(view);
+        }
+        api_->Hide(view);
+    }
+
+    void ViewManager::Release(std::string_view name) {
+        Close(name);
+
+        std::lock_guard lock(mutex_);
+        auto* panel = FindPanelLocked(name);
+        if (!panel || panel->slot == kNoSlot || !slots_[panel->slot].pooled) {
+            return;
+        }
+        auto& slot = slots_[panel->slot];
+        // Unload the panel's page so a pooled view doesn't keep it running
+        slot.dispatcher->Queue("mountPanel", "");
+        slot.panel.clear();
+        slot.stats.panel.clear();
+        panel->slot = kNoSlot;
+    }
+
+    void ViewManager::CloseAll() {
+        std::vector<std::string> open;
+        {
+            std::lock_guard lock(mutex_);
+            for (const auto& [name, panel] : panels_) {
+                if (panel.open) {
+                    open.push_back(name);
+                }
+            }
+        }
+        for (const auto& name : open) {
+            Close(name);
+        }
+    }
+
+    bool ViewManager::HasFocus() const {
+        std::lock_guard lock(mutex_);
+        if (!api_) {
+            return false;
+        }
+        return std::ranges::any_of(slots_, [this](const Slot& slot) {
+            return slot.view != 0 && api_->IsValid(slot.view) && api_->HasFocus(slot.view);
+        });
+    }
+
+    PrismaView ViewManager::GetView(std::string_view name) const {
+        std::lock_guard lock(mutex_);
+        const auto* panel = FindPanelLocked(name);
+        return panel && panel->slot != kNoSlot ? slots_[panel->slot].view : 0;
+    }
+
+    std::vector<std::string> ViewManager::GetPooledPanels() const {
+        std::lock_guard lock(mutex_);
+        std::vector<std::string> names;
+        for (const auto& [name, panel] : panels_) {
+            if (panel.spec.htmlPath.empty()) {
+                names.push_back(name);
+            }
+        }
+        return names;
+    }
+
+    InteropDispatcher* ViewManager::GetDispatcher(std::string_view name) {
+        std::lock_guard lock(mutex_);
+        const auto* panel = FindPanelLocked(name);
+        return panel && panel->slot != kNoSlot ? slots_[panel->slot].dispatcher.get() : nullptr;
+    }
+
+    ViewManager::Stats ViewManager::GetStats() const {
+        std::lock_guard lock(mutex_);
+        Stats stats = stats_;
+        for (const auto& slot : slots_) {
+            if (slot.view != 0) {
+                stats.views.push_back(slot.stats);
+            }
+        }
+        return stats;
+    }
+
+    std::string ViewManager::StatsToJson() const {
+        const auto stats = GetStats();
+        std::string json = "{\"created\":" + std::to_string(stats.created) +
+                           ",\"reused\":" + std::to_string(stats.reused) +
+                           ",\"failures\":" + std::to_string(stats.failures) + ",\"views\":[";
+        for (size_t i = 0; i < stats.views.size(); ++i) {
+            const auto& view = stats.views[i];
+            json.append(i == 0 ? "{\"panel\":" : ",{\"panel\":");
+            AppendJsonString(json, view.panel);
+            json.append(",\"createUs\":").append(std::to_string(view.createMicros));
+            json.append(",\"loadUs\":").append(std::to_string(view.loadMicros));
+            json.append(",\"privateBytes\":").append(std::to_string(view.privateBytes));
+            json.append(",\"assignments\":").append(std::to_string(view.assignments)).push_back('}');
+        }
+        json.append("]}");
+        return json;
+    }
+
+    void ViewManager::Shutdown() {
+        std::lock_guard lock(mutex_);
+        // PrismaUI tears its views down itself when the game exits
+        for (auto& slot : slots_) {
+            if (slot.dispatcher) {
+                slot.dispatcher->Attach(nullptr, 0);
+            }
+            slot = Slot{};
+        }
+        panels_.clear();
+        readyBeforeCreated_.clear();
+        api_ = nullptr;
+        flushScheduler_ = {};
+    }
+
+    void ViewManager::HandleDomReady(PrismaView view) {
+        size_t readySlot = kNoSlot;
+        {
+            std::lock_guard lock(mutex_);
+            if (!api_) {
+                return;
+            }
+            auto it = std::ranges::find(slots_, view, &Slot::view);
+            if (it == slots_.end()) {
+                readyBeforeCreated_.push_back(view);
+                return;
+            }
+
+            auto& slot = *it;
+            slot.domReady = true;
+            slot.dispatcher->MarkDomReady();
+            slot.stats.loadMicros = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - slot.created)
+                    .count());
+            slot.stats.privateBytes =
+                static_cast<int64_t>(Metrics::ProcessPrivateBytes()) - static_cast<int64_t>(slot.privateBytesAtCreate);
+            const std::string_view owner = slot.panel.empty() ? std::string_view("pooled") : slot.panel;
+            LOG_INFO(UI, "View [{}] ({}) ready: CreateView {} us, DOM ready after {} ms, private memory {:+} MiB",
+                     view, owner, slot.stats.createMicros, slot.stats.loadMicros / 1000,
+                     slot.stats.privateBytes / (1024 * 1024));
+
+            if (!slot.panel.empty()) {
+                readySlot = static_cast<size_t>(it - slots_.begin());
+            }
+        }
+
+        if (readySlot != kNoSlot) {
+            NotifyReady(readySlot);
+        }
+    }
+
+    void ViewManager::HandleListener(size_t slotIndex, size_t index, const char* argument) {
+        PanelListener listener;
+        {
+            std::lock_guard lock(mutex_);
+            if (slotIndex >= slots_.size()) {
+                return;
+            }
+            const auto& slot = slots_[slotIndex];
+            const auto* panel = FindPanelLocked(slot.panel);
+            if (!panel || index >= slot.registeredListeners.size()) {
+                return;
+            }
+            // A reused view may still have listeners of its previous panel registered
+            const auto& function = slot.registeredListeners[index];
+            auto it = std::ranges::find(panel->listeners, function, &std::pair<std::string, PanelListener>::first);
+            if (it == panel->listeners.end()) {
+                return;
+            }
+            listener = it->second;
+        }
+        listener(argument ? std::string_view(argument) : std::string_view{});
+    }
+
+    size_t ViewManager::CreateSlotLocked(const std::string& htmlPath, bool pooled) {
+        if (!api_) {
+            return kNoSlot;
+        }
+        auto it = std::ranges::find(slots_, PrismaView{0}, &Slot::view);
+        if (it == slots_.end()) {
+            return kNoSlot;
+        }
+
+        auto& slot = *it;
+        slot.created = std::chrono::steady_clock::now();
+        slot.privateBytesAtCreate = Metrics::ProcessPrivateBytes();
+        const PrismaView view = api_->CreateView(htmlPath.c_str(), DomReadyTrampoline);
+        if (view == 0 || !api_->IsValid(view)) {
+            LOG_ERROR(UI, "Failed to create view for '{}'", htmlPath);
+            return kNoSlot;
+        }
+
+        slot.view = view;
+        slot.pooled = pooled;
+        slot.stats = ViewStats{};
+        slot.stats.view = view;
+        slot.stats.createMicros = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - slot.created)
+                .count());
+        slot.dispatcher = std::make_unique<InteropDispatcher>(flushScheduler_);
+        slot.dispatcher->Attach(api_, view);
+        if (auto ready = std::ranges::find(readyBeforeCreated_, view); ready != readyBeforeCreated_.end()) {
+            readyBeforeCreated_.erase(ready);
+            slot.domReady = true;
+            slot.dispatcher->MarkDomReady();
+        }
+        if (pooled) {
+            api_->Hide(view);
+        }
+
+        stats_.created++;
+        LOG_DEBUG(UI, "Created {} view [{}] for '{}' in {} us", pooled ? "pooled" : "dedicated", view, htmlPath,
+                  slot.stats.createMicros);
+        return static_cast<size_t>(it - slots_.begin());
+    }
+
+    size_t ViewManager::FindFreeSlotLocked(std::string_view except) {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            if (slots_[i].view != 0 && slots_[i].pooled && slots_[i].panel.empty()) {
+                stats_.reused++;
+                return i;
+            }
+        }
+
+        // Take the view of the least recently opened closed panel before creating another
+        Panel* victim = nullptr;
+        for (auto& [name, panel] : panels_) {
+            if (name == except || panel.open || panel.slot == kNoSlot || !slots_[panel.slot].pooled) {
+                continue;
+            }
+            if (!victim || panel.lastOpened < victim->lastOpened) {
+                victim = &panel;
+            }
+        }
+        if (!victim) {
+            return CreateSlotLocked(kPanelHostPath, true);
+        }
+
+        const size_t slot = victim->slot;
+        LOG_DEBUG(UI, "Reassigning view [{}] from panel '{}'", slots_[slot].view, slots_[slot].panel);
+        victim->slot = kNoSlot;
+        slots_[slot].panel.clear();
+        stats_.reused++;
+        return slot;
+    }
+
+    void ViewManager::AssignLocked(size_t slotIndex, const std::string& name, Panel& panel) {
+        auto& slot = slots_[slotIndex];
+        slot.panel = name;
+        slot.stats.panel = name;
+        slot.stats.assignments++;
+        panel.slot = slotIndex;
+        RegisterListenersLocked(slotIndex, panel);
+        if (slot.pooled) {
+            // Queued calls wait for the host page only if it is still loading; see NotifyReady
+            slot.dispatcher->Queue("mountPanel", name + "|" + panel.spec.url);
+        }
+    }
+
+    void ViewManager::RegisterListenersLocked(size_t slotIndex, const Panel& panel) {
+        auto& slot = slots_[slotIndex];
+        for (const auto& [function, listener] : panel.listeners) {
+            if (std::ranges::find(slot.registeredListeners, function) != slot.registeredListeners.end()) {
+                continue;
+            }
+            if (slot.registeredListeners.size() >= kMaxListenersPerView) {
+                LOG_WARN(UI, "View [{}] has no room for listener {}", slot.view, function);
+                continue;
+            }
+            api_->RegisterJSListener(slot.view, function.c_str(),
+                                     kListenerTrampolines[slotIndex][slot.registeredListeners.size()]);
+            slot.registeredListeners.push_back(function);
+        }
+    }
+
+    void ViewManager::NotifyReady(size_t slotIndex) {
+        PanelReadyHandler handler;
+        PrismaView view = 0;
+        {
+            std::lock_guard lock(mutex_);
+            auto& slot = slots_[slotIndex];
+            const auto* panel = FindPanelLocked(slot.panel);
+            if (!panel) {
+                return;
+            }
+            if (slot.pooled) {
+                // Calls queued while the host page loaded may have been lost with the old DOM
+                slot.dispatcher->Reset();
+                slot.dispatcher->Queue("mountPanel", slot.panel + "|" + panel->spec.url);
+            }
+            handler = panel->ready;
+            view = slot.view;
+        }
+        if (handler) {
+            handler(view);
+        }
+    }
+
+    ViewManager::Panel* ViewManager::FindPanelLocked(std::string_view name) {
+        auto it = std::ranges::find(panels_, name, &std::pair<std::string, Panel>::first);
+        return it != panels_.end() ? &it->second : nullptr;
+    }
+
+    const ViewManager::Panel* ViewManager::FindPanelLocked(std::string_view name) const {
+        auto it = std::ranges::find(panels_, name, &std::pair<std::string, Panel>::first);
+        return it != panels_.end() ? &it->second : nullptr;
+    }
+
+}  // namespace SkyrimNetUI::UI
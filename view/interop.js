@@ -0,0 +1,261 @@
+// ============================================
+// Framed MessagePack channel to the plugin
+// Frame layout and versioning: include/ui/InteropChannel.h
+// ============================================
+const Interop = (() => {
+  const FRAME_SIZE = 32 * 1024;
+  const handlers = new Map();  // name -> { version, handler }
+  const partials = new Map();  // name|id -> { version, next, count, chunks }
+  let nextId = 0;
+
+  // ---- MessagePack ----
+
+  function decodeUtf8(bytes, start, end) {
+    let text = '';
+    for (let i = start; i < end;) {
+      const b = bytes[i++];
+      let cp;
+      if (b < 0x80) {
+        cp = b;
+      } else if (b < 0xE0) {
+        cp = ((b & 0x1F) << 6) | (bytes[i++] & 0x3F);
+      } else if (b < 0xF0) {
+        cp = ((b & 0x0F) << 12) | ((bytes[i++] & 0x3F) << 6) | (bytes[i++] & 0x3F);
+      } else {
+        cp = ((b & 0x07) << 18) | ((bytes[i++] & 0x3F) << 12) | ((bytes[i++] & 0x3F) << 6) | (bytes[i++] & 0x3F);
+      }
+      text += String.fromCodePoint(cp);
+    }
+    return text;
+  }
+
+  function encodeUtf8(text) {
+    const bytes = [];
+    for (const ch of text) {
+      const cp = ch.codePointAt(0);
+      if (cp < 0x80) {
+        bytes.push(cp);
+      } else if (cp < 0x800) {
+        bytes.push(0xC0 | (cp >> 6), 0x80 | (cp & 0x3F));
+      } else if (cp < 0x10000) {
+        bytes.push(0xE0 | (cp >> 12), 0x80 | ((cp >> 6) & 0x3F), 0x80 | (cp & 0x3F));
+      } else {
+        bytes.push(0xF0 | (cp >> 18), 0x80 | ((cp >> 12) & 0x3F), 0x80 | ((cp >> 6) & 0x3F), 0x80 | (cp & 0x3F));
+      }
+    }
+    return bytes;
+  }
+
+  function decode(bytes) {
+    const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+    let pos = 0;
+
+    const uint = (size) => {
+      const value = size === 1 ? view.getUint8(pos) : size === 2 ? view.getUint16(pos) :
+        size === 4 ? view.getUint32(pos) : Number(view.getBigUint64(pos));
+      pos += size;
+      return value;
+    };
+    const int = (size) => {
+      const value = size === 1 ? view.getInt8(pos) : size === 2 ? view.getInt16(pos) :
+        size === 4 ? view.getInt32(pos) : Number(view.getBigInt64(pos));
+      pos += size;
+      return value;
+    };
+    const str = (length) => {
+      const text = decodeUtf8(bytes, pos, pos + length);
+      pos += length;
+      return text;
+    };
+    const bin = (length) => {
+      const data = bytes.slice(pos, pos + length);
+      pos += length;
+      return data;
+    };
+    const array = (size) => {
+      const items = new Array(size);
+      for (let i = 0; i < size; i++) items[i] = value();
+      return items;
+    };
+    const map = (size) => {
+      const object = {};
+      for (let i = 0; i < size; i++) {
+        const key = value();
+        object[key] = value();
+      }
+      return object;
+    };
+
+    function value() {
+      const m = uint(1);
+      if (m <= 0x7F) return m;
+      if (m <= 0x8F) return map(m & 0x0F);
+      if (m <= 0x9F) return array(m & 0x0F);
+      if (m <= 0xBF) return str(m & 0x1F);
+      if (m >= 0xE0) return m - 0x100;
+      switch (m) {
+        case 0xC0: return null;
+        case 0xC2: return false;
+        case 0xC3: return true;
+        case 0xC4: return bin(uint(1));
+        case 0xC5: return bin(uint(2));
+        case 0xC6: return bin(uint(4));
+        case 0xCA: { const v = view.getFloat32(pos); pos += 4; return v; }
+        case 0xCB: { const v = view.getFloat64(pos); pos += 8; return v; }
+        case 0xCC: return uint(1);
+        case 0xCD: return uint(2);
+        case 0xCE: return uint(4);
+        case 0xCF: return uint(8);
+        case 0xD0: return int(1);
+        case 0xD1: return int(2);
+        case 0xD2: return int(4);
+        case 0xD3: return int(8);
+        case 0xD9: return str(uint(1));
+        case 0xDA: return str(uint(2));
+        case 0xDB: return str(uint(4));
+        case 0xDC: return array(uint(2));
+        case 0xDD: return array(uint(4));
+        case 0xDE: return map(uint(2));
+        case 0xDF: return map(uint(4));
+        default: throw new Error('Unsupported MessagePack type 0x' + m.toString(16));
+      }
+    }
+
+    return value();
+  }
+
+  function encode(input) {
+    const out = [];
+    const header = (marker, value, size) => {
+      out.push(marker);
+      for (let i = size - 1; i >= 0; i--) out.push(Math.floor(value / 2 ** (8 * i)) & 0xFF);
+    };
+    const length = (small, smallLimit, marker8, value) => {
+      if (value < smallLimit) out.push(small | value);
+      else if (marker8 !== null && value <= 0xFF) header(marker8, value, 1);
+      else if (value <= 0xFFFF) header((marker8 ?? small) + (marker8 === null ? 0 : 1), value, 2);
+      else header((marker8 ?? small) + (marker8 === null ? 1 : 2), value, 4);
+    };
+
+    function value(v) {
+      if (v === null || v === undefined) {
+        out.push(0xC0);
+      } else if (typeof v === 'boolean') {
+        out.push(v ? 0xC3 : 0xC2);
+      } else if (typeof v === 'number' && Number.isInteger(v) && v >= 0 && v <= 0xFFFFFFFF) {
+        if (v <= 0x7F) out.push(v);
+        else if (v <= 0xFF) header(0xCC, v, 1);
+        else if (v <= 0xFFFF) header(0xCD, v, 2);
+        else header(0xCE, v, 4);
+      } else if (typeof v === 'number' && Number.isInteger(v) && v < 0 && v >= -0x80000000) {
+        if (v >= -32) out.push(v & 0xFF);
+        else header(0xD2, v >>> 0, 4);
+      } else if (typeof v === 'number') {
+        const bytes = new Uint8Array(8);
+        new DataView(bytes.buffer).setFloat64(0, v);
+        out.push(0xCB, ...bytes);
+      } else if (typeof v === 'string') {
+        const bytes = encodeUtf8(v);
+        length(0xA0, 32, 0xD9, bytes.length);
+        for (const b of bytes) out.push(b);
+      } else if (v instanceof Uint8Array) {
+        header(v.length <= 0xFF ? 0xC4 : v.length <= 0xFFFF ? 0xC5 : 0xC6, v.length,
+          v.length <= 0xFF ? 1 : v.length <= 0xFFFF ? 2 : 4);
+        for (const b of v) out.push(b);
+      } else if (Array.isArray(v)) {
+        v.length < 16 ? out.push(0x90 | v.length) : header(v.length <= 0xFFFF ? 0xDC : 0xDD, v.length,
+          v.length <= 0xFFFF ? 2 : 4);
+        v.forEach(value);
+      } else {
+        const entries = Object.entries(v);
+        entries.length < 16 ? out.push(0x80 | entries.length) :
+          header(entries.length <= 0xFFFF ? 0xDE : 0xDF, entries.length, entries.length <= 0xFFFF ? 2 : 4);
+        entries.forEach(([key, item]) => { value(key); value(item); });
+      }
+    }
+
+    value(input);
+    return out;
+  }
+
+  // ---- base64 ----
+
+  function fromBase64(text) {
+    const binary = atob(text);
+    const bytes = new Uint8Array(binary.length);
+    for (let i = 0; i < binary.length; i++) bytes[i] = binary.charCodeAt(i);
+    return bytes;
+  }
+
+  function toBase64(bytes) {
+    let binary = '';
+    for (let i = 0; i < bytes.length; i += 0x8000) {
+      binary += String.fromCharCode.apply(null, bytes.slice(i, i + 0x8000));
+    }
+    return btoa(binary);
+  }
+
+  // ---- frames ----
+
+  function receive(frame) {
+    const fields = frame.split('|', 5);
+    const [name, version, id, index, count] = [fields[0], +fields[1], fields[2], +fields[3], +fields[4]];
+    const chunk = frame.slice(fields.join('|').length + 1);
+    const key = name + '|' + id;
+
+    let partial = partials.get(key);
+    if (index === 0) {
+      partial = { version, next: 0, count, chunks: [] };
+      partials.set(key, partial);
+    } else if (!partial || partial.next !== index || partial.count !== count) {
+      partials.delete(key);
+      console.warn('[Interop] Out of order frame', index, '/', count, 'for', name);
+      return;
+    }
+
+    partial.chunks.push(chunk);
+    if (++partial.next < partial.count) return;
+    partials.delete(key);
+
+    const registration = handlers.get(name);
+    if (!registration || version > registration.version) {
+      console.warn('[Interop] No handler for', name, 'v' + version);
+      return;
+    }
+    try {
+      registration.handler(decode(fromBase64(partial.chunks.join(''))), version);
+    } catch (e) {
+      console.error('[Interop] Handling', name, 'failed:', e);
+    }
+  }
+
+  return {
+    // Handle messages of name up to version: handler(value, version)
+    on(name, version, handler) {
+      handlers.set(name, { version, handler });
+    },
+
+    // Send value to the plugin's handler for name
+    send(name, version, value) {
+      if (!window.interopFrame) return false;
+      const base64 = toBase64(encode(value));
+      const chunkSize = FRAME_SIZE - name.length - 40 & ~3;
+      const count = Math.max(1, Math.ceil(base64.length / chunkSize));
+      const id = nextId++;
+      for (let index = 0; index < count; index++) {
+        const chunk = base64.slice(index * chunkSize, (index + 1) * chunkSize);
+        window.interopFrame(`${name}|${version}|${id}|${index}|${count}|${chunk}`);
+      }
+      return true;
+    },
+
+    receive,
+    decode,
+    encode,
+  };
+})();
+
+// Called from C++ with the frames of one or more messages
+function interopReceive(frames) {
+  frames.forEach(Interop.receive);
+}
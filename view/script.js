@@ -14,14 +14,22 @@ try {
   console.warn('[Inspector] Could not clear tab preference:', e);
 }
 
-let localhostReady = false;
-const LOCALHOST_URL = 'http://localhost:8080/config';
-const HEALTH_CHECK_INTERVAL = 2000; // 2 seconds
+let serverReachable = false;
+// Replaced by the plugin with the [Server] BaseUrl setting once the DOM is ready
+let serverUrl = 'http://localhost:8080';
 
 // Ultralight WebCore bug workaround: prevent rapid navigation
 let lastNavigationTime = 0;
 const MIN_NAVIGATION_DELAY = 500; // 500ms between navigations
 
+const METRICS_REFRESH_INTERVAL = 1000;
+let metricsTimer = null;
+
+// Live events kept in the Events panel
+const MAX_EVENT_ROWS = 200;
+let lastEventSequence = 0;
+let missedEvents = 0;
+
 function toggleSkyrimNetUIDiv(action) {
   const topMenu = document.getElementById("top-menu");
   const wrapper = document.getElementById("skyrimnet-ui");
@@ -40,6 +48,8 @@ function toggleSkyrimNetUIDiv(action) {
     wrapper.classList.add("hidden");
     // Clear button states when hiding
     clearAllButtonStates();
+    hideMetricsPanel();
+    setEventsPanelVisible(false);
     // Tell iframe to pause its polling (3rd party SkyrimNet server optimization)
     sendIframeMessage("PAUSE");
   } else {
@@ -51,6 +61,8 @@ function toggleSkyrimNetUIDiv(action) {
       wrapper.classList.add("hidden");
       // Clear button states when toggling off
       clearAllButtonStates();
+      hideMetricsPanel();
+      setEventsPanelVisible(false);
       // Tell iframe to pause its polling
       sendIframeMessage("PAUSE");
     } else {
@@ -110,6 +122,8 @@ function switchToConfiguration() {
   clearAllButtonStates();
   configBtn.classList.add('active');
 
+  loadMainIframe();
+
   // Resume iframe polling when showing configuration
   sendIframeMessage('RESUME');
 }
@@ -146,6 +160,8 @@ function switchToHelp() {
   clearAllButtonStates();
   helpBtn.classList.add('active');
 
+  loadHelpIframe();
+
   // Pause main view iframe when switching to help
   // (Help view has its own iframe with external docs)
   sendIframeMessage('PAUSE');
@@ -156,6 +172,13 @@ function updateGameMasterStatus(enabled) {
 
   const statusElement = document.getElementById('gamemaster-status');
 
+  // Toggle is running on a native worker; the final state follows once the server answers
+  if (enabled === "pending") {
+    statusElement.innerHTML = '<span class="status-pending">⏳ Updating...</span>';
+    console.log('[GameMaster] UI updated to: Pending');
+    return;
+  }
+
   // Convert string to boolean (InteropCall sends "true" or "false" as strings)
   const isEnabled = (enabled === true || enabled === "true");
 
@@ -170,6 +193,146 @@ function updateGameMasterStatus(enabled) {
   }
 }
 
+function requestMetrics() {
+  if (window.requestMetrics) {
+    window.requestMetrics();
+  }
+}
+
+function toggleMetricsPanel() {
+  const panel = document.getElementById('metrics-panel');
+  if (panel.classList.contains('visible')) {
+    hideMetricsPanel();
+    return;
+  }
+
+  panel.classList.remove('hidden');
+  panel.classList.add('visible');
+  document.getElementById('metrics-btn').classList.add('active');
+
+  // Native side only answers on request, so poll while the panel is open
+  requestMetrics();
+  metricsTimer = setInterval(requestMetrics, METRICS_REFRESH_INTERVAL);
+}
+
+function hideMetricsPanel() {
+  const panel = document.getElementById('metrics-panel');
+  if (!panel) return;
+
+  panel.classList.remove('visible');
+  panel.classList.add('hidden');
+  document.getElementById('metrics-btn').classList.remove('active');
+  if (metricsTimer !== null) {
+    clearInterval(metricsTimer);
+    metricsTimer = null;
+  }
+}
+
+// Metrics snapshot from SendMetrics in UIBridge.cpp; histograms are
+// [count, mean, p50, p90, p99, max] in microseconds
+Interop.on('metrics', 1, (snapshot) => {
+  const formatMicros = (us) => (us >= 1000 ? (us / 1000).toFixed(1) + ' ms' : us.toFixed(1) + ' µs');
+
+  const rows = Object.entries(snapshot.histograms).map(([name, [count, ...micros]]) =>
+    `<tr><td>${name}</td><td>${count}</td>` + micros.map((us) => `<td>${formatMicros(us)}</td>`).join('') + '</tr>');
+  document.getElementById('metrics-histograms').innerHTML = rows.join('');
+
+  document.getElementById('metrics-counters').textContent = Object.entries(snapshot.counters)
+    .map(([name, value]) => `${name}: ${value}`)
+    .join('  ·  ');
+});
+
+function setEventsPanelVisible(show) {
+  const panel = document.getElementById('events-panel');
+  if (!panel) return;
+
+  panel.classList.toggle('visible', show);
+  panel.classList.toggle('hidden', !show);
+  document.getElementById('events-btn').classList.toggle('active', show);
+}
+
+function toggleEventsPanel() {
+  setEventsPanelVisible(!document.getElementById('events-panel').classList.contains('visible'));
+}
+
+// Short text for an event's data: the usual message fields of a JSON object, else the raw data
+function describeEvent(data) {
+  try {
+    const value = JSON.parse(data);
+    if (value && typeof value === 'object') {
+      const text = value.text ?? value.message ?? value.action ?? value.error;
+      if (text !== undefined) {
+        return (value.speaker ? value.speaker + ': ' : '') + text;
+      }
+    }
+  } catch (e) {
+    // Not JSON; show it as sent
+  }
+  return data;
+}
+
+// New events from DeliverEvents in UIBridge.cpp, oldest first: [sequence, type, data]
+Interop.on('events', 1, (batch) => {
+  const list = document.getElementById('events-list');
+  for (const [sequence, type, data] of batch.events) {
+    // Sequences have no gaps, so a jump means the plugin's buffer dropped events while it was full
+    if (lastEventSequence !== 0 && sequence > lastEventSequence + 1) {
+      missedEvents += sequence - lastEventSequence - 1;
+    }
+    lastEventSequence = sequence;
+
+    const row = document.createElement('div');
+    row.className = 'event-row event-' + type;
+    const label = document.createElement('span');
+    label.className = 'event-type';
+    label.textContent = type;
+    row.append(label, ' ', describeEvent(data).slice(0, 300));
+    list.appendChild(row);
+  }
+  while (list.childElementCount > MAX_EVENT_ROWS) {
+    list.firstElementChild.remove();
+  }
+  list.scrollTop = list.scrollHeight;
+
+  document.getElementById('events-missed').textContent =
+    missedEvents > 0 ? `${missedEvents} events were dropped while the overlay was closed` : '';
+});
+
+// Called from C++ with ViewManager::StatsToJson (times in microseconds)
+function updateViewStats(json) {
+  let stats;
+  try {
+    stats = JSON.parse(json);
+  } catch (e) {
+    console.warn('[Metrics] Invalid view stats:', e);
+    return;
+  }
+
+  const views = stats.views.map((v) =>
+    `${v.panel || '(pooled)'} ${(v.createUs / 1000).toFixed(1)}/${(v.loadUs / 1000).toFixed(0)} ms ` +
+    `${(v.privateBytes / (1024 * 1024)).toFixed(0)} MiB`);
+  document.getElementById('metrics-views').textContent =
+    `Views: ${stats.created} created, ${stats.reused} reused` + (views.length ? '  ·  ' + views.join('  ·  ') : '');
+}
+
+// Called from C++ once the DOM is ready with the comma-separated names of the [Panels] pages
+function setPanels(names) {
+  const menu = document.getElementById('top-menu');
+  menu.querySelectorAll('.panel-button').forEach((button) => button.remove());
+
+  names.split(',').filter((name) => name).forEach((name) => {
+    const button = document.createElement('button');
+    button.className = 'menu-button panel-button';
+    button.textContent = name;
+    button.onclick = () => {
+      if (window.openPanel) {
+        window.openPanel(name);
+      }
+    };
+    menu.insertBefore(button, document.getElementById('metrics-btn'));
+  });
+}
+
 function onGameMasterClick() {
   console.log('GameMaster button clicked');
 
@@ -196,6 +359,7 @@ function toggleHelpPanel() {
     // Update button states for help view
     clearAllButtonStates();
     helpBtn.classList.add('active');
+    loadHelpIframe();
   } else {
     helpView.classList.remove('visible');
     helpView.classList.add('hidden');
@@ -204,6 +368,7 @@ function toggleHelpPanel() {
     // Update button states for config view
     clearAllButtonStates();
     configBtn.classList.add('active');
+    loadMainIframe();
   }
 }
 
@@ -298,37 +463,47 @@ function reloadIframe() {
   }
 }
 
-async function checkLocalhostHealth() {
-  try {
-    const response = await fetch(LOCALHOST_URL, {
-      method: 'HEAD',
-      mode: 'no-cors', // Allows check even without CORS headers
-      cache: 'no-cache'
-    });
-    // no-cors returns opaque response, so we assume success if no error thrown
-    return true;
-  } catch (e) {
-    return false;
+function setServerUrl(url) {
+  if (url) {
+    serverUrl = url.replace(/\/+$/, '');
   }
 }
 
-async function pollLocalhost() {
-  if (localhostReady) return;
-
-  const isHealthy = await checkLocalhostHealth();
-  if (isHealthy) {
-    localhostReady = true;
-    console.log('Localhost server is ready');
+function configUrl() {
+  return `${serverUrl}/config`;
+}
 
-    // Update iframe src now that server is available
-    const mainIframe = document.getElementById('skyrimnet-ui-iframe');
-    if (mainIframe && mainIframe.src === 'about:blank') {
-      mainIframe.src = LOCALHOST_URL;
-    }
-  } else {
-    console.log('Waiting for localhost server...');
-    setTimeout(pollLocalhost, HEALTH_CHECK_INTERVAL);
+// Called from C++ by the native health monitor, only when the server comes up or goes down
+function setServerReachable(reachable) {
+  serverReachable = (reachable === true || reachable === "true");
+  if (!serverReachable) {
+    console.log('Waiting for SkyrimNet server...');
+    return;
   }
+
+  console.log('SkyrimNet server is ready');
+  loadMainIframe();
+}
+
+// Iframes stay on about:blank until their tab is first shown, so an unopened
+// overlay doesn't load (or keep polling) the SkyrimNet UI or the help site
+
+function isTabShown(viewId) {
+  const wrapper = document.getElementById('skyrimnet-ui');
+  const view = document.getElementById(viewId);
+  return wrapper.classList.contains('visible') && view.classList.contains('visible');
+}
+
+function loadMainIframe() {
+  const mainIframe = document.getElementById('skyrimnet-ui-iframe');
+  if (!serverReachable || !mainIframe || mainIframe.src !== 'about:blank' || !isTabShown('main-view')) return;
+  mainIframe.src = configUrl();
+}
+
+function loadHelpIframe() {
+  const helpIframe = document.querySelector('#help-view iframe');
+  if (!helpIframe || helpIframe.src !== 'about:blank' || !isTabShown('help-view')) return;
+  helpIframe.src = helpIframe.dataset.src;
 }
 
 function setupIframeErrorHandlers() {
@@ -338,7 +513,7 @@ function setupIframeErrorHandlers() {
   if (mainIframe) {
     mainIframe.addEventListener('error', function() {
       console.error('Main iframe failed to load');
-      showIframeError(mainIframe, `Unable to connect to ${LOCALHOST_URL}. Server may not be running yet.`);
+      showIframeError(mainIframe, `Unable to connect to ${configUrl()}. Server may not be running yet.`);
     });
 
     mainIframe.addEventListener('load', function() {
@@ -357,10 +532,10 @@ function setupIframeErrorHandlers() {
           // Redirect to /config instead
           try {
             const currentUrl = doc?.location?.href;
-            if (currentUrl === 'http://localhost:8080/' || currentUrl === 'http://localhost:8080') {
+            if (currentUrl === `${serverUrl}/` || currentUrl === serverUrl) {
               console.warn('[Navigation] Detected root URL navigation - redirecting to /config to prevent crash');
               setTimeout(() => {
-                mainIframe.src = 'http://localhost:8080/config';
+                mainIframe.src = configUrl();
               }, 100);
               return;
             }
@@ -370,7 +545,7 @@ function setupIframeErrorHandlers() {
 
           // Monitor iframe for navigation attempts that might break out
           try {
-            if (doc && doc.location.href.startsWith('http://localhost')) {
+            if (doc && doc.location.href.startsWith(serverUrl)) {
               // Set base target to keep all navigation in iframe
               let base = doc.querySelector('base');
               if (!base) {
@@ -450,8 +625,7 @@ window.addEventListener('DOMContentLoaded', function() {
   // Set up iframe error handlers
   setupIframeErrorHandlers();
 
-  // Start polling for localhost availability
-  pollLocalhost();
+  // The iframe is loaded once the plugin reports the server as reachable (setServerReachable)
 
   // Dragging functionality
   let isDragging = false;